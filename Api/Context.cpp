@@ -0,0 +1,101 @@
+
+/*
+ * File Context.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file Context.cpp
+ * Implements class Context.
+ */
+
+#include <mutex>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "FormulaBuilder.hpp"
+#include "Helper_Internal.hpp"
+
+#include "Context.hpp"
+
+namespace Api
+{
+
+using namespace Lib;
+
+/**
+ * Guards the environment while a context is entered. It is recursive
+ * so that a thread can enter several contexts in nested scopes.
+ *
+ * The functions below do not use CALL, as the tracing stack is shared
+ * by all threads and they run partly outside of the lock.
+ */
+static std::recursive_mutex s_envMutex;
+
+Context* Context::s_current = 0;
+
+Context::Context()
+: _entered(false)
+{
+  //the allocator is shared by all contexts
+  std::lock_guard<std::recursive_mutex> lock(s_envMutex);
+  _state = new Environment::State;
+  //the same defaults the library sets for the process environment
+  //(see ResourceLimits.cpp)
+  _state->options->setTimeLimitInDeciseconds(0);
+  _state->options->setOutputAxiomNames(true);
+  _helperCore = new DefaultHelperCore;
+  _usedFormulaNames = new DHSet<vstring>;
+}
+
+Context::~Context()
+{
+  ASS(!_entered);
+
+  std::lock_guard<std::recursive_mutex> lock(s_envMutex);
+  delete _usedFormulaNames;
+  delete _helperCore;
+  delete _state;
+}
+
+Context::Scope::Scope(Context& ctx)
+: _ctx(ctx)
+{
+  s_envMutex.lock();
+  if(_ctx._entered) {
+    s_envMutex.unlock();
+    throw ApiException("The context has already been entered");
+  }
+  env.swapState(*_ctx._state);
+  _ctx._entered = true;
+  _previous = s_current;
+  s_current = &_ctx;
+}
+
+Context::Scope::~Scope()
+{
+  ASS(_ctx._entered);
+  ASS_EQ(s_current, &_ctx);
+
+  s_current = _previous;
+  env.swapState(*_ctx._state);
+  _ctx._entered = false;
+  s_envMutex.unlock();
+}
+
+}
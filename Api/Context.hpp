@@ -0,0 +1,108 @@
+
+/*
+ * File Context.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file Context.hpp
+ * Defines class Context.
+ */
+
+#ifndef __API_Context__
+#define __API_Context__
+
+#include "Lib/DHSet.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/VString.hpp"
+
+namespace Api {
+
+class DefaultHelperCore;
+
+/**
+ * A separate instance of Vampire inside the process, with its own options,
+ * signature, theory, term sharing and statistics, and its own state of the Api
+ * classes (the default helper core and the names given to annotated formulas).
+ *
+ * The Api classes always work with the current environment. To work with
+ * a context, create a Context::Scope object for it; until the scope object
+ * is destroyed, the context is the current environment of the process.
+ * A FormulaBuilder or a Problem belongs to the context that was current
+ * when it was created, and using it (or the terms and formulas it created)
+ * while another context is current raises an ApiException.
+ *
+ * Contexts isolate problems from each other, they do not run them in
+ * parallel. They can be used from several threads, but entering a context
+ * locks a process-wide mutex, so calls into different contexts are
+ * serialized: the memory allocator, the tracing stack and many caches
+ * of Vampire are shared by the whole process and are not thread-safe.
+ * When contexts are used from several threads, all use of the Api,
+ * including the destruction of Api objects, must happen inside a scope.
+ * Proofs that should run in parallel need separate processes.
+ */
+class Context
+{
+public:
+  Context();
+  ~Context();
+
+  /**
+   * Makes a context the current environment for the lifetime
+   * of the object. Scopes of different contexts may be nested
+   * on one thread, a context may not be entered twice.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(Context& ctx);
+    ~Scope();
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    Context& _ctx;
+    /** context that was current before the scope was entered */
+    Context* _previous;
+  };
+
+  /** The entered context, or zero if the process environment is used */
+  static Context* current() { return s_current; }
+
+  /**
+   * Helper core used for Api objects not created by a FormulaBuilder
+   * while the context is entered
+   */
+  DefaultHelperCore* helperCore() { return _helperCore; }
+  /** Names already given to annotated formulas in the context */
+  Lib::DHSet<Lib::vstring>& usedFormulaNames() { return *_usedFormulaNames; }
+
+private:
+  Context(const Context&);
+  Context& operator=(const Context&);
+
+  /** Problem state of the context while it is not entered, and the
+   * state it replaced in the environment while it is */
+  Lib::Environment::State* _state;
+  DefaultHelperCore* _helperCore;
+  Lib::DHSet<Lib::vstring>* _usedFormulaNames;
+  bool _entered;
+
+  static Context* s_current;
+};
+
+}
+
+#endif // __API_Context__
@@ -23,6 +23,7 @@
 
 #include "FormulaBuilder.hpp"
 
+#include "Context.hpp"
 #include "Helper_Internal.hpp"
 
 #include "Debug/Assertion.hpp"
@@ -75,6 +76,8 @@ Sort FormulaBuilder::sort(const vstring& sortName)
 {
   CALL("FormulaBuilder::sort");
 
+  _aux->checkContext();
+
   unsigned res = env.sorts->addSort(sortName);
   return Sort(res);
 }
@@ -112,6 +115,8 @@ vstring FormulaBuilder::getSortName(Sort s)
 {
   CALL("FormulaBuilder::getSortName");
 
+  _aux->checkContext();
+
   return env.sorts->sortName(s);
 }
 
@@ -119,6 +124,8 @@ vstring FormulaBuilder::getPredicateName(Predicate p)
 {
   CALL("FormulaBuilder::getPredicateName");
 
+  _aux->checkContext();
+
   return _aux->getSymbolName(true, p);
 }
 
@@ -126,6 +133,8 @@ vstring FormulaBuilder::getFunctionName(Function f)
 {
   CALL("FormulaBuilder::getFunctionName");
 
+  _aux->checkContext();
+
   return _aux->getSymbolName(true, f);
 }
 
@@ -155,6 +164,8 @@ Var FormulaBuilder::var(const vstring& varName, Sort varSort)
 {
   CALL("FormulaBuilder::var");
 
+  _aux->checkContext();
+
   return _aux->getVar(varName, varSort);
 }
 
@@ -162,7 +173,7 @@ Function FormulaBuilder::function(const vstring& funName,unsigned arity, bool bu
 {
   CALL("FormulaBuilder::function/2");
 
-  static DArray<Sort> domainSorts;
+  DArray<Sort> domainSorts;
   domainSorts.init(arity, defaultSort());
   return function(funName, arity, defaultSort(), domainSorts.array(), builtIn);
 }
@@ -171,6 +182,8 @@ Function FormulaBuilder::function(const vstring& funName, unsigned arity, Sort r
 {
   CALL("FormulaBuilder::function/4");
 
+  _aux->checkContext();
+
   if(_aux->_checkNames) {
     if(!islower(funName[0]) && (funName.substr(0,2)!="$$")) {
       throw InvalidTPTPNameException("Function name must start with a lowercase character or \"$$\"", funName);
@@ -182,7 +195,7 @@ Function FormulaBuilder::function(const vstring& funName, unsigned arity, Sort r
   unsigned res = env.signature->addFunction(funName, arity, added);
   Kernel::Signature::Symbol* sym = env.signature->getFunction(res);
 
-  static DArray<unsigned> nativeSorts;
+  DArray<unsigned> nativeSorts;
   nativeSorts.initFromArray(arity, domainSorts);
 
   FunctionType* fnType = new FunctionType(arity, nativeSorts.array(), rangeSort);
@@ -207,6 +220,8 @@ Function FormulaBuilder::integerConstant(int i)
 {
   CALL("FormulaBuilder::integerConstant");
 
+  _aux->checkContext();
+
   unsigned fun = env.signature->addIntegerConstant(IntegerConstantType(i));
   return Function(fun);
 }
@@ -215,6 +230,8 @@ Function FormulaBuilder::integerConstant(vstring i)
 {
   CALL("FormulaBuilder::integerConstant");
 
+  _aux->checkContext();
+
   unsigned fun;
   try {
     fun = env.signature->addIntegerConstant(IntegerConstantType(i));
@@ -230,7 +247,7 @@ Predicate FormulaBuilder::predicate(const vstring& predName,unsigned arity, bool
 {
   CALL("FormulaBuilder::predicate/2");
 
-  static DArray<Sort> domainSorts;
+  DArray<Sort> domainSorts;
   domainSorts.init(arity, defaultSort());
   return predicate(predName, arity, domainSorts.array(), builtIn);
 }
@@ -239,6 +256,8 @@ Predicate FormulaBuilder::predicate(const vstring& predName, unsigned arity, Sor
 {
   CALL("FormulaBuilder::predicate/3");
 
+  _aux->checkContext();
+
   if(_aux->_checkNames) {
     if(!islower(predName[0]) && (predName.substr(0,2)!="$$")) {
       throw InvalidTPTPNameException("Predicate name must start with a lowercase character or \"$$\"", predName);
@@ -251,7 +270,7 @@ Predicate FormulaBuilder::predicate(const vstring& predName, unsigned arity, Sor
 
   Kernel::Signature::Symbol* sym = env.signature->getPredicate(res);
 
-  static DArray<unsigned> nativeSorts;
+  DArray<unsigned> nativeSorts;
   nativeSorts.initFromArray(arity, domainSorts);
 
   PredicateType* predType = new PredicateType(arity, nativeSorts.array());
@@ -275,6 +294,8 @@ Predicate FormulaBuilder::interpretedPredicate(InterpretedPredicate symbol)
 {
   CALL("FormulaBuilder::interpretedPredicate");
 
+  _aux->checkContext();
+
   Interpretation itp;
   switch(symbol)
   {
@@ -479,6 +500,8 @@ Formula FormulaBuilder::equality(const Term& lhs,const Term& rhs, bool positive)
 {
   CALL("FormulaBuilder::equality/3");
 
+  _aux->checkContext();
+
   _aux->ensureEqualityArgumentsSortsMatch(lhs, rhs);
   unsigned srt = lhs.sort();
   if(srt!=rhs.sort()) {
@@ -494,6 +517,8 @@ Formula FormulaBuilder::trueFormula()
 {
   CALL("FormulaBuilder::trueFormula");
 
+  _aux->checkContext();
+
   Formula res(new Kernel::Formula(true));
   res._aux=_aux; //assign the correct helper object
   return res;
@@ -503,6 +528,8 @@ Formula FormulaBuilder::falseFormula()
 {
   CALL("FormulaBuilder::falseFormula");
 
+  _aux->checkContext();
+
   Formula res(new Kernel::Formula(false));
   res._aux=_aux; //assign the correct helper object
   return res;
@@ -512,6 +539,8 @@ Formula FormulaBuilder::negation(const Formula& f)
 {
   CALL("FormulaBuilder::negation");
 
+  _aux->checkContext();
+
   if(f._aux!=_aux) {
     throw FormulaBuilderException("negation function called on a Formula object not built by the same FormulaBuilder object");
   }
@@ -525,6 +554,8 @@ Formula FormulaBuilder::formula(Connective c,const Formula& f1,const Formula& f2
 {
   CALL("FormulaBuilder::formula(Connective,const Formula&,const Formula&)");
 
+  _aux->checkContext();
+
   if(f1._aux!=_aux || f2._aux!=_aux) {
     throw FormulaBuilderException("formula function called on a Formula object not built by the same FormulaBuilder object");
   }
@@ -579,6 +610,8 @@ Formula FormulaBuilder::formula(Connective q,const Var& v,const Formula& f)
 {
   CALL("FormulaBuilder::formula(Connective,const Var&,const Formula&)");
 
+  _aux->checkContext();
+
   if(f._aux!=_aux) {
     throw FormulaBuilderException("formula function called on a Formula object not built by the same FormulaBuilder object");
   }
@@ -616,6 +649,8 @@ AnnotatedFormula FormulaBuilder::annotatedFormula(Formula f, Annotation a, vstri
 {
   CALL("FormulaBuilder::annotatedFormula");
 
+  _aux->checkContext();
+
   if(f._aux!=_aux) {
     throw FormulaBuilderException("annotatedFormula function called on a Formula object not built by the same FormulaBuilder object");
   }
@@ -658,6 +693,8 @@ Term FormulaBuilder::substitute(Term original, Var v, Term t)
 {
   CALL("FormulaBuilder::substitute(Term)");
 
+  _aux->checkContext();
+
   Kernel::TermList tgt = static_cast<Kernel::TermList>(t);
   SingleVarApplicator apl(v, tgt);
   Kernel::TermList resTerm = SubstHelper::apply(static_cast<Kernel::TermList>(original), apl);
@@ -668,6 +705,8 @@ Formula FormulaBuilder::substitute(Formula f, Var v, Term t)
 {
   CALL("FormulaBuilder::substitute(Formula)");
 
+  _aux->checkContext();
+
   Kernel::Formula::VarList* fBound = f.form->boundVariables();
   if(fBound->member(v)) {
     throw ApiException("Variable we substitute for cannot be bound in the formula");
@@ -700,6 +739,8 @@ Term FormulaBuilder::replaceConstant(Term original, Term replaced, Term target)
 {
   CALL("FormulaBuilder::replaceConstant(Term)");
 
+  _aux->checkContext();
+
   Kernel::TermList trm = static_cast<Kernel::TermList>(original);
   Kernel::TermList tSrc = static_cast<Kernel::TermList>(replaced);
   Kernel::TermList tTgt = static_cast<Kernel::TermList>(target);
@@ -724,6 +765,8 @@ Formula FormulaBuilder::replaceConstant(Formula f, Term replaced, Term target)
 {
   CALL("FormulaBuilder::replaceConstant(Formula)");
 
+  _aux->checkContext();
+
   Kernel::TermList tSrc = static_cast<Kernel::TermList>(replaced);
   Kernel::TermList tTgt = static_cast<Kernel::TermList>(target);
 
@@ -1199,7 +1242,9 @@ void AnnotatedFormula::assignName(AnnotatedFormula& form, vstring name)
     return;
   }
 
-  static DHSet<vstring> usedNames;
+  static DHSet<vstring> processUsedNames;
+  Context* ctx = Context::current();
+  DHSet<vstring>& usedNames = ctx ? ctx->usedFormulaNames() : processUsedNames;
 
   if(!usedNames.insert(name)) {
     vstring name0 = name;
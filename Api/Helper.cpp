@@ -38,11 +38,16 @@ using namespace Shell;
 //
 
 
+/**
+ * Return the helper core of the current context,
+ * or the one of the process environment outside of contexts
+ */
 DefaultHelperCore* DefaultHelperCore::instance()
 {
   static DefaultHelperCore inst;
 
-  return &inst;
+  Context* ctx = Context::current();
+  return ctx ? ctx->helperCore() : &inst;
 }
 
 vstring DefaultHelperCore::getVarName(Var v) const
@@ -428,11 +433,26 @@ StringIterator DefaultHelperCore::getVarNames(VarList* l)
 //
 
 
+/**
+ * Throw an ApiException unless the context in which the formula builder
+ * was created is the current one
+ */
+void FBHelperCore::checkContext() const
+{
+  CALL("FBHelperCore::checkContext");
+
+  if(_context!=Context::current()) {
+    throw ApiException("FormulaBuilder used outside of the context it was created in");
+  }
+}
+
 /** build a term f(*args) with specified @b arity */
 Term FBHelperCore::term(const Function& f,const Term* args, unsigned arity)
 {
   CALL("FBHelperCore::term");
 
+  checkContext();
+
   if(f>=static_cast<unsigned>(env.signature->functions())) {
     throw FormulaBuilderException("Function does not exist");
   }
@@ -454,6 +474,8 @@ Formula FBHelperCore::atom(const Predicate& p, bool positive, const Term* args,
 {
   CALL("FBHelperCore::atom");
 
+  checkContext();
+
   if(p>=static_cast<unsigned>(env.signature->predicates())) {
     throw FormulaBuilderException("Predicate does not exist");
   }
@@ -26,6 +26,7 @@
 
 #include "Forwards.hpp"
 
+#include "Context.hpp"
 #include "FormulaBuilder.hpp"
 
 #include "Helper.hpp"
@@ -89,7 +90,8 @@ public:
   CLASS_NAME(FBHelperCore);
   USE_ALLOCATOR(FBHelperCore);
   
-  FBHelperCore() : nextVar(0), refCtr(0), varFact(*this), _unaryPredicate(0)
+  FBHelperCore() : nextVar(0), refCtr(0), varFact(*this), _unaryPredicate(0),
+      _context(Context::current())
   {
   }
 
@@ -119,6 +121,8 @@ public:
 
   virtual bool isFBHelper() const { return true; }
 
+  void checkContext() const;
+
 
   Term term(const Function& f,const Term* args, unsigned arity);
   Formula atom(const Predicate& p, bool positive, const Term* args, unsigned arity);
@@ -210,6 +214,9 @@ private:
    *
    * Is used in @c FormulaBuilder::replaceConstant() */
   unsigned _unaryPredicate;
+
+  /** Context current when the object was created, zero for the process environment */
+  Context* _context;
 };
 
 class SingleVarApplicator
@@ -23,6 +23,7 @@
 
 #include "Problem.hpp"
 
+#include "Context.hpp"
 #include "Helper_Internal.hpp"
 
 #include "Debug/Assertion.hpp"
@@ -342,7 +343,7 @@ public:
   CLASS_NAME(Problem::PData);
   USE_ALLOCATOR(Problem::PData);
   
-  PData() : _size(0), _forms(0), _refCnt(0)
+  PData() : _size(0), _forms(0), _refCnt(0), _context(Context::current())
   {
   }
   ~PData()
@@ -368,10 +369,29 @@ public:
     obj->_forms = AFList::copy(_forms);
   }
 
+  /**
+   * Throw an ApiException unless the context in which the problem
+   * was created is the current one
+   */
+  void checkContext()
+  {
+    CALL("Problem::PData::checkContext");
+
+    if(_context!=Context::current()) {
+      throw ApiException("Problem used outside of the context it was created in");
+    }
+  }
+
   void addFormula(AnnotatedFormula f)
   {
     CALL("Problem::PData::addFormula");
 
+    checkContext();
+    DefaultHelperCore* core = *f._aux;
+    if(core->isFBHelper() && static_cast<FBHelperCore*>(core)->_context!=_context) {
+      throw ApiException("Formula added to a problem of another context");
+    }
+
     _size++;
     AFList::push(f, _forms);
   }
@@ -397,6 +417,8 @@ private:
   size_t _size;
   AFList* _forms;
   unsigned _refCnt;
+  /** Context current when the problem was created, zero for the process environment */
+  Context* _context;
 };
 
 
@@ -441,6 +463,8 @@ Problem Problem::clone()
 {
   CALL("Problem::clone");
 
+  _data->checkContext();
+
   Problem res;
   _data->cloneInto(res._data);
   return res;
@@ -476,6 +500,8 @@ void Problem::addFromStream(istream& s, vstring includeDirectory, bool simplifyS
 {
   CALL("Problem::addFromStream");
 
+  _data->checkContext();
+
   using namespace Shell;
 
   vstring originalInclude=env.options->include();
@@ -513,6 +539,8 @@ public:
   {
     CALL("ProblemTransformer::transform(Problem)");
 
+    p._data->checkContext();
+
     VarManager::VarFactory* oldFactory = VarManager::varNamePreservingFactory();
 
     if(p.size()>0) {
@@ -1770,6 +1798,8 @@ void Problem::outputTypeDefinitions(ostream& out, bool outputAllTypeDefs)
 {
   CALL("Problem::outputTypeDefinitions");
 
+  _data->checkContext();
+
   DefaultHelperCore* core0 = _data->getCore();
   bool dummyNames = core0 && core0->outputDummyNames();
   FBHelperCore* core = (core0 && core0->isFBHelper()) ? static_cast<FBHelperCore*>(core0) : 0;
@@ -1810,6 +1840,8 @@ void Problem::outputStatistics(ostream& out)
 {
   CALL("Problem::outputStatictics");
 
+  _data->checkContext();
+
   env.statistics->print(out);
 }
 
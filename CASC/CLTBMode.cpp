@@ -26,6 +26,8 @@
 #include <cstdlib>
 #include <csignal>
 #include <sstream>
+#include <cmath>
+#include <sys/stat.h>
 
 #include "Lib/Portability.hpp"
 
@@ -33,6 +35,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/Int.hpp"
+#include "Lib/Sort.hpp"
 #include "Lib/StringUtils.hpp"
 #include "Lib/System.hpp"
 #include "Lib/TimeCounter.hpp"
@@ -50,6 +53,7 @@
 
 #include "Parse/TPTP.hpp"
 
+#include "ScheduleDatabase.hpp"
 #include "Schedules.hpp"
 
 #include "CLTBMode.hpp"
@@ -124,11 +128,18 @@ void CLTBMode::perform()
  * <ol><li>read the batch file</li>
  * <li>load the common axioms and put them into a SInE selector</li>
  * <li>spawn child processes that try to prove a problem by calling
- *     CLTBProblem::searchForProof(). These processes are run sequentially and the time
+ *     CLTBProblem::searchForProof(). Up to ltb_parallel_problems of these
+ *     processes run at the same time and the time
  *     limit for each one is computed depending on the per-problem time limit,
  *     batch time limit, and time spent on this batch so far. The termination
  *     time for the proof search for a problem will be passed to
  *     CLTBProblem::searchForProof() as an argument.</li></ol>
+ *
+ * When several problems run at once, the easier looking ones (by the size
+ * of the problem file) are started first and the cores and the remaining
+ * time are divided among the problems, the harder looking ones getting
+ * more time. The common axioms are loaded once here and the problem
+ * processes only read them.
  * @author Andrei Voronkov
  * @since 04/06/2013 flight Manchester-Frankfurt
  */
@@ -149,104 +160,228 @@ void CLTBMode::solveBatch(istream& batchFile, bool first,vstring inputDirectory)
     doTraining();
   }
 
-  int solvedProblems = 0;
-  int remainingProblems = _problemFiles.size();
+  unsigned parallelProblems = max(1u, env.options->ltbParallelProblems());
+  unsigned totalCores = usableCores();
+  parallelProblems = min(parallelProblems, totalCores);
+
+  Stack<BatchProblem> problems;
   StringPairStack::BottomFirstIterator probs(_problemFiles);
   while (probs.hasNext()) {
     StringPair res=probs.next();
 
-    vstring probFile= inputDirectory+"/"+res.first;
-    vstring outFile= res.second;
+    BatchProblem bp;
+    bp.probFile = inputDirectory+"/"+res.first;
+    bp.outFile = res.second;
     vstring outDir = env.options->ltbDirectory();
     if(!outDir.empty()){
-      std::size_t found = outFile.find_last_of("/");
+      std::size_t found = bp.outFile.find_last_of("/");
       if(found != vstring::npos){
-        outFile = outFile.substr(found);
+        bp.outFile = bp.outFile.substr(found);
       }
-      outFile= outDir+"/"+outFile;
+      bp.outFile= outDir+"/"+bp.outFile;
     }
+    bp.index = problems.size();
+    bp.difficulty = parallelProblems > 1 ? estimateDifficulty(bp.probFile) : 1;
+    problems.push(bp);
+  }
+  if (parallelProblems > 1) {
+    sort<BatchProblem>(problems.begin(), problems.end());
+  }
+
+  // total difficulty of the problems that have not finished yet
+  float unfinishedDifficulty = 0;
+  for (unsigned i = 0; i < problems.size(); i++) {
+    unfinishedDifficulty += problems[i].difficulty;
+  }
 
-    // calculate the next problem time limit in milliseconds
+  int solvedProblems = 0;
+  unsigned next = 0;
+  unsigned freeCores = totalCores;
+  // positions in problems of the running problems
+  DHMap<pid_t,unsigned> running;
+  while (next < problems.size() || running.size()) {
+    // the problems started together get their shares of the same snapshot
     int elapsedTime = env.timer->elapsedMilliseconds();
     int timeRemainingForThisBatch = terminationTime - elapsedTime;
-    coutLineOutput() << "time remaining for this batch " << timeRemainingForThisBatch << endl;
-    int remainingBatchTimeForThisProblem = timeRemainingForThisBatch / remainingProblems;
-    coutLineOutput() << "remaining batch time for this problem " << remainingBatchTimeForThisProblem << endl;
-    int nextProblemTimeLimit;
-    if (!_problemTimeLimit) {
-      nextProblemTimeLimit = remainingBatchTimeForThisProblem;
-    }
-    else if (remainingBatchTimeForThisProblem > _problemTimeLimit) {
-      nextProblemTimeLimit = _problemTimeLimit;
-    }
-    else {
-      nextProblemTimeLimit = remainingBatchTimeForThisProblem;
-    }
-    // time in milliseconds when the current problem should terminate
-    int problemTerminationTime = elapsedTime + nextProblemTimeLimit;
-    coutLineOutput() << "problem termination time " << problemTerminationTime << endl;
+    float roundDifficulty = unfinishedDifficulty;
+    while (running.size() < parallelProblems && next < problems.size()) {
+      BatchProblem& bp = problems[next++];
+
+      // calculate the next problem time limit in milliseconds
+      coutLineOutput() << "time remaining for this batch " << timeRemainingForThisBatch << endl;
+      // the problems running at the same time share the remaining time
+      int remainingBatchTimeForThisProblem = min(timeRemainingForThisBatch,
+          int(float(timeRemainingForThisBatch) * parallelProblems * bp.difficulty / roundDifficulty));
+      coutLineOutput() << "remaining batch time for this problem " << remainingBatchTimeForThisProblem << endl;
+      int nextProblemTimeLimit;
+      if (!_problemTimeLimit) {
+        nextProblemTimeLimit = remainingBatchTimeForThisProblem;
+      }
+      else if (remainingBatchTimeForThisProblem > _problemTimeLimit) {
+        nextProblemTimeLimit = _problemTimeLimit;
+      }
+      else {
+        nextProblemTimeLimit = remainingBatchTimeForThisProblem;
+      }
+      // time in milliseconds when the current problem should terminate
+      int problemTerminationTime = elapsedTime + nextProblemTimeLimit;
+      coutLineOutput() << "problem termination time " << problemTerminationTime << endl;
 
-    env.beginOutput();
-    env.out() << flush << "%" << endl;
-    lineOutput() << "SZS status Started for " << probFile << endl << flush;
-    env.endOutput();
+      // the problems left to start take the free cores in equal shares
+      unsigned toStart = min(parallelProblems - running.size(), (unsigned)(problems.size() - next + 1));
+      bp.cores = max(1u, freeCores / toStart);
+      freeCores -= min(freeCores, bp.cores);
 
-    pid_t child = Multiprocessing::instance()->fork();
-    if (!child) {
-      // child process
-      CLTBProblem prob(this, probFile, outFile);
-      try {
-        prob.searchForProof(problemTerminationTime,nextProblemTimeLimit,_category);
-      } catch (Exception& exc) {
-        cerr << "% Exception at proof search level" << endl;
-        exc.cry(cerr);
-        System::terminateImmediately(1); //we didn't find the proof, so we return nonzero status code
-      }
-      // searchForProof() function should never return
-      ASSERTION_VIOLATION;
+      pid_t child = startProblem(bp, problemTerminationTime, nextProblemTimeLimit);
+      running.insert(child, next-1);
     }
 
-    env.beginOutput();
-    lineOutput() << "solver pid " << child << endl;
-    env.endOutput();
     int resValue;
-    // wait until the child terminates
+    pid_t finishedChild;
+    // wait until some child terminates
     try {
-      pid_t finishedChild = Multiprocessing::instance()->waitForChildTermination(resValue);
-      ASS_EQ(finishedChild, child);
+      finishedChild = Multiprocessing::instance()->waitForChildTermination(resValue);
     }
     catch(SystemFailException& ex) {
       cerr << "% SystemFailException at batch level" << endl;
       ex.cry(cerr);
+      // we cannot tell which problem terminated, so give up on all the
+      // running ones and carry on with the rest of the batch
+      DHMap<pid_t,unsigned>::Iterator rit(running);
+      while (rit.hasNext()) {
+        pid_t child;
+        unsigned pos;
+        rit.next(child, pos);
+        Multiprocessing::instance()->killNoCheck(child, SIGKILL);
+        try {
+          Multiprocessing::instance()->waitForParticularChildTermination(child, resValue);
+        }
+        catch(SystemFailException&) {
+          // already reaped
+        }
+        freeCores += problems[pos].cores;
+        unfinishedDifficulty -= problems[pos].difficulty;
+        reportProblem(problems[pos], false);
+      }
+      running.reset();
+      Timer::syncClock();
+      continue;
+    }
+    unsigned pos;
+    if (!running.pop(finishedChild, pos)) {
+      continue;
     }
+    BatchProblem& bp = problems[pos];
+    freeCores += bp.cores;
+    unfinishedDifficulty -= bp.difficulty;
 
-    // output the result depending on the termination code
-    env.beginOutput();
     if (!resValue) {
-      lineOutput() << "SZS status Theorem for " << probFile << endl;
       solvedProblems++;
-
-      if (env.options->ltbLearning() != Options::LTBLearning::OFF){
-        // As we solved it we can learn from the proof
-        learnFromSolutionFile(outFile);
-      }
     }
-    else {
-      lineOutput() << "SZS status GaveUp for " << probFile << endl;
-    }
-    env.out() << flush << '%' << endl;
-    lineOutput() << "% SZS status Ended for " << probFile << endl << flush;
-    env.endOutput();
+    reportProblem(bp, !resValue);
 
     Timer::syncClock();
-
-    remainingProblems--;
   }
   env.beginOutput();
   lineOutput() << "Solved " << solvedProblems << " out of " << _problemFiles.size() << endl;
   env.endOutput();
 } // CLTBMode::solveBatch(batchFile)
 
+/**
+ * Output the result of problem @b bp, which is no longer running
+ */
+void CLTBMode::reportProblem(const BatchProblem& bp, bool solved)
+{
+  CALL("CLTBMode::reportProblem");
+
+  env.beginOutput();
+  if (solved) {
+    lineOutput() << "SZS status Theorem for " << bp.probFile << endl;
+
+    if (env.options->ltbLearning() != Options::LTBLearning::OFF){
+      // As we solved it we can learn from the proof
+      vstring outFile = bp.outFile;
+      learnFromSolutionFile(outFile);
+    }
+  }
+  else {
+    lineOutput() << "SZS status GaveUp for " << bp.probFile << endl;
+  }
+  env.out() << flush << '%' << endl;
+  lineOutput() << "% SZS status Ended for " << bp.probFile << endl << flush;
+  env.endOutput();
+} // CLTBMode::reportProblem
+
+/**
+ * Fork the process solving problem @b bp with @b bp.cores parallel slices.
+ * The process shares the common axioms loaded by loadIncludes() with this
+ * one and never changes them here.
+ */
+pid_t CLTBMode::startProblem(const BatchProblem& bp, int problemTerminationTime, int problemTimeLimit)
+{
+  CALL("CLTBMode::startProblem");
+
+  env.beginOutput();
+  env.out() << flush << "%" << endl;
+  lineOutput() << "SZS status Started for " << bp.probFile << endl << flush;
+  env.endOutput();
+
+  _problemCores = bp.cores;
+  pid_t child = Multiprocessing::instance()->fork();
+  if (!child) {
+    // child process
+    CLTBProblem prob(this, bp.probFile, bp.outFile);
+    try {
+      prob.searchForProof(problemTerminationTime,problemTimeLimit,_category);
+    } catch (Exception& exc) {
+      cerr << "% Exception at proof search level" << endl;
+      exc.cry(cerr);
+      System::terminateImmediately(1); //we didn't find the proof, so we return nonzero status code
+    }
+    // searchForProof() function should never return
+    ASSERTION_VIOLATION;
+  }
+
+  env.beginOutput();
+  lineOutput() << "solver pid " << child << " cores " << bp.cores << endl;
+  env.endOutput();
+  return child;
+} // CLTBMode::startProblem
+
+/**
+ * Estimate how hard the problem in @b probFile is. For now this is only
+ * based on the size of the file (the common axioms are the same for all
+ * problems of the batch), on a logarithmic scale.
+ */
+float CLTBMode::estimateDifficulty(vstring probFile)
+{
+  CALL("CLTBMode::estimateDifficulty");
+
+  struct stat st;
+  if (stat(probFile.c_str(), &st)) {
+    return 1;
+  }
+  return 1 + log(1 + float(st.st_size)/4096);
+} // CLTBMode::estimateDifficulty
+
+/**
+ * Number of cores the proof search may use: if the total number of cores
+ * @b n is 8 or more, then @b n-2, otherwise @b n.
+ */
+unsigned CLTBMode::usableCores()
+{
+  CALL("CLTBMode::usableCores");
+
+  unsigned coreNumber = System::getNumberOfCores();
+  if (coreNumber <= 1) {
+    return 1;
+  }
+  if (coreNumber>=8) {
+    return coreNumber-2;
+  }
+  return coreNumber;
+} // CLTBMode::usableCores
+
 void CLTBMode::loadIncludes()
 {
   CALL("CLTBMode::loadIncludes");
@@ -591,6 +726,36 @@ CLTBProblem::CLTBProblem(CLTBMode* parent, vstring problemFile, vstring outFile)
 
 void CLTBProblem::fillSchedule(Schedule& sched,const Shell::Property* property,int timeLimit,Category category)
 {
+  CALL("CLTBProblem::fillSchedule");
+
+  ScheduleDatabase* db = ScheduleDatabase::fromOptions();
+  if (db) {
+    vstring name;
+    switch (category) {
+    case HH4:
+      name = "ltb_hh4_2017";
+      break;
+    case HLL:
+      name = "ltb_hll_2017";
+      break;
+    case ISA:
+      name = "ltb_isa_2017";
+      break;
+    case MZR:
+      name = "ltb_mzr_2017";
+      break;
+    default:
+      name = "ltb_default_2017";
+      break;
+    }
+    Schedule fallback;
+    if (db->getSchedule(name,*property,sched,fallback)) {
+      // LTB has a single schedule, the fallback strategies go after the quick ones
+      sched.loadFromIterator(Schedule::BottomFirstIterator(fallback));
+      return;
+    }
+  }
+
   switch (category) {
   case HH4:
     Schedules::getLtb2017Hh4Schedule(*property,sched);
@@ -808,8 +973,8 @@ static unsigned milliToDeci(unsigned timeInMiliseconds) {
 
 /**
  * Run a schedule. Terminate the process with 0 exit status
- * if a proof was found, otherwise return false. This function available cores:
- * If the total number of cores @b n is 8 or more, then @b n-2, otherwise @b n-1.
+ * if a proof was found, otherwise return false. This function uses the cores
+ * given to the problem by CLTBMode::solveBatch().
  * It spawns processes by calling runSlice()
  * @author Andrei Voronkov
  * @since 04/06/2013 flight Frankfurt-Vienna, updated for CASC-J6
@@ -818,19 +983,8 @@ bool CLTBProblem::runSchedule(Schedule& schedule,StrategySet& used,int terminati
 {
   CALL("CLTBProblem::runSchedule");
 
-  // compute the number of parallel processes depending on the
-  // number of available cores
-  int parallelProcesses;
-  unsigned coreNumber = System::getNumberOfCores();
-  if (coreNumber <= 1) {
-    parallelProcesses = 1;
-  }
-  else if (coreNumber>=8) {
-    parallelProcesses = coreNumber-2;
-  }
-  else {
-    parallelProcesses = coreNumber;
-  }
+  // the cores given to this problem by the batch
+  int parallelProcesses = parent->_problemCores;
 
   int processesLeft = parallelProcesses;
   Schedule::BottomFirstIterator it(schedule);
@@ -28,6 +28,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/Comparison.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/ScopedPtr.hpp"
@@ -65,7 +66,33 @@ class CLTBMode
 public:
   static void perform();
 private:
+  /** A problem of the batch */
+  struct BatchProblem
+  {
+    vstring probFile;
+    vstring outFile;
+    /** position of the problem in the batch file */
+    unsigned index;
+    /** estimated difficulty, see estimateDifficulty() */
+    float difficulty;
+    /** number of slices the problem may run in parallel */
+    unsigned cores;
+
+    /** easier problems first, then in the order of the batch file */
+    static Comparison compare(const BatchProblem& a, const BatchProblem& b)
+    {
+      if (a.difficulty != b.difficulty) {
+        return a.difficulty < b.difficulty ? LESS : GREATER;
+      }
+      return a.index < b.index ? LESS : (a.index > b.index ? GREATER : EQUAL);
+    }
+  };
+
   void solveBatch(istream& batchFile, bool first,vstring inputDirectory);
+  pid_t startProblem(const BatchProblem& bp, int problemTerminationTime, int problemTimeLimit);
+  void reportProblem(const BatchProblem& bp, bool solved);
+  static float estimateDifficulty(vstring probFile);
+  static unsigned usableCores();
   int readInput(istream& batchFile, bool first);
   static ostream& lineOutput();
   static ostream& coutLineOutput();
@@ -100,6 +127,8 @@ private:
   bool _questionAnswering;
   /** total time used by batches before this one, in milliseconds */
   int _timeUsedByPreviousBatches;
+  /** number of slices the problem being started may run in parallel */
+  unsigned _problemCores;
 
   /** files to be included */
   StringList* _theoryIncludes;
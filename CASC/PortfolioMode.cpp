@@ -35,14 +35,22 @@
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
+#include "Shell/Preprocess.hpp"
+#include "Shell/SineUtils.hpp"
 #include "Shell/TheoryFinder.hpp"
 
 #include <unistd.h>
 
+#include "Saturation/ClauseSharing.hpp"
 #include "Saturation/ProvingHelper.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Kernel/Problem.hpp"
+#include "Kernel/Sorts.hpp"
 
+#include "RunHistory.hpp"
+#include "ScheduleDatabase.hpp"
 #include "Schedules.hpp"
 
 #include "PortfolioMode.hpp"
@@ -50,7 +58,7 @@
 using namespace Lib;
 using namespace CASC;
 
-PortfolioMode::PortfolioMode() : _slowness(1.0), _syncSemaphore(2) {
+PortfolioMode::PortfolioMode() : _slowness(1.0), _property(0), _preprocessed(0), _slicePreprocessed(0), _syncSemaphore(2) {
   // We need the following two values because the way the semaphore class is currently implemented:
   // 1) dec is the only operation which is blocking
   // 2) dec is done in the mode SEM_UNDO, so is undone when a process terminates
@@ -73,6 +81,9 @@ bool PortfolioMode::perform(float slowness)
   bool resValue;
   try {
       resValue = pm.searchForProof();
+  } catch (TimeLimitExceededException&) {
+      //the time ran out while preprocessing for a group of slices
+      resValue = false;
   } catch (Exception& exc) {
       cerr << "% Exception at proof search level" << endl;
       exc.cry(cerr);
@@ -131,6 +142,13 @@ bool PortfolioMode::searchForProof()
     tf.search();
   }
 
+  //imported clauses have no derivation in the importing slice (they enter
+  //as EXTERNAL units), so sharing is only used when no proof is printed
+  if (env.options->clauseSharing() && env.options->proof()==Options::Proof::OFF) {
+    //before any symbols specific to some of the slices get introduced
+    Saturation::ClauseSharing::create();
+  }
+
   // now all the cpu usage will be in children, we'll just be waiting for them
   Timer::setTimeLimitEnforcement(false);
 
@@ -153,6 +171,17 @@ bool PortfolioMode::performStrategy(Shell::Property* property)
   Schedule::BottomFirstIterator it(fallback);
   main.loadFromIterator(it);
 
+  _property = property;
+  if (!env.options->runHistory().empty()) {
+    RunHistory history(env.options->runHistory());
+    history.adjustSchedule(*property,_slowness,main);
+  }
+
+  if (scheduleUsesSine(main)) {
+    // build the SInE index once here, slices inherit it when forked
+    SineSelector::buildIndex(_prb->units());
+  }
+
   int terminationTime = env.remainingTime()/100;
 
   if (terminationTime <= 0) {
@@ -171,6 +200,28 @@ bool PortfolioMode::performStrategy(Shell::Property* property)
   else{ return true;}
 }
 
+/**
+ * Return true if some slice of @b schedule switches on SInE selection
+ */
+bool PortfolioMode::scheduleUsesSine(Schedule& schedule)
+{
+  CALL("PortfolioMode::scheduleUsesSine");
+
+  Schedule::Iterator it(schedule);
+  while (it.hasNext()) {
+    vstring sliceCode = it.next();
+    size_t pos = sliceCode.find("ss=");
+    while (pos != vstring::npos) {
+      if (pos > 0 && (sliceCode[pos-1] == ':' || sliceCode[pos-1] == '_') &&
+          sliceCode.compare(pos+3,3,"off") != 0) {
+        return true;
+      }
+      pos = sliceCode.find("ss=",pos+3);
+    }
+  }
+  return false;
+}
+
 void PortfolioMode::getExtraSchedules(Property& prop, Schedule& extra)
 {
   CALL("PortfolioMode::getExtraSchedules");
@@ -241,6 +292,11 @@ void PortfolioMode::getSchedules(Property& prop, Schedule& quick, Schedule& fall
 {
   CALL("PortfolioMode::getSchedules");
 
+  ScheduleDatabase* db = ScheduleDatabase::fromOptions();
+  if (db && db->getSchedule(env.options->scheduleName(),prop,quick,fallback)) {
+    return;
+  }
+
   switch(env.options->schedule()) {
   case Options::Schedule::CASC_2014_EPR:
     Schedules::getCasc2014EprSchedule(prop,quick,fallback);
@@ -354,17 +410,55 @@ float PortfolioProcessPriorityPolicy::staticPriority(vstring sliceCode)
   return priority;
 }
 
-//should never be called
+/**
+ * Priority of a slice that has just been suspended, lower is better.
+ *
+ * We prefer slices that activated many clauses during their last quantum
+ * while their passive container did not grow much, and penalize those
+ * close to the memory limit. Slices that have not reported any progress
+ * (e.g. because they are still preprocessing) get a neutral priority.
+ */
 float PortfolioProcessPriorityPolicy::dynamicPriority(pid_t pid)
 {
-  ASSERTION_VIOLATION;
-  return 0.;
+  CALL("PortfolioProcessPriorityPolicy::dynamicPriority");
+
+  SliceProgress::Record cur;
+  if (!SliceProgress::instance() || !SliceProgress::instance()->read(pid, cur)) {
+    return 1.;
+  }
+  SliceProgress::Record* last;
+  if (_lastProgress.getValuePtr(pid, last)) {
+    last->activations = 0;
+    last->passive = 0;
+  }
+  float activations = float(cur.activations) - float(last->activations);
+  float passiveGrowth = max(0.f, float(cur.passive) - float(last->passive));
+  *last = cur;
+
+  float memoryUse = float(cur.memory) / Allocator::getMemoryLimit();
+  return (1. + passiveGrowth) / (1. + activations) * (1. + memoryUse);
 }
 
 PortfolioSliceExecutor::PortfolioSliceExecutor(PortfolioMode *mode)
   : _mode(mode)
 {}
 
+void PortfolioSliceExecutor::prepareSlice(vstring sliceCode)
+{
+  _mode->prepareSlice(sliceCode);
+}
+
+int PortfolioSliceExecutor::getSliceTime(vstring sliceCode)
+{
+  vstring chopped;
+  return _mode->getSliceTime(sliceCode, chopped);
+}
+
+void PortfolioSliceExecutor::sliceFinished(vstring sliceCode, bool solved, int timeMs, size_t memoryKb)
+{
+  _mode->recordSlice(sliceCode, solved, timeMs, memoryKb);
+}
+
 void PortfolioSliceExecutor::runSlice
   (vstring sliceCode, int terminationTime)
 {
@@ -373,8 +467,10 @@ void PortfolioSliceExecutor::runSlice
 
   int elapsedTime = milliToDeci(env.timer->elapsedMilliseconds());
   int remainingTime = terminationTime - elapsedTime;
-  if (sliceTime > remainingTime)
+  if (sliceTime > remainingTime || env.options->sliceQuantum())
   {
+    // a preempted slice is killed by the parent when its running time
+    // is up, its own timer also counts the time it spent suspended
     sliceTime = remainingTime;
   }
 
@@ -404,11 +500,26 @@ bool PortfolioMode::runSchedule(Schedule& schedule, int terminationTime)
 
   UIHelper::portfolioParent = true; // to report on overall-solving-ended in Timer.cpp
 
+  _groupSizes.reset();
+  Schedule::BottomFirstIterator it(schedule);
+  while(it.hasNext()) {
+    unsigned* cnt;
+    _groupSizes.getValuePtr(getPreprocessingKey(it.next()), cnt, 0);
+    (*cnt)++;
+  }
+
   PortfolioProcessPriorityPolicy policy;
   PortfolioSliceExecutor executor(this);
   ScheduleExecutor sched(&policy, &executor);
 
-  return sched.run(schedule, terminationTime);
+  bool res = sched.run(schedule, terminationTime);
+
+  if(_preprocessed) {
+    discardPreprocessed(_preprocessed);
+    _preprocessed = 0;
+  }
+  _preprocessingFailed.reset();
+  return res;
 }
 
 /**
@@ -433,6 +544,178 @@ unsigned PortfolioMode::getSliceTime(vstring sliceCode,vstring& chopped)
   return time;
 } // getSliceTime
 
+/**
+ * Assign to @b opt the options with which the slice @b sliceCode
+ * is going to be run (the time limits aside)
+ */
+void PortfolioMode::getSliceOptions(vstring sliceCode, Options& opt)
+{
+  CALL("PortfolioMode::getSliceOptions");
+
+  opt = *env.options;
+  opt.readFromEncodedOptions(sliceCode);
+  //see runSlice(Options&)
+  opt.setNormalize(false);
+  opt.setForcedOptionValues();
+  opt.checkGlobalOptionConstraints();
+}
+
+/**
+ * Return the key of the group of slices that preprocess the problem
+ * in the same way as the slice @b sliceCode
+ */
+vstring PortfolioMode::getPreprocessingKey(vstring sliceCode)
+{
+  CALL("PortfolioMode::getPreprocessingKey");
+
+  Options opt;
+  getSliceOptions(sliceCode, opt);
+  return opt.generatePreprocessingKey();
+}
+
+/**
+ * Called in the parent process right before the slice @b sliceCode is forked.
+ *
+ * When the slice belongs to a group of more than one slice with the same
+ * preprocessing options, the problem is preprocessed here for the group and
+ * the children of the group inherit the result, so that they can start
+ * saturating right away. The slices cannot be forked from a separate
+ * preprocessed process, because the schedule executor has to be their
+ * parent in order to stop and resume them.
+ *
+ * The symbols and sorts introduced by the preprocessing must not be seen by
+ * the slices of other groups, so the result is only kept while slices of
+ * the same group are being forked. Before a slice of another group is
+ * forked, the signature is rolled back and the result is discarded.
+ */
+void PortfolioMode::prepareSlice(vstring sliceCode)
+{
+  CALL("PortfolioMode::prepareSlice");
+
+  _slicePreprocessed = 0;
+
+  vstring key = getPreprocessingKey(sliceCode);
+  if(_preprocessed) {
+    if(_preprocessed->key == key) {
+      _slicePreprocessed = _preprocessed;
+      return;
+    }
+    discardPreprocessed(_preprocessed);
+    _preprocessed = 0;
+  }
+  unsigned groupSize;
+  if(!_groupSizes.find(key, groupSize) || groupSize<2 || _preprocessingFailed.find(key)) {
+    //nothing to share
+    return;
+  }
+  _preprocessed = preprocessForSlice(sliceCode);
+  if(!_preprocessed) {
+    _preprocessingFailed.insert(key);
+  }
+  _slicePreprocessed = _preprocessed;
+}
+
+/**
+ * Preprocess a copy of the problem with the options of the slice
+ * @b sliceCode. The options, statistics and clause priorities of the
+ * parent are restored afterwards, the signature when the result is
+ * discarded (see discardPreprocessed()).
+ *
+ * The schedule executor cannot reap, stop or resume slices meanwhile, so
+ * the preprocessing only gets a tenth of the time of the slice. Return zero
+ * if it fails or takes longer, the slices of the group then preprocess the
+ * problem themselves. If the global time limit is reached, the
+ * TimeLimitExceededException is passed on.
+ */
+PortfolioMode::PreprocessedProblem* PortfolioMode::preprocessForSlice(vstring sliceCode)
+{
+  CALL("PortfolioMode::preprocessForSlice");
+
+  Options opt;
+  getSliceOptions(sliceCode, opt);
+
+  PreprocessedProblem* res = new PreprocessedProblem();
+  res->key = opt.generatePreprocessingKey();
+  env.signature->checkpoint(res->signature);
+  res->sorts = env.sorts->count();
+  res->hasSort = env.sorts->hasSort();
+  res->prb = _prb->copy();
+
+  Options savedOptions = *env.options;
+  Statistics savedStatistics = *env.statistics;
+  DHMap<const Unit*,unsigned>* savedPriorities = env.clausePriorities;
+  *env.options = opt; //preprocessing still reads env.options in places
+
+  bool failed = false;
+  bool timeLimitReached = false;
+  try {
+    vstring chopped;
+    ScopedDeadline deadline(getSliceTime(sliceCode, chopped)*10);
+    TimeCounter tc(TC_PREPROCESSING);
+
+    Preprocess prepro(opt);
+    prepro.preprocess(*res->prb);
+    res->statistics = *env.statistics;
+  }
+  catch(TimeLimitExceededException&) {
+    failed = true;
+    //either just the deadline has passed, or the time is up
+    timeLimitReached = env.globalTimeLimitReached();
+  }
+  catch(Exception&) {
+    failed = true;
+  }
+  res->clausePriorities = env.clausePriorities;
+
+  *env.options = savedOptions;
+  *env.statistics = savedStatistics;
+  env.clausePriorities = savedPriorities;
+
+  if(failed) {
+    discardPreprocessed(res);
+    res = 0;
+  }
+  if(timeLimitReached) {
+    throw TimeLimitExceededException();
+  }
+  return res;
+}
+
+/**
+ * Remove the symbols and sorts the preprocessing @b pp introduced from the
+ * signature and the term sharing structure of the parent and delete @b pp
+ */
+void PortfolioMode::discardPreprocessed(PreprocessedProblem* pp)
+{
+  CALL("PortfolioMode::discardPreprocessed");
+
+  env.sharing->removeSymbolsFrom(pp->signature.functions(), pp->signature.predicates());
+  env.signature->rollback(pp->signature);
+  env.sorts->rollback(pp->sorts, pp->hasSort);
+
+  if(pp->clausePriorities && pp->clausePriorities != env.clausePriorities) {
+    delete pp->clausePriorities;
+  }
+  UnitList::destroy(pp->prb->units());
+  delete pp->prb;
+  delete pp;
+}
+
+/**
+ * Add the outcome of slice @b sliceCode to the run history, if there is one
+ */
+void PortfolioMode::recordSlice(vstring sliceCode, bool solved, int timeMs, size_t memoryKb)
+{
+  CALL("PortfolioMode::recordSlice");
+
+  if (env.options->runHistory().empty() || !_property) {
+    return;
+  }
+  vstring chopped;
+  getSliceTime(sliceCode, chopped);
+  RunHistory::append(env.options->runHistory(), *_property, chopped, solved, timeMs, memoryKb);
+}
+
 /**
  * Wait for termination of a child
  * return true if a proof was found
@@ -508,13 +791,25 @@ void PortfolioMode::runSlice(Options& strategyOpt)
   opt.checkGlobalOptionConstraints();
   *env.options = opt; //just temporarily until we get rid of dependencies on env.options in solving
 
+  if (Saturation::ClauseSharing::instance()) {
+    Saturation::ClauseSharing::instance()->setWorker(getpid());
+  }
+
   if (outputAllowed()) {
     env.beginOutput();
     addCommentSignForSZS(env.out()) << opt.testId() << " on " << opt.problemName() << endl;
     env.endOutput();
   }
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  if (_slicePreprocessed) {
+    //the parent has done the preprocessing for us
+    *env.statistics = _slicePreprocessed->statistics;
+    env.clausePriorities = _slicePreprocessed->clausePriorities;
+    Saturation::ProvingHelper::runVampireSaturation(*_slicePreprocessed->prb, opt);
+  }
+  else {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+  }
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION ||
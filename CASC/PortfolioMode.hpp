@@ -26,6 +26,8 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/ScopedPtr.hpp"
 #include "Lib/Set.hpp"
@@ -34,7 +36,11 @@
 #include "Lib/VString.hpp"
 #include "Lib/Sys/Semaphore.hpp"
 
+#include "Kernel/Signature.hpp"
+
 #include "Shell/Property.hpp"
+#include "Shell/SliceProgress.hpp"
+#include "Shell/Statistics.hpp"
 #include "Schedules.hpp"
 #include "ScheduleExecutor.hpp"
 
@@ -47,19 +53,27 @@ using namespace Shell;
 
 class PortfolioMode;
 
-// Simple one-after-the-other priority.
+// Simple one-after-the-other priority for new slices,
+// suspended slices are ordered by their progress.
 class PortfolioProcessPriorityPolicy : public ProcessPriorityPolicy
 {
 public:
   float staticPriority(vstring sliceCode) override;
   float dynamicPriority(pid_t pid) override;
+
+private:
+  /** progress of the slices when they were last suspended */
+  DHMap<pid_t,SliceProgress::Record> _lastProgress;
 };
 
 class PortfolioSliceExecutor : public SliceExecutor
 {
 public:
   PortfolioSliceExecutor(PortfolioMode *mode);
+  void prepareSlice(vstring sliceCode) override;
+  int getSliceTime(vstring sliceCode) override;
   void runSlice(vstring sliceCode, int terminationTime) override;
+  void sliceFinished(vstring sliceCode, bool solved, int timeMs, size_t memoryKb) override;
 
 private:
   PortfolioMode *_mode;
@@ -72,6 +86,8 @@ class PortfolioMode {
   };
 
   PortfolioMode();
+  friend void PortfolioSliceExecutor::prepareSlice(vstring sliceCode);
+  friend void PortfolioSliceExecutor::sliceFinished(vstring sliceCode, bool solved, int timeMs, size_t memoryKb);
   friend void PortfolioSliceExecutor::runSlice
     (vstring sliceCode, int terminationTime);
 public:
@@ -80,14 +96,45 @@ public:
 
 private:
 
+  /**
+   * Result of preprocessing the problem for a group of slices
+   * that share the preprocessing options
+   */
+  struct PreprocessedProblem
+  {
+    CLASS_NAME(PortfolioMode::PreprocessedProblem);
+    USE_ALLOCATOR(PreprocessedProblem);
+
+    /** preprocessing key of the group */
+    vstring key;
+    Problem* prb;
+    /** statistics collected during the preprocessing */
+    Statistics statistics;
+    /** SInE priorities of the preprocessed units, if any */
+    DHMap<const Kernel::Unit*,unsigned>* clausePriorities;
+    /** the signature before the preprocessing */
+    Kernel::Signature::Checkpoint signature;
+    /** number of sorts before the preprocessing */
+    unsigned sorts;
+    /** Sorts::hasSort() before the preprocessing */
+    bool hasSort;
+  };
+
   // some of these names are kind of arbitrary and should be perhaps changed
 
   bool searchForProof();
   bool performStrategy(Shell::Property* property);
   void getSchedules(Property& prop, Schedule& quick, Schedule& fallback);
   void getExtraSchedules(Property& prop, Schedule& extra); 
+  static bool scheduleUsesSine(Schedule& schedule);
   bool runSchedule(Schedule& schedule, int terminationTime);
   bool waitForChildAndCheckIfProofFound();
+  void getSliceOptions(vstring sliceCode, Options& opt);
+  vstring getPreprocessingKey(vstring sliceCode);
+  void prepareSlice(vstring sliceCode);
+  PreprocessedProblem* preprocessForSlice(vstring sliceCode);
+  void discardPreprocessed(PreprocessedProblem* pp);
+  void recordSlice(vstring sliceCode, bool solved, int timeMs, size_t memoryKb);
   void runSlice(vstring slice, unsigned timeLimitInDeciseconds) NO_RETURN;
   void runSlice(Options& strategyOpt) NO_RETURN;
 
@@ -96,6 +143,8 @@ private:
 #endif
 
   float _slowness;
+  /** properties of the problem, before normalisation */
+  Property* _property;
 
   /**
    * Problem that is being solved.
@@ -105,6 +154,19 @@ private:
    */
   ScopedPtr<Problem> _prb;
 
+  /** Number of slices of the current schedule with a given preprocessing key */
+  DHMap<vstring,unsigned> _groupSizes;
+  /**
+   * Problem preprocessed in the parent process for the group of the slice
+   * forked last, or zero. What the preprocessing added to the signature
+   * stays there until a slice of another group is forked.
+   */
+  PreprocessedProblem* _preprocessed;
+  /** Preprocessing keys of groups whose preprocessing in the parent failed */
+  DHSet<vstring> _preprocessingFailed;
+  /** Preprocessed problem of the slice being forked, or zero */
+  PreprocessedProblem* _slicePreprocessed;
+
   Semaphore _syncSemaphore; // semaphore for synchronizing proof printing
 };
 
@@ -0,0 +1,213 @@
+
+/*
+ * File RunHistory.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file RunHistory.cpp
+ * Implements class RunHistory.
+ */
+
+#include <cerrno>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Sort.hpp"
+
+#include "RunHistory.hpp"
+
+using namespace Lib;
+using namespace Shell;
+using namespace CASC;
+
+/**
+ * Read the history from file @b fileName. A missing file is an empty
+ * history.
+ */
+RunHistory::RunHistory(vstring fileName)
+{
+  CALL("RunHistory::RunHistory");
+
+  ifstream in(fileName.c_str());
+  vstring line;
+  while (getline(in, line)) {
+    istringstream str(line.c_str());
+    Record rec;
+    vstring strategy;
+    vstring outcome;
+    if (!(str >> rec.category >> rec.logic >> rec.props >> rec.atoms >> rec.clauses
+        >> rec.formulas >> rec.equalityAtoms >> strategy >> outcome >> rec.timeMs >> rec.memoryKb)) {
+      continue;
+    }
+    if (outcome != "solved" && outcome != "unsolved") {
+      continue;
+    }
+    rec.strategy = strategy;
+    rec.solved = outcome == "solved";
+    _records.push(rec);
+  }
+}
+
+/**
+ * Append the outcome of a slice running @b strategy on a problem with
+ * @b property to the history in file @b fileName.
+ */
+void RunHistory::append(vstring fileName, const Property& property, vstring strategy,
+    bool solved, int timeMs, size_t memoryKb)
+{
+  CALL("RunHistory::append");
+
+  vostringstream line;
+  line << property.category() << ' ' << property.getSMTLIBLogic() << ' '
+       << property.props() << ' ' << property.atoms() << ' ' << property.clauses() << ' '
+       << property.formulas() << ' ' << property.equalityAtoms() << ' ' << strategy << ' '
+       << (solved ? "solved" : "unsolved") << ' ' << timeMs << ' ' << memoryKb << '\n';
+  vstring str = line.str();
+
+  // a single write of a short line to a file opened for appending does not
+  // get interleaved with the lines of other runs
+  int fd = open(fileName.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd == -1) {
+    return;
+  }
+  ssize_t written = write(fd, str.c_str(), str.size());
+  (void)written;
+  close(fd);
+}
+
+/**
+ * Return true if @b rec comes from a problem of the same family as the
+ * one with @b property, that is, one with the same category, logic and
+ * properties, and with the number of atoms within a factor of two.
+ */
+bool RunHistory::similar(const Record& rec, const Property& property)
+{
+  CALL("RunHistory::similar");
+
+  unsigned atoms = property.atoms();
+  return rec.category == static_cast<unsigned>(property.category()) &&
+    rec.logic == static_cast<unsigned>(property.getSMTLIBLogic()) &&
+    rec.props == property.props() &&
+    rec.atoms <= 2*atoms && atoms <= 2*rec.atoms;
+}
+
+namespace {
+
+/** What the history says about a slice of the schedule */
+struct SliceEvidence
+{
+  /** position of the slice in the schedule */
+  unsigned index;
+  vstring code;
+  unsigned solved;
+  unsigned unsolved;
+  /** longest running time of a successful run */
+  unsigned maxSolvedTime;
+
+  /**
+   * Order in which the slices should run: first those that solved similar
+   * problems, the more often the earlier, then those the history knows
+   * nothing about, then those that only failed. The original order breaks
+   * the ties.
+   */
+  static Comparison compare(const SliceEvidence& a, const SliceEvidence& b)
+  {
+    unsigned aRank = a.solved ? 0 : (a.unsolved ? 2 : 1);
+    unsigned bRank = b.solved ? 0 : (b.unsolved ? 2 : 1);
+    if (aRank != bRank) {
+      return aRank < bRank ? LESS : GREATER;
+    }
+    if (a.solved != b.solved) {
+      return a.solved > b.solved ? LESS : GREATER;
+    }
+    return a.index < b.index ? LESS : (a.index > b.index ? GREATER : EQUAL);
+  }
+};
+
+}
+
+/**
+ * Reorder and resize the slices of @b schedule for a problem with
+ * @b property, based on how the same strategies did on similar problems.
+ *
+ * Slices whose strategy solved similar problems go first and get twice
+ * the longest time any of those runs needed (in units of the schedule,
+ * that is, divided by @b slowness), which usually shrinks them, sometimes
+ * extends them. Slices whose strategy never solved a similar problem but
+ * failed on one go last. Slices the history knows nothing about keep
+ * their time and relative order.
+ */
+void RunHistory::adjustSchedule(const Property& property, float slowness, Schedule& schedule) const
+{
+  CALL("RunHistory::adjustSchedule");
+
+  if (_records.isEmpty()) {
+    return;
+  }
+
+  DHMap<vstring,unsigned> positions;
+  Stack<SliceEvidence> slices;
+  for (unsigned i = 0; i < schedule.size(); i++) {
+    vstring code = schedule[i];
+    SliceEvidence ev;
+    ev.index = i;
+    ev.code = code;
+    ev.solved = 0;
+    ev.unsolved = 0;
+    ev.maxSolvedTime = 0;
+    slices.push(ev);
+    // the first slice of a strategy gets the evidence
+    positions.insert(code.substr(0, code.find_last_of('_')), i);
+  }
+
+  Stack<Record>::ConstIterator rit(_records);
+  while (rit.hasNext()) {
+    const Record& rec = rit.next();
+    unsigned pos;
+    if (!positions.find(rec.strategy, pos) || !similar(rec, property)) {
+      continue;
+    }
+    SliceEvidence& ev = slices[pos];
+    if (rec.solved) {
+      ev.solved++;
+      ev.maxSolvedTime = max(ev.maxSolvedTime, rec.timeMs);
+    }
+    else {
+      ev.unsolved++;
+    }
+  }
+
+  sort<SliceEvidence>(slices.begin(), slices.end());
+
+  schedule.reset();
+  Stack<SliceEvidence>::BottomFirstIterator sit(slices);
+  while (sit.hasNext()) {
+    const SliceEvidence& ev = sit.next();
+    if (!ev.solved) {
+      schedule.push(ev.code);
+      continue;
+    }
+    unsigned time = static_cast<unsigned>(2 * ev.maxSolvedTime / (100 * slowness)) + 1;
+    schedule.push(ev.code.substr(0, ev.code.find_last_of('_')) + "_" + Int::toString(time));
+  }
+}
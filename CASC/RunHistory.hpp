@@ -0,0 +1,92 @@
+
+/*
+ * File RunHistory.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file RunHistory.hpp
+ * Defines class RunHistory.
+ */
+
+#ifndef __RunHistory__
+#define __RunHistory__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Shell/Property.hpp"
+
+#include "Schedules.hpp"
+
+namespace CASC {
+
+using namespace Lib;
+using namespace Shell;
+
+/**
+ * Outcomes of portfolio slices on past problems, kept in a file that
+ * each run appends to (see the run_history option).
+ *
+ * Each line of the file records one slice:
+ *
+ *   category logic props atoms clauses formulas equality_atoms strategy outcome time memory
+ *
+ * where the first seven fields are features of the problem given by
+ * Property (the category and logic as numbers), strategy is the slice
+ * code without its time, outcome is either "solved" or "unsolved", time
+ * is the running time in milliseconds and memory the peak memory in
+ * kilobytes (0 if not known). Lines that cannot be read are ignored,
+ * as the file may be written by several runs at once.
+ */
+class RunHistory
+{
+public:
+  CLASS_NAME(RunHistory);
+  USE_ALLOCATOR(RunHistory);
+
+  explicit RunHistory(vstring fileName);
+
+  void adjustSchedule(const Property& property, float slowness, Schedule& schedule) const;
+
+  static void append(vstring fileName, const Property& property, vstring strategy,
+      bool solved, int timeMs, size_t memoryKb);
+
+private:
+  struct Record
+  {
+    unsigned category;
+    unsigned logic;
+    uint64_t props;
+    unsigned atoms;
+    unsigned clauses;
+    unsigned formulas;
+    unsigned equalityAtoms;
+    vstring strategy;
+    bool solved;
+    unsigned timeMs;
+    size_t memoryKb;
+  };
+
+  static bool similar(const Record& rec, const Property& property);
+
+  Stack<Record> _records;
+};
+
+}
+
+#endif // __RunHistory__
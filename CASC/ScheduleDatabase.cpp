@@ -0,0 +1,348 @@
+
+/*
+ * File ScheduleDatabase.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ScheduleDatabase.cpp
+ * Implements class ScheduleDatabase.
+ */
+
+#include <cstdlib>
+#include <fstream>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/StringUtils.hpp"
+
+#include "Parse/SMTLIB2.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "ScheduleDatabase.hpp"
+
+using namespace Lib;
+using namespace Shell;
+using namespace CASC;
+
+/** Number of problem categories, see Property::Category */
+static const unsigned CATEGORY_COUNT = Property::UEQ+1;
+
+ScheduleDatabase::~ScheduleDatabase()
+{
+  CALL("ScheduleDatabase::~ScheduleDatabase");
+
+  Stack<Rule*>::Iterator rit(_rules);
+  while (rit.hasNext()) {
+    delete rit.next();
+  }
+  DHMap<vstring,Entry*>::Iterator eit(_schedules);
+  while (eit.hasNext()) {
+    delete eit.next();
+  }
+}
+
+/**
+ * Return the database given by the schedule_file option, or zero if
+ * the option is not set. The file is read only once.
+ */
+ScheduleDatabase* ScheduleDatabase::fromOptions()
+{
+  CALL("ScheduleDatabase::fromOptions");
+
+  static ScheduleDatabase* db = 0;
+  vstring fileName = env.options->scheduleFile();
+  if (db || fileName.empty()) {
+    return db;
+  }
+
+  ifstream in(fileName.c_str());
+  if (in.fail()) {
+    USER_ERROR("Cannot open schedule file: "+fileName);
+  }
+  db = new ScheduleDatabase();
+  db->load(in, fileName);
+  return db;
+}
+
+ScheduleDatabase::Condition ScheduleDatabase::parseCondition(vstring token, vstring fileName, unsigned line)
+{
+  CALL("ScheduleDatabase::parseCondition");
+
+  vstring where = fileName+":"+Int::toString(line)+": ";
+
+  size_t opStart = token.find_first_of("=!<>&");
+  if (opStart == vstring::npos || opStart == 0) {
+    USER_ERROR(where+"malformed condition "+token);
+  }
+  size_t valStart = token.find_first_not_of("=!<>&", opStart);
+  if (valStart == vstring::npos) {
+    USER_ERROR(where+"missing value in condition "+token);
+  }
+  vstring feature = token.substr(0, opStart);
+  vstring op = token.substr(opStart, valStart-opStart);
+  vstring value = token.substr(valStart);
+
+  Condition res;
+  res.value = 0;
+  if (op == "=") { res.op = EQ; }
+  else if (op == "!=") { res.op = NEQ; }
+  else if (op == "<") { res.op = LT; }
+  else if (op == "<=") { res.op = LEQ; }
+  else if (op == ">") { res.op = GT; }
+  else if (op == ">=") { res.op = GEQ; }
+  else if (op == "&") { res.op = BITS; }
+  else {
+    USER_ERROR(where+"unknown operator "+op);
+  }
+
+  if (feature == "category" || feature == "logic") {
+    res.feature = feature == "category" ? CATEGORY : LOGIC;
+    if (res.op != EQ) {
+      USER_ERROR(where+feature+" can only be compared by =");
+    }
+    Stack<vstring> names;
+    StringUtils::splitStr(value.c_str(), ',', names);
+    Stack<vstring>::Iterator nit(names);
+    while (nit.hasNext()) {
+      vstring name = nit.next();
+      if (res.feature == CATEGORY) {
+        unsigned cat = 0;
+        while (cat < CATEGORY_COUNT && Property::categoryToString(static_cast<Property::Category>(cat)) != name) {
+          cat++;
+        }
+        if (cat == CATEGORY_COUNT) {
+          USER_ERROR(where+"unknown category "+name);
+        }
+        res.names.push(cat);
+      }
+      else {
+        SMTLIBLogic logic = Parse::SMTLIB2::getLogicFromString(name);
+        if (logic == SMT_UNDEFINED) {
+          USER_ERROR(where+"unknown logic "+name);
+        }
+        res.names.push(logic);
+      }
+    }
+    return res;
+  }
+
+  if (feature == "props") { res.feature = PROPS; }
+  else if (feature == "atoms") { res.feature = ATOMS; }
+  else if (feature == "clauses") { res.feature = CLAUSES; }
+  else if (feature == "formulas") { res.feature = FORMULAS; }
+  else if (feature == "equality_atoms") { res.feature = EQUALITY_ATOMS; }
+  else {
+    USER_ERROR(where+"unknown feature "+feature);
+  }
+  if (res.op == BITS && res.feature != PROPS) {
+    USER_ERROR(where+"only props can be tested by &");
+  }
+  char* end;
+  res.value = strtoull(value.c_str(), &end, 10);
+  if (*end) {
+    USER_ERROR(where+"malformed number "+value);
+  }
+  return res;
+}
+
+/**
+ * Read schedules from @b in. Schedules with the same names as ones
+ * loaded before replace them.
+ */
+void ScheduleDatabase::load(std::istream& in, vstring fileName)
+{
+  CALL("ScheduleDatabase::load");
+
+  Entry* entry = 0;
+  Rule* rule = 0;
+  unsigned line = 0;
+  vstring str;
+  while (getline(in, str)) {
+    line++;
+    size_t comment = str.find('#');
+    if (comment != vstring::npos) {
+      str = str.substr(0, comment);
+    }
+    for (size_t i = 0; i < str.size(); i++) {
+      if (str[i] == '\t' || str[i] == '\r') {
+        str[i] = ' ';
+      }
+    }
+    Stack<vstring> tokens;
+    StringUtils::splitStr(str.c_str(), ' ', tokens);
+    Stack<vstring> nonEmpty;
+    Stack<vstring>::Iterator tit(tokens);
+    while (tit.hasNext()) {
+      vstring t = tit.next();
+      if (!t.empty()) {
+        nonEmpty.push(t);
+      }
+    }
+    if (nonEmpty.isEmpty()) {
+      continue;
+    }
+
+    vstring keyword = nonEmpty[0];
+    if (keyword == "schedule") {
+      if (nonEmpty.size() != 2) {
+        USER_ERROR(fileName+":"+Int::toString(line)+": expected schedule name");
+      }
+      Entry* old;
+      if (_schedules.find(nonEmpty[1], old)) {
+        delete old;
+      }
+      entry = new Entry();
+      entry->quick.ensure(CATEGORY_COUNT);
+      entry->fallback.ensure(CATEGORY_COUNT);
+      _schedules.set(nonEmpty[1], entry);
+      rule = 0;
+    }
+    else if (keyword == "quick" || keyword == "fallback") {
+      if (!entry) {
+        USER_ERROR(fileName+":"+Int::toString(line)+": rule outside of a schedule");
+      }
+      rule = new Rule();
+      _rules.push(rule);
+
+      const Condition* category = 0;
+      for (unsigned i = 1; i < nonEmpty.size(); i++) {
+        rule->conditions.push(parseCondition(nonEmpty[i], fileName, line));
+      }
+      for (unsigned i = 0; i < rule->conditions.size(); i++) {
+        if (rule->conditions[i].feature == CATEGORY) {
+          if (category) {
+            USER_ERROR(fileName+":"+Int::toString(line)+": more than one category condition");
+          }
+          category = &rule->conditions[i];
+        }
+      }
+
+      DArray<RuleStack>& index = keyword == "quick" ? entry->quick : entry->fallback;
+      for (unsigned cat = 0; cat < CATEGORY_COUNT; cat++) {
+        if (!category || category->names.find(cat)) {
+          index[cat].push(rule);
+        }
+      }
+      if (category) {
+        // already taken care of by the index
+        Stack<Condition> rest;
+        for (unsigned i = 0; i < rule->conditions.size(); i++) {
+          if (rule->conditions[i].feature != CATEGORY) {
+            rest.push(rule->conditions[i]);
+          }
+        }
+        rule->conditions = rest;
+      }
+    }
+    else {
+      if (!rule || nonEmpty.size() != 1) {
+        USER_ERROR(fileName+":"+Int::toString(line)+": unexpected "+str);
+      }
+      rule->strategies.push(keyword);
+    }
+  }
+}
+
+bool ScheduleDatabase::holds(const Condition& c, const Property& property)
+{
+  CALL("ScheduleDatabase::holds");
+
+  uint64_t actual;
+  switch (c.feature) {
+  case CATEGORY:
+    return c.names.find(property.category());
+  case LOGIC:
+    return c.names.find(property.getSMTLIBLogic());
+  case PROPS:
+    actual = property.props();
+    break;
+  case ATOMS:
+    actual = property.atoms();
+    break;
+  case CLAUSES:
+    actual = property.clauses();
+    break;
+  case FORMULAS:
+    actual = property.formulas();
+    break;
+  case EQUALITY_ATOMS:
+    actual = property.equalityAtoms();
+    break;
+  default:
+    ASSERTION_VIOLATION;
+    return false;
+  }
+
+  switch (c.op) {
+  case EQ: return actual == c.value;
+  case NEQ: return actual != c.value;
+  case LT: return actual < c.value;
+  case LEQ: return actual <= c.value;
+  case GT: return actual > c.value;
+  case GEQ: return actual >= c.value;
+  case BITS: return (actual & c.value) != 0;
+  }
+  ASSERTION_VIOLATION;
+  return false;
+}
+
+const ScheduleDatabase::Rule* ScheduleDatabase::firstMatch(const RuleStack& rules, const Property& property)
+{
+  CALL("ScheduleDatabase::firstMatch");
+
+  RuleStack::ConstIterator rit(rules);
+  while (rit.hasNext()) {
+    const Rule* rule = rit.next();
+    bool matches = true;
+    for (unsigned i = 0; matches && i < rule->conditions.size(); i++) {
+      matches = holds(rule->conditions[i], property);
+    }
+    if (matches) {
+      return rule;
+    }
+  }
+  return 0;
+}
+
+/**
+ * If the database contains schedule @b name, push its strategies for a
+ * problem with @b property into @b quick and @b fallback and return true.
+ * Otherwise return false.
+ */
+bool ScheduleDatabase::getSchedule(vstring name, const Property& property, Schedule& quick, Schedule& fallback) const
+{
+  CALL("ScheduleDatabase::getSchedule");
+
+  Entry* entry;
+  if (!_schedules.find(name, entry)) {
+    return false;
+  }
+
+  const Rule* q = firstMatch(entry->quick[property.category()], property);
+  if (q) {
+    quick.loadFromIterator(Stack<vstring>::BottomFirstIterator(q->strategies));
+  }
+  const Rule* f = firstMatch(entry->fallback[property.category()], property);
+  if (f) {
+    fallback.loadFromIterator(Stack<vstring>::BottomFirstIterator(f->strategies));
+  }
+  return true;
+}
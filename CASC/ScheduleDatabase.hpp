@@ -0,0 +1,141 @@
+
+/*
+ * File ScheduleDatabase.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ScheduleDatabase.hpp
+ * Defines class ScheduleDatabase.
+ */
+
+#ifndef __ScheduleDatabase__
+#define __ScheduleDatabase__
+
+#include <istream>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Shell/Property.hpp"
+
+#include "Schedules.hpp"
+
+namespace CASC {
+
+using namespace Lib;
+using namespace Shell;
+
+/**
+ * Schedules read at runtime, to be used instead of the ones in Schedules.
+ *
+ * The database is a text file of the following form. Everything after
+ * a '#' is a comment.
+ *
+ *   schedule casc_2017
+ *   quick category=NEQ props=131075
+ *   dis+2_64_bs=off:cond=fast_4
+ *   ...
+ *   quick category=NEQ atoms<2500
+ *   ...
+ *   fallback
+ *   ...
+ *
+ * A "quick" or "fallback" line starts a rule of the current schedule, and
+ * is followed by the strategies of the rule. The quick (resp. fallback)
+ * schedule for a problem consists of the strategies of the first quick
+ * (resp. fallback) rule whose conditions the problem satisfies, so a
+ * nest of if-else statements of Schedules turns into a sequence of rules.
+ *
+ * A condition has the form feature op value. The features are category
+ * and logic, which take comma separated lists of names and allow only =,
+ * and props, atoms, clauses, formulas and equality_atoms, which are
+ * compared by =, !=, <, <=, > and >=. In addition, props&N holds if
+ * props has some of the bits of N set.
+ *
+ * The rules of each schedule are indexed by the problem category.
+ */
+class ScheduleDatabase
+{
+public:
+  CLASS_NAME(ScheduleDatabase);
+  USE_ALLOCATOR(ScheduleDatabase);
+
+  ~ScheduleDatabase();
+
+  void load(std::istream& in, vstring fileName);
+  bool getSchedule(vstring name, const Property& property, Schedule& quick, Schedule& fallback) const;
+
+  static ScheduleDatabase* fromOptions();
+
+private:
+  enum Feature {
+    CATEGORY,
+    LOGIC,
+    PROPS,
+    ATOMS,
+    CLAUSES,
+    FORMULAS,
+    EQUALITY_ATOMS
+  };
+  enum Operator { EQ, NEQ, LT, LEQ, GT, GEQ, BITS };
+
+  struct Condition
+  {
+    Feature feature;
+    Operator op;
+    /** value to compare with, unused for categories and logics */
+    uint64_t value;
+    /** accepted values of category and logic */
+    Stack<unsigned> names;
+  };
+
+  struct Rule
+  {
+    CLASS_NAME(ScheduleDatabase::Rule);
+    USE_ALLOCATOR(Rule);
+
+    /** the conditions, except for the one on the category */
+    Stack<Condition> conditions;
+    Stack<vstring> strategies;
+  };
+
+  typedef Stack<Rule*> RuleStack;
+
+  /** rules of a schedule, for each category separately */
+  struct Entry
+  {
+    CLASS_NAME(ScheduleDatabase::Entry);
+    USE_ALLOCATOR(Entry);
+
+    DArray<RuleStack> quick;
+    DArray<RuleStack> fallback;
+  };
+
+  static bool holds(const Condition& c, const Property& property);
+  static const Rule* firstMatch(const RuleStack& rules, const Property& property);
+  static Condition parseCondition(vstring token, vstring fileName, unsigned line);
+
+  DHMap<vstring,Entry*> _schedules;
+  Stack<Rule*> _rules;
+};
+
+}
+
+#endif // __ScheduleDatabase__
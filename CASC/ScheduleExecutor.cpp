@@ -1,6 +1,7 @@
 #include "ScheduleExecutor.hpp"
 
 #include "Lib/Array.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/List.hpp"
 #include "Lib/PriorityQueue.hpp"
@@ -8,18 +9,45 @@
 #include "Lib/Sys/Multiprocessing.hpp"
 #include "Lib/Timer.hpp"
 #include "Shell/Options.hpp"
+#include "Shell/SliceProgress.hpp"
+#include "Shell/UIHelper.hpp"
 
 using namespace CASC;
 using namespace Lib;
 using namespace Lib::Sys;
+using namespace Shell;
 
 #define DECI(milli) (milli/100)
 
+/**
+ * Time in milliseconds a slice may run over its scheduled time before it
+ * is killed by run(). Slices normally stop on their own timer, this is
+ * only a backstop for code that does not check it.
+ */
+static const int OVERRUN_GRACE = 1000;
+
 ScheduleExecutor::ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor)
   : _policy(policy), _executor(executor)
 {
   CALL("ScheduleExecutor::ScheduleExecutor");
   _numWorkers = getNumWorkers();
+  _quantum = env.options->sliceQuantum()*100;
+  _stallLimit = env.options->sliceStallLimit()*100;
+
+  if(!SliceProgress::instance())
+  {
+    // preempted slices over this limit would only be waiting and taking memory
+    SliceProgress::create(2*_numWorkers);
+  }
+
+  if(env.options->pinWorkers())
+  {
+    _placement = new CpuPlacement();
+    if(!_placement->size())
+    {
+      _placement = 0;
+    }
+  }
 }
 
 class Item
@@ -53,6 +81,12 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
 {
   CALL("ScheduleExecutor::run");
 
+  resetWorkers();
+  if(_quantum)
+  {
+    return runPreemptive(schedule, terminationTime);
+  }
+
   PriorityQueue<Item> queue;
   Schedule::BottomFirstIterator it(schedule);
 
@@ -66,6 +100,18 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
 
   typedef List<pid_t> Pool;
   Pool *pool = Pool::empty();
+  // code and start time of the started slices
+  DHMap<pid_t,pair<vstring,int> > started;
+  // time by which the started slices must have finished
+  DHMap<pid_t,int> deadlines;
+  // progress records of the started slices, as long as there are free ones
+  SliceProgress* progress = SliceProgress::instance();
+  DHMap<pid_t,unsigned> progressSlots;
+  Stack<unsigned> freeSlots;
+  for(unsigned i = progress->slots(); i > 0; i--)
+  {
+    freeSlots.push(i-1);
+  }
 
   bool success = false;
   while(Timer::syncClock(), DECI(env.timer->elapsedMilliseconds()) < terminationTime)
@@ -79,40 +125,94 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
       pid_t process;
       if(!item.started())
       {
-        process = spawn(item.code(), terminationTime);
+        int slot = freeSlots.isNonEmpty() ? static_cast<int>(freeSlots.pop()) : -1;
+        process = spawn(item.code(), terminationTime, slot);
+        int now = env.timer->elapsedMilliseconds();
+        started.insert(process, make_pair(item.code(), now));
+        deadlines.insert(process, now + _executor->getSliceTime(item.code())*100 + OVERRUN_GRACE);
+        if(slot >= 0)
+        {
+          progressSlots.insert(process, slot);
+        }
       }
       else
       {
         process = item.process();
+        assignWorker(process);
+        unsigned slot;
+        if(progressSlots.find(process, slot))
+        {
+          progress->touch(slot);
+        }
         Multiprocessing::instance()->kill(process, SIGCONT);
       }
       Pool::push(process, pool);
       poolSize++;
     }
 
+    // sleep until a process changes state, some slice overruns its time
+    // or it is time to look for stalled ones
+    int now = env.timer->elapsedMilliseconds();
+    int timeout = (terminationTime*100) - now;
+    if(_stallLimit)
+    {
+      timeout = min(timeout, _stallLimit/2);
+    }
+    Pool::Iterator dit(pool);
+    while(dit.hasNext())
+    {
+      timeout = min(timeout, deadlines.get(dit.next()) - now);
+    }
     bool stopped, exited;
     int code;
-    // sleep until process changes state
     pid_t process = Multiprocessing::instance()
-      ->poll_children(stopped, exited, code);
-
-    // child died, remove it from the pool and check if succeeded
-    if(exited)
+      ->poll_children(stopped, exited, code, max(timeout, 1));
+    now = env.timer->elapsedMilliseconds();
+    Pool::Iterator pit(pool);
+    while(pit.hasNext())
     {
-      pool = Pool::remove(process, pool);
-      if(!code)
+      pid_t p = pit.next();
+      if(p != process && (now >= deadlines.get(p) || isStalled(p)))
       {
-        success = true;
-        goto exit;
+        // reported as killed later on
+        Multiprocessing::instance()->killNoCheck(p, SIGKILL);
       }
     }
+    if(!process)
+    {
+      continue;
+    }
+
     // child stopped, re-insert it in the queue
-    else if(stopped)
+    if(stopped)
     {
       pool = Pool::remove(process, pool);
+      releaseWorker(process);
       float priority = _policy->dynamicPriority(process);
       queue.insert(priority, Item(process));
     }
+    // child died or was killed, remove it from the pool and check if succeeded
+    else
+    {
+      pool = Pool::remove(process, pool);
+      releaseWorker(process);
+      pair<vstring,int> slice;
+      ALWAYS(started.pop(process, slice));
+      deadlines.remove(process);
+      unsigned slot;
+      if(progressSlots.pop(process, slot))
+      {
+        freeSlots.push(slot);
+      }
+      _executor->sliceFinished(slice.first, exited && !code,
+          env.timer->elapsedMilliseconds() - slice.second,
+          Multiprocessing::instance()->lastChildPeakMemory());
+      if(exited && !code)
+      {
+        success = true;
+        goto exit;
+      }
+    }
 
     // pool empty and queue exhausted - we failed
     if(!pool && queue.isEmpty())
@@ -132,6 +232,278 @@ exit:
   return success;
 }
 
+/** State of a slice started by runPreemptive */
+struct PreemptedSlice
+{
+  enum State {
+    RUNNING,
+    /** sent SIGSTOP, which has not been reported yet */
+    STOPPING,
+    SUSPENDED,
+    /** sent SIGKILL as its time is up */
+    KILLED
+  };
+
+  State state;
+  vstring code;
+  unsigned progressSlot;
+  /** scheduled running time of the slice in milliseconds */
+  int sliceTime;
+  /** running time left to the slice in milliseconds */
+  int budget;
+  /** time when the slice was last started or resumed */
+  int resumedAt;
+};
+
+/**
+ * Run the schedule, letting the started slices take turns on the workers.
+ *
+ * Up to SliceProgress::slots() slices are kept alive. When a slice has
+ * been running for a quantum and some other one is waiting, the slice is
+ * suspended with SIGSTOP and gets a dynamic priority from the policy,
+ * based on its progress. A free worker goes to the next not yet started
+ * slice if there is room for it, otherwise to the suspended slice with
+ * the best priority. Slices are killed once their running time reaches
+ * their scheduled time, since their own timers also count the time they
+ * spent suspended.
+ */
+bool ScheduleExecutor::runPreemptive(const Schedule &schedule, int terminationTime)
+{
+  CALL("ScheduleExecutor::runPreemptive");
+
+  SliceProgress* progress = SliceProgress::instance();
+  ASS(progress);
+
+  PriorityQueue<vstring> fresh;
+  Schedule::BottomFirstIterator it(schedule);
+  while(it.hasNext())
+  {
+    vstring code = it.next();
+    fresh.insert(_policy->staticPriority(code), code);
+  }
+
+  DHMap<pid_t,PreemptedSlice> slices;
+  Stack<pid_t> running;
+  PriorityQueue<pid_t> suspended;
+  Stack<unsigned> freeSlots;
+  for(unsigned i = progress->slots(); i > 0; i--)
+  {
+    freeSlots.push(i-1);
+  }
+
+  bool success = false;
+  while(Timer::syncClock(), DECI(env.timer->elapsedMilliseconds()) < terminationTime)
+  {
+    int now = env.timer->elapsedMilliseconds();
+
+    // fill the free workers
+    while(running.size() < _numWorkers)
+    {
+      pid_t process;
+      if(!fresh.isEmpty() && freeSlots.isNonEmpty())
+      {
+        vstring code = fresh.pop();
+        PreemptedSlice s;
+        s.code = code;
+        s.progressSlot = freeSlots.pop();
+        s.sliceTime = _executor->getSliceTime(code)*100;
+        s.budget = s.sliceTime;
+        process = spawn(code, terminationTime, s.progressSlot);
+        slices.insert(process, s);
+      }
+      else if(!suspended.isEmpty())
+      {
+        process = suspended.pop();
+        assignWorker(process);
+        progress->touch(slices.get(process).progressSlot);
+        Multiprocessing::instance()->kill(process, SIGCONT);
+      }
+      else
+      {
+        break;
+      }
+      PreemptedSlice& s = slices.get(process);
+      s.state = PreemptedSlice::RUNNING;
+      s.resumedAt = now;
+      running.push(process);
+    }
+
+    // nothing alive and nothing to start - we failed
+    if(slices.isEmpty())
+    {
+      goto exit;
+    }
+
+    // sleep until a process changes state or some slice is due for preemption
+    int timeout = (terminationTime*100) - now;
+    if(_stallLimit)
+    {
+      timeout = min(timeout, _stallLimit/2);
+    }
+    Stack<pid_t>::Iterator rit(running);
+    while(rit.hasNext())
+    {
+      const PreemptedSlice& s = slices.get(rit.next());
+      int used = now - s.resumedAt;
+      timeout = min(timeout, max(min(_quantum, s.budget) - used, 0));
+    }
+    bool stopped, exited;
+    int code;
+    pid_t process = Multiprocessing::instance()
+      ->poll_children(stopped, exited, code, max(timeout, 1));
+
+    if(process)
+    {
+      PreemptedSlice& s = slices.get(process);
+      if(stopped)
+      {
+        if(s.state == PreemptedSlice::STOPPING)
+        {
+          s.state = PreemptedSlice::SUSPENDED;
+          suspended.insert(_policy->dynamicPriority(process), process);
+        }
+        else if(s.state == PreemptedSlice::RUNNING)
+        {
+          // stopped by someone else (e.g. SIGTSTP), the slice keeps its
+          // worker, so just let it continue
+          Multiprocessing::instance()->kill(process, SIGCONT);
+        }
+        // a suspended or killed slice stays as it is
+      }
+      // child exited or was killed
+      else
+      {
+        int runningTime = s.sliceTime - s.budget;
+        if(s.state == PreemptedSlice::RUNNING)
+        {
+          ALWAYS(running.remove(process));
+          releaseWorker(process);
+          runningTime += env.timer->elapsedMilliseconds() - s.resumedAt;
+        }
+        _executor->sliceFinished(s.code, exited && !code, runningTime,
+            Multiprocessing::instance()->lastChildPeakMemory());
+        freeSlots.push(s.progressSlot);
+        slices.remove(process);
+        if(exited && !code)
+        {
+          success = true;
+          goto exit;
+        }
+      }
+    }
+
+    // preempt the slices that used up their quantum or their time
+    now = env.timer->elapsedMilliseconds();
+    bool waiting = !suspended.isEmpty() || (!fresh.isEmpty() && freeSlots.isNonEmpty());
+    for(unsigned i = running.size(); i > 0; i--)
+    {
+      pid_t p = running[i-1];
+      PreemptedSlice& s = slices.get(p);
+      int used = now - s.resumedAt;
+      if(used >= s.budget || isStalled(p))
+      {
+        // the slice will be removed when reported as killed
+        Multiprocessing::instance()->killNoCheck(p, SIGKILL);
+        s.state = PreemptedSlice::KILLED;
+        s.budget = max(s.budget - used, 0);
+        ALWAYS(running.remove(p));
+        releaseWorker(p);
+      }
+      else if(waiting && used >= _quantum)
+      {
+        Multiprocessing::instance()->kill(p, SIGSTOP);
+        s.state = PreemptedSlice::STOPPING;
+        s.budget -= used;
+        ALWAYS(running.remove(p));
+        releaseWorker(p);
+      }
+    }
+  }
+
+exit:
+  VirtualIterator<pid_t> killIt = slices.domain();
+  while(killIt.hasNext())
+  {
+    Multiprocessing::instance()->killNoCheck(killIt.next(), SIGKILL);
+  }
+  return success;
+}
+
+/**
+ * Return true if the slice running in @b process has not reported any
+ * progress for longer than the stall limit, and report it. Slices are
+ * only checked once they have started saturating, since the progress is
+ * reported by the saturation loop.
+ */
+bool ScheduleExecutor::isStalled(pid_t process)
+{
+  CALL("ScheduleExecutor::isStalled");
+
+  SliceProgress::Record rec;
+  if(!_stallLimit || !SliceProgress::instance()->read(process, rec) || !rec.activations)
+  {
+    return false;
+  }
+  if(SliceProgress::now() - rec.heartbeat < static_cast<unsigned>(_stallLimit))
+  {
+    return false;
+  }
+  if(outputAllowed())
+  {
+    env.beginOutput();
+    addCommentSignForSZS(env.out()) << "killing stalled slice: ";
+    SliceProgress::output(env.out(), rec);
+    env.out() << endl;
+    env.endOutput();
+  }
+  return true;
+}
+
+/**
+ * Mark all workers as free
+ */
+void ScheduleExecutor::resetWorkers()
+{
+  CALL("ScheduleExecutor::resetWorkers");
+
+  _workerOf.reset();
+  _freeWorkers.reset();
+  for(unsigned i = _numWorkers; i > 0; i--)
+  {
+    _freeWorkers.push(i-1);
+  }
+}
+
+/**
+ * Let the resumed slice running in @b process take a free worker
+ * (and its CPU, if the slices are pinned)
+ */
+void ScheduleExecutor::assignWorker(pid_t process)
+{
+  CALL("ScheduleExecutor::assignWorker");
+
+  unsigned worker = _freeWorkers.pop();
+  _workerOf.insert(process, worker);
+  if(_placement)
+  {
+    CpuPlacement::pin(process, _placement->cpuFor(worker));
+  }
+}
+
+/**
+ * Free the worker of the slice in @b process, which is not running anymore
+ */
+void ScheduleExecutor::releaseWorker(pid_t process)
+{
+  CALL("ScheduleExecutor::releaseWorker");
+
+  unsigned worker;
+  if(_workerOf.pop(process, worker))
+  {
+    _freeWorkers.push(worker);
+  }
+}
+
 unsigned ScheduleExecutor::getNumWorkers()
 {
   CALL("ScheduleExecutor::getNumWorkers");
@@ -146,21 +518,52 @@ unsigned ScheduleExecutor::getNumWorkers()
   return workers;
 }
 
-pid_t ScheduleExecutor::spawn(vstring code, int terminationTime)
+/**
+ * Fork a process for slice @b code. If @b progressSlot is non-negative,
+ * the slice reports its progress into that record of the SliceProgress
+ * board.
+ */
+pid_t ScheduleExecutor::spawn(vstring code, int terminationTime, int progressSlot)
 {
   CALL("ScheduleExecutor::spawn");
 
+  _executor->prepareSlice(code);
+  if(progressSlot >= 0)
+  {
+    SliceProgress::instance()->clear(progressSlot);
+  }
+  unsigned worker = _freeWorkers.pop();
+
   pid_t pid = Multiprocessing::instance()->fork();
   ASS_NEQ(pid, -1);
 
   // parent
   if(pid)
   {
+    _workerOf.insert(pid, worker);
     return pid;
   }
   // child
   else
   {
+    if(progressSlot >= 0)
+    {
+      SliceProgress::instance()->attach(progressSlot);
+    }
+    if(_placement)
+    {
+      // pinned before allocating anything, so that the memory is local
+      const CpuPlacement::Cpu& cpu = _placement->cpuFor(worker);
+      bool pinned = CpuPlacement::pin(0, cpu);
+      if(outputAllowed())
+      {
+        env.beginOutput();
+        addCommentSignForSZS(env.out()) << code << (pinned ? " pinned to " : " could not be pinned to ");
+        CpuPlacement::output(env.out(), cpu);
+        env.out() << endl;
+        env.endOutput();
+      }
+    }
     _executor->runSlice(code, terminationTime);
     ASSERTION_VIOLATION; // should not return
   }
@@ -2,6 +2,12 @@
 #define __ScheduleExector__
 
 #include <unistd.h>
+
+#include "Lib/DHMap.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Sys/CpuPlacement.hpp"
+
 #include "Schedules.hpp"
 
 namespace CASC
@@ -17,7 +23,22 @@ public:
 class SliceExecutor
 {
 public:
+  /**
+   * Called in the parent process right before the slice @b sliceCode
+   * is forked, so that work shared by several slices can be done
+   * once and inherited by the children.
+   */
+  virtual void prepareSlice(Lib::vstring sliceCode) {}
+  /** Return the running time of slice @b sliceCode in deciseconds */
+  virtual int getSliceTime(Lib::vstring sliceCode) = 0;
   virtual void runSlice(Lib::vstring sliceCode, int terminationTime) NO_RETURN = 0;
+  /**
+   * Called in the parent process when the slice @b sliceCode terminated
+   * or was killed because its time was up, after running for @b timeMs
+   * milliseconds with peak memory of @b memoryKb kilobytes (0 if unknown).
+   * Slices killed because another one succeeded are not reported.
+   */
+  virtual void sliceFinished(Lib::vstring sliceCode, bool solved, int timeMs, size_t memoryKb) {}
 };
 
 class ScheduleExecutor
@@ -27,12 +48,31 @@ public:
   bool run(const Schedule &schedule, int terminationTime);
 
 private:
-  pid_t spawn(Lib::vstring code, int terminationTime);
+  bool runPreemptive(const Schedule &schedule, int terminationTime);
+  pid_t spawn(Lib::vstring code, int terminationTime, int progressSlot=-1);
   unsigned getNumWorkers();
+  bool isStalled(pid_t process);
+  void resetWorkers();
+  void assignWorker(pid_t process);
+  void releaseWorker(pid_t process);
 
   ProcessPriorityPolicy *_policy;
   SliceExecutor *_executor;
   unsigned _numWorkers;
+  /** Time in milliseconds after which a slice may be preempted, 0 if never */
+  int _quantum;
+  /**
+   * Time in milliseconds without progress after which a slice is
+   * killed, 0 if never
+   */
+  int _stallLimit;
+
+  /** CPUs of the workers, zero if the slices are not pinned */
+  Lib::ScopedPtr<Lib::Sys::CpuPlacement> _placement;
+  /** workers not running any slice */
+  Lib::Stack<unsigned> _freeWorkers;
+  /** worker of each running slice */
+  Lib::DHMap<pid_t,unsigned> _workerOf;
 };
 }
 
@@ -49,7 +49,12 @@ public:
   };
 
   virtual ~DecisionProcedure() {}
-  /** add literals */
+  /**
+   * Add literals
+   *
+   * Can also be called after getStatus if it did not return UNSATISFIABLE,
+   * the next call to getStatus then decides the extended set of literals.
+   */
   virtual void addLiterals(LiteralIterator lits, bool onlyEqualites = false) = 0;
   /** return the result */
   virtual Status getStatus(bool getMultipleCores=false) = 0;
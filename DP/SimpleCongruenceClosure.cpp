@@ -161,8 +161,6 @@ SimpleCongruenceClosure::SimpleCongruenceClosure(Ordering* ord) :
   _posLitConst = getFreshConst();
   _negLitConst = getFreshConst();
   _negEqualities.push(CEq(_posLitConst, _negLitConst, 0));
-
-  _hadPropagated = false;
 }
 
 void SimpleCongruenceClosure::reset()
@@ -173,6 +171,7 @@ void SimpleCongruenceClosure::reset()
   _cInfos.expand(1);
   _sigConsts.reset();
   _pairNames.reset();
+  _pairConsts.reset();
   _termNames.reset();
   _litNames.reset();
 
@@ -189,16 +188,9 @@ void SimpleCongruenceClosure::reset()
     _cInfos[i].resetEquivalences(*this, i);
   }
 
-  PairMap::DelIterator pmit(_pairNames);
-  while(pmit.hasNext()) {
-    CPair namePair;
-    unsigned nameConst;
-    pmit.next(namePair, nameConst);
-
-    if(_cInfos[nameConst].namedPair!=namePair) {
-      pmit.del();
-    }
-  }
+  //pairs named after a propagation need not have their own entry in _pairNames
+  _pairNames.reset();
+  _pairNames.loadFromMap(_pairConsts);
 
   //this leaves us just with the true!=false non-equality
   _negEqualities.truncate(1);
@@ -212,8 +204,6 @@ void SimpleCongruenceClosure::reset()
   _pendingEqualities.reset();
   _distinctConstraints.reset();
   _negDistinctConstraints.reset();
-
-  _hadPropagated = false;
 }
 
 /** Introduce fresh congruence closure constant */
@@ -249,13 +239,25 @@ unsigned SimpleCongruenceClosure::getPairName(CPair p)
   CALL("SimpleCongruenceClosure::getPairName");
 
   unsigned* pRes;
-  if(!_pairNames.getValuePtr(p, pRes)) {
+  if(!_pairConsts.getValuePtr(p, pRes)) {
     return *pRes;
   }
   unsigned res = getFreshConst();
   _cInfos[res].namedPair = p;
   *pRes = res;
 
+  // If literals are added after a propagation, the pair may be
+  // congruent with an already named one
+  CPair derefPair = deref(p);
+  unsigned* pLookup;
+  if(_pairNames.getValuePtr(derefPair, pLookup)) {
+    *pLookup = res;
+  }
+  else {
+    ASS_NEQ(*pLookup,res);
+    addPendingEquality(CEq(*pLookup, res));
+  }
+
   _cInfos[p.first].useList.push(res);
   if(_cInfos[p.first].reprConst!=0) {
     // Martin: if we are here, the above insertion was not needed now,
@@ -444,7 +446,7 @@ SimpleCongruenceClosure::CEq SimpleCongruenceClosure::convertFOEquality(Literal*
 void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualites)
 {
   CALL("SimpleCongruenceClosure::addLiterals");
-  ASS(!_hadPropagated);
+  ASS(_unsatEqs.isEmpty());
 
   while(lits.hasNext()) {
     Literal* l = lits.next();
@@ -532,8 +534,6 @@ void SimpleCongruenceClosure::propagate()
 {
   CALL("SimpleCongruenceClosure::propagate");
 
-  _hadPropagated = true;
-
   while(_pendingEqualities.isNonEmpty()) {
     CEq curr0 = _pendingEqualities.pop_back();
     CPair curr = deref(curr0);
@@ -51,6 +51,10 @@ using namespace Kernel;
  * 
  * Hint: understand _pairNames as "Lookup" from the paper.
  * 
+ * Literals can be added also after a call to getStatus that did not return
+ * UNSATISFIABLE. The congruence is then extended with the new literals
+ * without being recomputed from scratch.
+ *
  * However, classList of a representative 
  * does not (physically) contain that representative (only logically)
  */
@@ -280,6 +284,11 @@ private:
   typedef DHMap<CPair,unsigned> PairMap;
   /** Names of constant pairs (modulo the congruence!)*/
   PairMap _pairNames;
+  /**
+   * Names of constant pairs as they were created, not affected by the congruence.
+   * Used to rebuild @c _pairNames on reset.
+   */
+  PairMap _pairConsts;
 
   /** Constants corresponding to terms */
   DHMap<TermList,unsigned> _termNames;
@@ -307,12 +316,6 @@ private:
    * http://www.cs.miami.edu/~tptp/TPTP/SyntaxBNF.html
    * "It can be used only as a fact, not under any connective." */  
   DistinctStack _negDistinctConstraints;
-
-  /**
-   * used to assert we don't add literals after propagation.
-   * this would cause problems with term caches upon reset.
-   */
-  bool _hadPropagated;
 }; // class SimpleCongruenceClosure
 
 }
@@ -26,6 +26,7 @@
  */
 
 #include <math.h>
+#include <signal.h>
 
 #include "Kernel/Ordering.hpp"
 #include "Kernel/Inference.hpp"
@@ -39,9 +40,9 @@
 #include "Kernel/Substitution.hpp"
 #include "Kernel/FormulaUnit.hpp"
 
-#include "SAT/Preprocess.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Lib/Environment.hpp"
@@ -53,6 +54,8 @@
 #include "Lib/Random.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/ArrayMap.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+#include "Lib/Sys/SyncPipe.hpp"
 
 #include "Shell/UIHelper.hpp"
 #include "Shell/TPTPPrinter.hpp"
@@ -81,7 +84,8 @@ namespace FMB
 {
 
 FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
-: MainLoop(prb, opt), _sortedSignature(0), _groundClauses(0), _clauses(0),
+: MainLoop(prb, opt), _incremental(opt.fmbIncremental()), _freshSolver(true),
+                      _sortedSignature(0), _groundClauses(0), _clauses(0),
                       _isAppropriate(true)
 
 {
@@ -151,6 +155,8 @@ FiniteModelBuilder::~FiniteModelBuilder()
 {
   CALL("FiniteModelBuilder::~FiniteModelBuilder");
 
+  destroyOldGenerations();
+
   if(_dsaEnumerator){
     BYPASSING_ALLOCATOR;
 
@@ -158,25 +164,29 @@ FiniteModelBuilder::~FiniteModelBuilder()
   }
 }
 
-// Do all setting up required for finite model search 
-// Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
-// large signatures and large models. If this a frequent problem then we can go to longs.
-bool FiniteModelBuilder::reset(){
-  CALL("FiniteModelBuilder::reset");
+void FiniteModelBuilder::destroyOldGenerations()
+{
+  CALL("FiniteModelBuilder::destroyOldGenerations");
 
-  // Construct the offsets for symbols
-  // Each symbol requires size^n) variables where n is the number of spaces for grounding
-  // For function symbols we have n=arity+1 as we have the return value
-  // For predicate symbols n=arity 
+  while(_oldGenerations.isNonEmpty()){
+    delete _oldGenerations.pop();
+  }
+}
 
+// Construct the offsets for symbols
+// Each symbol requires size^n) variables where n is the number of spaces for grounding
+// For function symbols we have n=arity+1 as we have the return value
+// For predicate symbols n=arity 
+// Returns false if the offsets overflow
+bool FiniteModelBuilder::allocateSymbolVariables(unsigned& offsets)
+{
+  CALL("FiniteModelBuilder::allocateSymbolVariables");
 
   // This has been refined after adding multiple sorts i.e. no general 'size'
   // We now need the current size of the sort of each position to compute the offsets
 
   static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
 
-  // Start from 1 as SAT solver variables are 1-based
-  unsigned offsets=1;
   for(unsigned f=0; f<env.signature->functions();f++){
     if(del_f[f]) continue; 
     f_offsets[f]=offsets;
@@ -225,19 +235,58 @@ bool FiniteModelBuilder::reset(){
   cout << "Maximum offset is " << offsets << endl;
 #endif
 
-  if (_xmass) {
-    marker_offsets.ensure(_distinctSortSizes.size());
-    for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-      unsigned add = _distinctSortSizes[i];
+  return true;
+}
 
-      marker_offsets[i] = offsets;
+// Each distinct sort needs as many markers as is its size, the existing ones are kept
+bool FiniteModelBuilder::allocateMarkers(unsigned& offsets)
+{
+  CALL("FiniteModelBuilder::allocateMarkers");
+  ASS(_xmass);
 
-      // Check for overflow
-      if(VAR_MAX - add < offsets){
-        return false;
-      }
+  static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
 
-      offsets += add;
+  _markerVars.ensure(_distinctSortSizes.size());
+  for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+    unsigned add = _distinctSortSizes[i] - _markerVars[i].size();
+
+    // Check for overflow
+    if(VAR_MAX - add < offsets){
+      return false;
+    }
+
+    while (_markerVars[i].size() < _distinctSortSizes[i]) {
+      _markerSorts.insert(offsets,i);
+      _markerVars[i].push(offsets++);
+    }
+  }
+  return true;
+}
+
+// Do all setting up required for finite model search 
+// Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
+// large signatures and large models. If this a frequent problem then we can go to longs.
+bool FiniteModelBuilder::reset(){
+  CALL("FiniteModelBuilder::reset");
+
+  static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
+
+  destroyOldGenerations();
+
+  // Start from 1 as SAT solver variables are 1-based
+  unsigned offsets=1;
+  if (!allocateSymbolVariables(offsets)) {
+    return false;
+  }
+
+  if (_xmass) {
+    _markerVars.ensure(_distinctSortSizes.size());
+    for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+      _markerVars[i].reset();
+    }
+    _markerSorts.reset();
+    if (!allocateMarkers(offsets)) {
+      return false;
     }
   } else {
     unsigned add = _distinctSortSizes.size();
@@ -261,9 +310,29 @@ bool FiniteModelBuilder::reset(){
     offsets += add;
   }
 
+  if (_incremental) {
+    if(VAR_MAX - 1 < offsets){
+      return false;
+    }
+    _symmetryMarker = offsets++;
+  }
+
   // Create a new SAT solver
-  try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
+  if(_opt.satSolver() == Options::SatSolver::LINGELING){
+    LingelingInterfacing* solver = new LingelingInterfacing(_opt,true);
+    if (!_incremental) {
+      // all clauses are added before the only call to the solver
+      solver->allowVariableElimination();
+    }
+    _solver = solver;
+  }
+  else try{
+    MinisatInterfacingNewSimp* solver = new MinisatInterfacingNewSimp(_opt,true);
+    if (_incremental) {
+      // variables of the current sizes will appear in the clauses added for larger sizes
+      solver->disableVariableElimination();
+    }
+    _solver = solver;
   }catch(Minisat::OutOfMemoryException&){
     MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
   }
@@ -296,6 +365,13 @@ bool FiniteModelBuilder::reset(){
 
   // set the number of SAT variables, this could cause an exception
   _solver->ensureVarCount(offsets-1);
+  _nextVar = offsets;
+  _addedClauseCount = 0;
+
+  // nothing has been grounded for the new solver yet
+  _freshSolver = true;
+  _groundedSortSizes.init(_sortedSignature->sorts,0);
+  _groundedDistinctSortSizes.init(_sortedSignature->distinctSorts,0);
 
   // needs to be redone for each size as we use this to pick the number of
   // things to order and the constants to ground with 
@@ -304,6 +380,86 @@ bool FiniteModelBuilder::reset(){
   return true;
 }
 
+/**
+ * Return true if the SAT solver can be kept for the new _sortModelSizes,
+ * i.e. we are in the incremental mode and no sort got smaller
+ *
+ * (Instances grounded for a larger size of some sort would constrain
+ * elements outside of the smaller domain.)
+ */
+bool FiniteModelBuilder::canExtend()
+{
+  CALL("FiniteModelBuilder::canExtend");
+
+  if (!_incremental || _freshSolver) {
+    return false;
+  }
+  for(unsigned s=0;s<_sortedSignature->sorts;s++){
+    if(_sortModelSizes[s] < _groundedSortSizes[s]){
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Prepare the encoding of the larger _sortModelSizes with the current SAT solver
+ *
+ * Variables of groundings that fit into the previous sizes are kept
+ * (see Generation), new variables are allocated for the others and
+ * for the markers of the new totality and symmetry constraints.
+ * Returns false if the variables overflow.
+ */
+bool FiniteModelBuilder::extend()
+{
+  CALL("FiniteModelBuilder::extend");
+  ASS(canExtend());
+
+  static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
+
+  Generation* gen = new Generation();
+  gen->sortSizes.initFromArray(_groundedSortSizes.size(),_groundedSortSizes);
+  gen->fOffsets.initFromArray(f_offsets.size(),f_offsets);
+  gen->pOffsets.initFromArray(p_offsets.size(),p_offsets);
+  _oldGenerations.push(gen);
+
+  unsigned offsets=_nextVar;
+  if (!allocateSymbolVariables(offsets)) {
+    return false;
+  }
+
+  if (_xmass) {
+    if (!allocateMarkers(offsets)) {
+      return false;
+    }
+  } else {
+    // the totality clauses of the previous sizes are switched off by not assuming their markers
+    unsigned add = _distinctSortSizes.size();
+
+    totalityMarker_offset = offsets;
+
+    // Check for overflow
+    if(VAR_MAX - add < offsets){
+      return false;
+    }
+
+    offsets += add;
+  }
+
+  if(VAR_MAX - 1 < offsets){
+    return false;
+  }
+  _symmetryMarker = offsets++;
+
+  _solver->ensureVarCount(offsets-1);
+  _nextVar = offsets;
+  _addedClauseCount = 0;
+
+  createSymmetryOrdering();
+
+  return true;
+}
+
 // Compare function symbols by their usage in the problem
 struct FMBSymmetryFunctionComparator
 {
@@ -941,8 +1097,7 @@ void FiniteModelBuilder::addGroundClauses()
         SATLiteral slit = getSATLiteral(f,emptyGrounding,(*c)[i]->polarity(),false);
         satClauseLits.push(slit);
       }
-      SATClause* satCl = SATClause::fromStack(satClauseLits);
-      addSATClause(satCl);
+      addSATClause(satClauseLits);
   }
 }
 
@@ -1037,6 +1192,21 @@ instanceLabel:
       } 
       else{
         grounding[var]++;
+
+        if (!_freshSolver) {
+          // instances over the previously grounded sizes are already in the solver
+          bool old = true;
+          for(unsigned v=0;v<vars;v++){
+            if(grounding[v] > _groundedSortSizes[(*varSorts)[v]]){
+              old = false;
+              break;
+            }
+          }
+          if(old){
+            goto instanceLabel;
+          }
+        }
+
         // Grounding represents a new instance
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
@@ -1071,7 +1241,7 @@ instanceLabel:
 
             if (val > 1) {
               // cout << "Marking sort " << i << " with " << val-2 << " negative" << endl;
-              satClauseLits.push(SATLiteral(marker_offsets[i]+val-2,0));
+              satClauseLits.push(SATLiteral(marker(i,val-2),0));
             }
           }
           // cout << "Clause finised" << endl;
@@ -1113,7 +1283,16 @@ instanceLabel:
               use[j] = grounding[t->nthArgument(j)->var()];
             }
             use[arity]=grounding[lit->nthArgument(1)->var()];
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),true));
+            SATLiteral slit = getSATLiteral(functor,use,lit->polarity(),true);
+            if(_symmetryFalseVars.contains(slit.var())){
+              if(slit.isNegative()){
+                //Skip instance, satisfied by the symmetry ordering
+                goto instanceLabel;
+              }
+              //Skip literal, falsified by the symmetry ordering
+              continue;
+            }
+            satClauseLits.push(slit);
             
           }else{
             unsigned functor = lit->functor();
@@ -1129,8 +1308,7 @@ instanceLabel:
           }
         }
      
-        SATClause* satCl = SATClause::fromStack(satClauseLits);
-        addSATClause(satCl);
+        addSATClause(satClauseLits);
 
         goto instanceLabel;
       }
@@ -1221,6 +1399,16 @@ newFuncLabel:
             //Skip this instance
             goto newFuncLabel;
           }
+          if(!_freshSolver){
+            // skip the instances over the previously grounded sizes
+            bool old = grounding[0] <= _groundedSortSizes[returnSrt] && grounding[1] <= _groundedSortSizes[returnSrt];
+            for(unsigned a=2;old && a<arity+2;a++){
+              old = grounding[a] <= _groundedSortSizes[f_signature[a-2]];
+            }
+            if(old){
+              goto newFuncLabel;
+            }
+          }
           static SATLiteralStack satClauseLits;
           satClauseLits.reset();
 
@@ -1236,8 +1424,7 @@ newFuncLabel:
           use[arity]=grounding[1];
           satClauseLits.push(getSATLiteral(f,use,false,true)); 
 
-          SATClause* satCl = SATClause::fromStack(satClauseLits);
-          addSATClause(satCl);
+          addSATClause(satClauseLits);
           goto newFuncLabel;
         }
       }
@@ -1270,8 +1457,10 @@ void FiniteModelBuilder::addNewSymmetryOrderingAxioms(unsigned size,
     SATLiteral sl = getSATLiteral(gt.f,grounding,true,true);
     satClauseLits.push(sl);
   }
-  SATClause* satCl = SATClause::fromStack(satClauseLits);
-  addSATClause(satCl);
+  if(_incremental){
+    satClauseLits.push(SATLiteral(_symmetryMarker,0));
+  }
+  addSATClause(satClauseLits);
 
 }
 
@@ -1316,7 +1505,10 @@ void FiniteModelBuilder::addNewSymmetryCanonicityAxioms(unsigned size,
 
         satClauseLits.push(getSATLiteral(gtj.f,grounding_j,true,true));
       }
-      addSATClause(SATClause::fromStack(satClauseLits));
+      if(_incremental){
+        satClauseLits.push(SATLiteral(_symmetryMarker,0));
+      }
+      addSATClause(satClauseLits);
   }
 
 }
@@ -1356,7 +1548,7 @@ void FiniteModelBuilder::addUseModelSize(unsigned size)
     }
   }
 
-  addSATClause(SATClause::fromStack(satClauseLits));
+  addSATClause(satClauseLits);
 */
 }
 
@@ -1367,16 +1559,16 @@ void FiniteModelBuilder::addNewTotalityDefs()
   if (_xmass) {
     // make sure to solve the problem of some sorts not growing all the way to _sortModelSizes[srt], because of _sortedSignature->sortBounds[srt]
     for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-      // for every sort
-      for (unsigned j = 0; j < _distinctSortSizes[i]-1; j++) {
+      // for every sort (the clauses for markers grounded before are already there)
+      unsigned j = _groundedDistinctSortSizes[i] ? _groundedDistinctSortSizes[i]-1 : 0;
+      for (; j < _distinctSortSizes[i]-1; j++) {
         // for every domain size j have clause: not marker(j+1) | marker(j)
         // which says: "d > j+2" -> "d > j+1"
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
-        satClauseLits.push(SATLiteral(marker_offsets[i]+j,1));
-        satClauseLits.push(SATLiteral(marker_offsets[i]+j+1,0));
-        SATClause* satCl = SATClause::fromStack(satClauseLits);
-        addSATClause(satCl);
+        satClauseLits.push(SATLiteral(marker(i,j),1));
+        satClauseLits.push(SATLiteral(marker(i,j+1),0));
+        addSATClause(satClauseLits);
       }
     }
   }
@@ -1398,7 +1590,16 @@ void FiniteModelBuilder::addNewTotalityDefs()
 
       // cout << "Totality for const " << f << " of sort " << srt << " and max size " << maxSize << endl;
 
-      for (unsigned i = (!_xmass || (_sortedSignature->monotonicSorts[dsrt])) ? maxSize : 1; i <= maxSize; i++) { // just the weakest one, if monotonic
+      unsigned first = (!_xmass || (_sortedSignature->monotonicSorts[dsrt])) ? maxSize : 1; // just the weakest one, if monotonic
+      if (_xmass && !_freshSolver) {
+        // the xmass versions for sizes below the previous maximum are already there
+        if (_groundedSortSizes[srt] == _sortModelSizes[srt]) {
+          continue;
+        }
+        first = max(first,min(_sortedSignature->sortBounds[srt],_groundedSortSizes[srt]));
+      }
+
+      for (unsigned i = first; i <= maxSize; i++) {
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
 
@@ -1410,15 +1611,14 @@ void FiniteModelBuilder::addNewTotalityDefs()
         }
         if (_xmass) {
           unsigned marker_idx = (i == maxSize) ? _distinctSortSizes[dsrt]-1 : i-1; // use the largest marker for the largest version even if it is smaller than _distinctSortSizes[dsrt]
-          satClauseLits.push(SATLiteral(marker_offsets[dsrt] + marker_idx,1));
+          satClauseLits.push(SATLiteral(marker(dsrt,marker_idx),1));
           ///cout << "out sort " << dsrt;
           // cout << "  version for size " << i << " marked with " << i-1 << " positive" << endl;
         } else {
           satClauseLits.push(SATLiteral(totalityMarker_offset+dsrt,0));
         }
 
-        SATClause* satCl = SATClause::fromStack(satClauseLits);
-        addSATClause(satCl);
+        addSATClause(satClauseLits);
       }
 
       continue;
@@ -1451,7 +1651,22 @@ newTotalLabel:
           //for(unsigned j=0;j<grounding.size();j++) cout << grounding[j] << " ";
           //cout << endl;
 
-          for (unsigned i = (!_xmass || (_sortedSignature->monotonicSorts[dRetSrt])) ? maxRtSrtSize : 1; i <= maxRtSrtSize; i++) {
+          unsigned first = (!_xmass || (_sortedSignature->monotonicSorts[dRetSrt])) ? maxRtSrtSize : 1;
+          if (_xmass && !_freshSolver) {
+            bool old = true;
+            for(unsigned a=0;old && a<arity;a++){
+              old = grounding[a] <= _groundedSortSizes[f_signature[a]];
+            }
+            if (old) {
+              // the xmass versions for sizes below the previous maximum are already there
+              if (_groundedSortSizes[retSrt] == _sortModelSizes[retSrt]) {
+                goto newTotalLabel;
+              }
+              first = max(first,min(_sortedSignature->sortBounds[retSrt],_groundedSortSizes[retSrt]));
+            }
+          }
+
+          for (unsigned i = first; i <= maxRtSrtSize; i++) {
             static SATLiteralStack satClauseLits;
             satClauseLits.reset();
 
@@ -1464,12 +1679,11 @@ newTotalLabel:
             }
             if (_xmass) {
               unsigned marker_idx = (i == maxRtSrtSize) ? _distinctSortSizes[dRetSrt]-1 : i-1; // use the largest marker for the largest version even if it is smaller than _distinctSortSizes[dsrt]
-              satClauseLits.push(SATLiteral(SATLiteral(marker_offsets[dRetSrt]+marker_idx,1)));
+              satClauseLits.push(SATLiteral(marker(dRetSrt,marker_idx),1));
             } else {
               satClauseLits.push(SATLiteral(totalityMarker_offset+dRetSrt,0));
             }
-            SATClause* satCl = SATClause::fromStack(satClauseLits);
-            addSATClause(satCl);
+            addSATClause(satClauseLits);
           }
           goto newTotalLabel;
         }
@@ -1504,30 +1718,445 @@ SATLiteral FiniteModelBuilder::getSATLiteral(unsigned f, const DArray<unsigned>&
              _sortedSignature->functionSignatures[f] : 
              _sortedSignature->predicateSignatures[f];
 
+  const DArray<unsigned>* sizes = &_sortModelSizes;
+
+  // the grounding may have been given its variable for some earlier sizes
+  Stack<Generation*>::BottomFirstIterator git(_oldGenerations);
+  while(git.hasNext()){
+    Generation* gen = git.next();
+    bool fits = true;
+    for(unsigned i=0;fits && i<grounding.size();i++){
+      fits = grounding[i] <= gen->sortSizes[signature[i]];
+    }
+    if(fits){
+      offset = isFunction ? gen->fOffsets[f] : gen->pOffsets[f];
+      sizes = &gen->sortSizes;
+      break;
+    }
+  }
+
   unsigned var = offset;
   unsigned mult=1;
   for(unsigned i=0;i<grounding.size();i++){
     var += mult*(grounding[i]-1);
     unsigned srt = signature[i];
-    //cout << var << ", " << mult << "," << _sortModelSizes[srt] << endl;
-    mult *= _sortModelSizes[srt];
+    //cout << var << ", " << mult << "," << (*sizes)[srt] << endl;
+    mult *= (*sizes)[srt];
   }
   //cout << "return " << var << endl;
 
   return SATLiteral(var,polarity);
 }
 
-void FiniteModelBuilder::addSATClause(SATClause* cl)
+/**
+ * Pass a clause directly to the SAT solver
+ *
+ * Duplicate literals and tautologies are fine, the solver removes them.
+ */
+void FiniteModelBuilder::addSATClause(const SATLiteralStack& lits)
 {
   CALL("FiniteModelBuilder::addSATClause");
-  cl = Preprocess::removeDuplicateLiterals(cl);
-  if(!cl){ return; }
 #if VTRACE_FMB
-  cout << "ADDING " << cl->toString() << endl; // " of size " << cl->length() << endl;
+  cout << "ADDING";
+  for(unsigned i=0;i<lits.size();i++){
+    cout << " " << lits[i].toString();
+  }
+  cout << endl;
 #endif
 
-  _clausesToBeAdded.push(cl);
+  _solver->addClauseLiterals(lits);
+  _addedClauseCount++;
+}
 
+/**
+ * Collect the variables of f(grounding)=d that are false in every model of the
+ * symmetry ordering and functionality clauses.
+ *
+ * The ordering axioms (for model size m) say that the m-th ordered grounded term
+ * of a sort takes one of the values 1..m, so by functionality it does not take any
+ * larger value. Instance clauses are then simplified with these literals while
+ * they are generated. This is done only when the ordering axioms are unconditional,
+ * i.e. not in the incremental mode where they are guarded by _symmetryMarker.
+ */
+void FiniteModelBuilder::collectSymmetryFalseVars()
+{
+  CALL("FiniteModelBuilder::collectSymmetryFalseVars");
+
+  _symmetryFalseVars.reset();
+  if(_incremental){
+    return;
+  }
+
+  static DArray<unsigned> grounding;
+  for(unsigned s=0;s<_sortedSignature->sorts;s++){
+    unsigned modelSize = _sortModelSizes[s];
+    // functionality is only encoded up to the sort bound
+    unsigned maxValue = min(_sortedSignature->sortBounds[s],modelSize);
+    Stack<GroundedTerm>& groundedTerms = _sortedGroundedTerms[s];
+    for(unsigned m=1;m<=modelSize && m<=groundedTerms.size();m++){
+      GroundedTerm& gt = groundedTerms[m-1];
+      unsigned arity = env.signature->functionArity(gt.f);
+      grounding.ensure(arity+1);
+      for(unsigned i=0;i<arity;i++){
+        grounding[i] = gt.grounding[i];
+      }
+      for(unsigned d=m+1;d<=maxValue;d++){
+        grounding[arity] = d;
+        _symmetryFalseVars.insert(getSATLiteral(gt.f,grounding,true,true).var());
+      }
+    }
+  }
+}
+
+/**
+ * Add the clauses for the current sizes to the SAT solver and solve them
+ * under the assumptions selecting these sizes
+ */
+SATSolver::Status FiniteModelBuilder::encodeAndSolve()
+{
+  CALL("FiniteModelBuilder::encodeAndSolve");
+
+  {
+  TimeCounter tc(TC_FMB_CONSTRAINT_CREATION);
+
+  // the clauses are passed to the SAT solver as they are generated
+  collectSymmetryFalseVars();
+#if VTRACE_FMB
+  cout << "GROUND" << endl;
+#endif
+  if(_freshSolver){
+    addGroundClauses();
+  }
+#if VTRACE_FMB
+  cout << "INSTANCES" << endl;
+#endif
+  addNewInstances();
+#if VTRACE_FMB
+  cout << "FUNC DEFS" << endl;
+#endif
+  addNewFunctionalDefs();
+#if VTRACE_FMB
+  cout << "SYM DEFS" << endl;
+#endif
+  addNewSymmetryAxioms();
+  
+#if VTRACE_FMB
+  cout << "TOTAL DEFS" << endl;
+#endif
+  addNewTotalityDefs();
+
+  }
+
+#if VTRACE_FMB
+  cout << "SOLVING" << endl;
+#endif
+  _freshSolver = false;
+  _groundedSortSizes.initFromArray(_sortModelSizes.size(),_sortModelSizes);
+  _groundedDistinctSortSizes.initFromArray(_distinctSortSizes.size(),_distinctSortSizes);
+
+  SATSolver::Status satResult = SATSolver::UNKNOWN;
+  {
+    env.statistics->phase = Statistics::FMB_SOLVING;
+    TimeCounter tc(TC_FMB_SAT_SOLVING);
+
+    static SATLiteralStack assumptions(_distinctSortSizes.size());
+    assumptions.reset();
+    if (_xmass) {
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(marker(i,_distinctSortSizes[i]-1),0));
+        // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
+      }
+    } else {
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(totalityMarker_offset+i,1));
+      }
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(instancesMarker_offset+i,1));
+      }
+    }
+    if (_incremental) {
+      assumptions.push(SATLiteral(_symmetryMarker,1));
+    }
+
+    satResult = _solver->solveUnderAssumptions(assumptions);
+    env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
+  }
+
+  return satResult;
+}
+
+/**
+ * Compute the nogood on domain sizes from the failed assumptions after
+ * the SAT solver showed the current sizes unsatisfiable (point-wise encoding)
+ */
+void FiniteModelBuilder::computeNogood(Constraint_Generator_Vals& nogood)
+{
+  CALL("FiniteModelBuilder::computeNogood");
+  ASS(!_xmass);
+
+  const SATLiteralStack& failed = _solver->failedAssumptions();
+
+  nogood.ensure(_distinctSortSizes.size());
+
+  for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+    nogood[i] = make_pair(STAR,_distinctSortSizes[i]);
+  }
+
+  for (unsigned i = 0; i < failed.size(); i++) {
+    unsigned var = failed[i].var();
+
+    if (_incremental && var == _symmetryMarker) {
+      continue;
+    }
+    // in the incremental mode the current totality markers may come after the instance markers
+    if (var >= totalityMarker_offset && var < totalityMarker_offset+_distinctSortSizes.size()) { // totality used (-> instances used as well / unless the sort is monotonic)
+      unsigned dsort = var-totalityMarker_offset;
+      if (_sortedSignature->monotonicSorts[dsort]) {
+        nogood[dsort].first = LEQ;
+      } else {
+        nogood[dsort].first = EQ;
+      }
+    } else {
+      ASS_GE(var,instancesMarker_offset);
+      ASS_L(var,instancesMarker_offset+_distinctSortSizes.size());
+      if (nogood[var-instancesMarker_offset].first == STAR) { // instances used (and we don't know yet about totality)
+        ASS(!_sortedSignature->monotonicSorts[var-instancesMarker_offset]);
+        nogood[var-instancesMarker_offset].first = GEQ;
+      }
+    }
+  }
+}
+
+void FiniteModelBuilder::reportTrying()
+{
+  CALL("FiniteModelBuilder::reportTrying");
+
+  if(outputAllowed()) {
+    cout << "TRYING " << "["; 
+    for(unsigned i=0;i<_distinctSortSizes.size();i++){
+      cout << _distinctSortSizes[i];
+      if(i+1 < _distinctSortSizes.size()) cout << ",";
+    }
+    cout << "]" << endl;
+  }
+}
+
+/**
+ * Try several domain size assignments at the same time (point-wise encoding only)
+ *
+ * Each assignment proposed by the enumerator is encoded and solved in a forked
+ * worker with its own SAT solver, see runWorker. The nogoods the workers learn
+ * are passed to the enumerator, which proposes further assignments with the
+ * knowledge of all of them. An assignment is excluded from the enumeration by
+ * an exact nogood as soon as it is handed out to a worker, so that it is not
+ * proposed twice. That exclusion is only justified once the worker reports
+ * 'u'; if a worker dies (time, memory, a signal) before reporting, its
+ * assignment stays unrefuted and the run can no longer end in a refutation.
+ * A worker that cannot represent its literals ('g') gives up the whole run,
+ * as the sequential loop does.
+ *
+ * When a worker finds a model, the others are killed and the model is
+ * recomputed in this process, which then reports it as in the sequential case.
+ */
+MainLoopResult FiniteModelBuilder::runParallel()
+{
+  CALL("FiniteModelBuilder::runParallel");
+  ASS(!_xmass);
+
+  Multiprocessing* mp = Multiprocessing::instance();
+  unsigned maxWorkers = _opt.fmbParallel();
+  unsigned dsorts = _distinctSortSizes.size();
+
+  // the children only write into the pipe, we only read from it
+  SyncPipe results;
+  DHSet<pid_t> workers;
+
+  static Constraint_Generator_Vals nogood;
+  nogood.ensure(dsorts);
+  static DArray<unsigned> reportedSizes;
+  reportedSizes.ensure(dsorts);
+
+  bool haveCandidate = true;
+  // some handed out assignment was neither refuted nor satisfied
+  bool incomplete = false;
+  while(true){
+    while(haveCandidate && workers.size() < maxWorkers){
+      Timer::syncClock();
+      if(env.timeLimitReached()){
+        killWorkers(workers);
+        return MainLoopResult(Statistics::TIME_LIMIT);
+      }
+      reportTrying();
+
+      pid_t pid = mp->fork();
+      if(!pid){
+        runWorker(results);
+        ASSERTION_VIOLATION; // runWorker does not return
+      }
+      workers.insert(pid);
+
+      // the candidate is being tried, do not propose it again
+      for (unsigned i = 0; i < dsorts; i++) {
+        nogood[i] = make_pair(EQ,_distinctSortSizes[i]);
+      }
+      _dsaEnumerator->learnNogood(nogood,estimateInstanceCount());
+      haveCandidate = _dsaEnumerator->increaseModelSizes(_distinctSortSizes,_distinctSortMaxs);
+    }
+
+    if(workers.isEmpty()){
+      // nothing to try and nothing running
+      if (incomplete) {
+        if(outputAllowed()) {
+          cout << "Some domain sizes were not tried to the end" <<endl;
+        }
+        return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+      }
+      if (_dsaEnumerator->isFmbComplete(dsorts)) {
+        Clause* empty = new(0) Clause(0,Unit::AXIOM,
+            new Inference(Inference::MODEL_NOT_FOUND));
+        return MainLoopResult(Statistics::REFUTATION,empty);
+      }
+      if(outputAllowed()) {
+        cout << "Cannot enumerate next child to try in an incomplete setup" <<endl;
+      }
+      return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+    }
+
+    int resValue;
+    pid_t finished = mp->waitForChildTermination(resValue);
+    if(!workers.remove(finished)){
+      continue;
+    }
+    if(resValue!=0){
+      // the worker did not report (it ran out of time or memory), the
+      // exact nogood learnt for its sizes at the fork is not justified
+      incomplete = true;
+      if(!haveCandidate){
+        haveCandidate = _dsaEnumerator->increaseModelSizes(_distinctSortSizes,_distinctSortMaxs);
+      }
+      continue;
+    }
+
+    // every worker that exited normally wrote one report, though not necessarily
+    // in the order of termination, hence the report carries its sizes
+    char status;
+    unsigned weight;
+    results.acquireRead();
+    istream& in = results.in();
+    in >> status >> weight;
+    for (unsigned i = 0; i < dsorts; i++) {
+      in >> reportedSizes[i];
+    }
+    for (unsigned i = 0; i < dsorts; i++) {
+      unsigned sign;
+      in >> sign;
+      nogood[i] = make_pair(static_cast<ConstraintSign>(sign),reportedSizes[i]);
+    }
+    results.releaseRead();
+
+    if(status == 's'){
+      killWorkers(workers);
+
+      _distinctSortSizes.initFromArray(dsorts,reportedSizes);
+      for(unsigned s=0;s<_sortedSignature->sorts;s++) {
+        _sortModelSizes[s] = _distinctSortSizes[_sortedSignature->parents[s]];
+      }
+      if(!reset()){
+        return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+      }
+      ALWAYS(encodeAndSolve() == SATSolver::SATISFIABLE);
+      onModelFound();
+      return MainLoopResult(Statistics::SATISFIABLE);
+    }
+    if(status == 'u'){
+#if VTRACE_DOMAINS
+      cout << "Learned a nogood: ";
+      output_cg(nogood);
+      cout << " of weight " << weight << endl;
+#endif
+      _dsaEnumerator->learnNogood(nogood,weight);
+    }
+    else {
+      ASS_EQ(status,'g');
+      killWorkers(workers);
+      if(outputAllowed()){
+        cout << "Cannot represent all propositional literals internally" <<endl;
+      }
+      return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+    }
+
+    if(!haveCandidate){
+      haveCandidate = _dsaEnumerator->increaseModelSizes(_distinctSortSizes,_distinctSortMaxs);
+    }
+  }
+}
+
+/**
+ * Encode and solve the current sizes in a forked worker of runParallel and
+ * report the result into @b results, then exit
+ *
+ * The report is a line with the status ('s' for a model, 'u' for no model,
+ * 'g' for giving up), the weight of the nogood, the sizes and the signs of
+ * the nogood.
+ */
+void FiniteModelBuilder::runWorker(SyncPipe& results)
+{
+  CALL("FiniteModelBuilder::runWorker");
+
+  System::registerForSIGHUPOnParentDeath();
+  results.neverRead();
+
+  unsigned dsorts = _distinctSortSizes.size();
+  static Constraint_Generator_Vals nogood;
+  nogood.ensure(dsorts);
+  for (unsigned i = 0; i < dsorts; i++) {
+    nogood[i] = make_pair(STAR,_distinctSortSizes[i]);
+  }
+  for(unsigned s=0;s<_sortedSignature->sorts;s++) {
+    _sortModelSizes[s] = _distinctSortSizes[_sortedSignature->parents[s]];
+  }
+
+  char status = 'g';
+  unsigned weight = 0;
+  if(reset()){
+    if(encodeAndSolve() == SATSolver::SATISFIABLE){
+      status = 's';
+    }
+    else {
+      status = 'u';
+      weight = _addedClauseCount;
+      computeNogood(nogood);
+    }
+  }
+
+  results.acquireWrite();
+  ostream& out = results.out();
+  out << status << ' ' << weight;
+  for (unsigned i = 0; i < dsorts; i++) {
+    out << ' ' << _distinctSortSizes[i];
+  }
+  for (unsigned i = 0; i < dsorts; i++) {
+    out << ' ' << static_cast<unsigned>(nogood[i].first);
+  }
+  out << endl;
+  results.releaseWrite();
+
+  exit(0);
+}
+
+void FiniteModelBuilder::killWorkers(DHSet<pid_t>& workers)
+{
+  CALL("FiniteModelBuilder::killWorkers");
+
+  Multiprocessing* mp = Multiprocessing::instance();
+  DHSet<pid_t>::Iterator it(workers);
+  while(it.hasNext()){
+    pid_t pid = it.next();
+    int resValue;
+    mp->killNoCheck(pid,SIGKILL);
+    mp->waitForParticularChildTermination(pid,resValue);
+  }
+  workers.reset();
 }
 
 MainLoopResult FiniteModelBuilder::runImpl()
@@ -1580,81 +2209,17 @@ MainLoopResult FiniteModelBuilder::runImpl()
     }
   }
 
+  if (!_xmass && _opt.fmbParallel() > 1) {
+    return runParallel();
+  }
+
   if (reset()) {
   while(true){
-    if(outputAllowed()) {
-      cout << "TRYING " << "["; 
-      for(unsigned i=0;i<_distinctSortSizes.size();i++){
-        cout << _distinctSortSizes[i];
-        if(i+1 < _distinctSortSizes.size()) cout << ",";
-      }
-      cout << "]" << endl;
-    }
+    reportTrying();
     Timer::syncClock();
     if(env.timeLimitReached()){ return MainLoopResult(Statistics::TIME_LIMIT); }
 
-    {
-    TimeCounter tc(TC_FMB_CONSTRAINT_CREATION);
-
-    // add the new clauses to _clausesToBeAdded
-#if VTRACE_FMB
-    cout << "GROUND" << endl;
-#endif
-    addGroundClauses();
-#if VTRACE_FMB
-    cout << "INSTANCES" << endl;
-#endif
-    addNewInstances();
-#if VTRACE_FMB
-    cout << "FUNC DEFS" << endl;
-#endif
-    addNewFunctionalDefs();
-#if VTRACE_FMB
-    cout << "SYM DEFS" << endl;
-#endif
-    addNewSymmetryAxioms();
-    
-#if VTRACE_FMB
-    cout << "TOTAL DEFS" << endl;
-#endif
-    addNewTotalityDefs();
-
-    }
-
-#if VTRACE_FMB
-    cout << "SOLVING" << endl;
-#endif
-    //TODO consider adding clauses directly to SAT solver in new interface?
-    // pass clauses and assumption to SAT Solver
-    {
-      TimeCounter tc(TC_FMB_SAT_SOLVING);
-      _solver->addClausesIter(pvi(SATClauseStack::ConstIterator(_clausesToBeAdded)));
-    }
-
-    SATSolver::Status satResult = SATSolver::UNKNOWN;
-    {
-      env.statistics->phase = Statistics::FMB_SOLVING;
-      TimeCounter tc(TC_FMB_SAT_SOLVING);
-
-      static SATLiteralStack assumptions(_distinctSortSizes.size());
-      assumptions.reset();
-      if (_xmass) {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
-          // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
-        }
-      } else {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(totalityMarker_offset+i,1));
-        }
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(instancesMarker_offset+i,1));
-        }
-      }
-
-      satResult = _solver->solveUnderAssumptions(assumptions);
-      env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
-    }
+    SATSolver::Status satResult = encodeAndSolve();
 
     // if the clauses are satisfiable then we have found a finite model
     if(satResult == SATSolver::SATISFIABLE){
@@ -1664,16 +2229,7 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
     static unsigned numberOfSatCalls = 0;
     numberOfSatCalls++;
-    unsigned clauseSetSize = _clausesToBeAdded.size();
-    unsigned weight = clauseSetSize;
-
-    // destroy the clauses
-    SATClauseStack::Iterator it(_clausesToBeAdded);
-    while (it.hasNext()) {
-      it.next()->destroy();
-    }
-    // but the container needs to be empty for the next round in any case
-    _clausesToBeAdded.reset();
+    unsigned weight = _addedClauseCount;
 
     {
       // _solver->explicitlyMinimizedFailedAssumptions(false,true); // TODO: try adding this in
@@ -1689,6 +2245,10 @@ MainLoopResult FiniteModelBuilder::runImpl()
         for (unsigned i = 0; i < failed.size(); i++) {
           unsigned var = failed[i].var();
 
+          if (_incremental && var == _symmetryMarker) {
+            continue;
+          }
+
           unsigned srt = which_sort(var);
 
           // cout << "which_sort(var) = " << srt << endl;
@@ -1759,29 +2319,7 @@ MainLoopResult FiniteModelBuilder::runImpl()
         }
       } else { // i.e. (!_xmass)
         static Constraint_Generator_Vals nogood;
-
-        nogood.ensure(_distinctSortSizes.size());
-
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          nogood[i] = make_pair(STAR,_distinctSortSizes[i]);
-        }
-
-        for (unsigned i = 0; i < failed.size(); i++) {
-          unsigned var = failed[i].var();
-          ASS_GE(var,totalityMarker_offset);
-
-          if (var < instancesMarker_offset) { // totality used (-> instances used as well / unless the sort is monotonic)
-            unsigned dsort = var-totalityMarker_offset;
-            if (_sortedSignature->monotonicSorts[dsort]) {
-              nogood[dsort].first = LEQ;
-            } else {
-              nogood[dsort].first = EQ;
-            }
-          } else if (nogood[var-instancesMarker_offset].first == STAR) { // instances used (and we don't know yet about totality)
-            ASS(!_sortedSignature->monotonicSorts[var-instancesMarker_offset]);
-            nogood[var-instancesMarker_offset].first = GEQ;
-          }
-        }
+        computeNogood(nogood);
 
 #if VTRACE_DOMAINS
         cout << "Learned a nogood: ";
@@ -1810,7 +2348,7 @@ MainLoopResult FiniteModelBuilder::runImpl()
       }
     }
 
-    if(!reset()){
+    if(!(canExtend() ? extend() : reset())){
       break;
     }
   }
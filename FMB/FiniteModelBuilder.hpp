@@ -24,6 +24,8 @@
 #ifndef __FiniteModelBuilder__
 #define __FiniteModelBuilder__
 
+#include <sys/types.h>
+
 #include "Forwards.hpp"
 
 #if VZ3
@@ -36,6 +38,7 @@
 #include "Lib/ScopedPtr.hpp"
 #include "SortInference.hpp"
 #include "Lib/BinaryHeap.hpp"
+#include "Lib/DHSet.hpp"
 
 namespace FMB {
 using namespace Lib;
@@ -84,6 +87,17 @@ private:
   // Creates the model output
   void onModelFound();
 
+  // Prints the sizes about to be tried
+  void reportTrying();
+  // Adds the clauses for the current sizes and runs the SAT solver on them
+  SATSolver::Status encodeAndSolve();
+
+  // Tries several size assignments at the same time in forked workers (see fmb_parallel)
+  MainLoopResult runParallel();
+  // Body of such a worker, reports the result into the pipe and exits
+  void runWorker(Lib::Sys::SyncPipe& results);
+  void killWorkers(DHSet<pid_t>& workers);
+
   // Adds constraints from ground clauses (same constraints for each model size)
   void addGroundClauses();
   // Adds constraints from grounding the non-ground clauses
@@ -132,15 +146,55 @@ private:
 
   // resets all structures and SAT solver using _sortModelSizes 
   bool reset();
+  // keeps the SAT solver and allocates variables only for groundings that are new in _sortModelSizes
+  bool extend();
+  // can the current encoding be extended to _sortModelSizes (see _incremental)
+  bool canExtend();
+  // allocate SAT variables for all symbols, starting from offsets
+  bool allocateSymbolVariables(unsigned& offsets);
+  // allocate the xmass markers missing for _distinctSortSizes, starting from offsets
+  bool allocateMarkers(unsigned& offsets);
 
   // make the symmetry orderings
   void createSymmetryOrdering();
   // The per-sort ordering of grounded terms used for symmetry breaking
   DArray<Stack<GroundedTerm>> _sortedGroundedTerms;
 
-  // SAT solver used to solve constraints (a new one is used for each model size)
+  // SAT solver used to solve constraints (a new one is used for each model size unless _incremental)
+  // Clauses are passed to it directly as literal stacks, see addSATClause
   ScopedPtr<SATSolverWithAssumptions> _solver;
 
+  // In the incremental mode the SAT solver is kept when the sizes grow. Clauses that hold
+  // in every larger model (instances, functionality, ground clauses) are added only for
+  // the groundings that are new, while totality and symmetry clauses are guarded by markers
+  // assumed only for the current sizes.
+  bool _incremental;
+  // true until the first sizes encoded by the current SAT solver are passed to it
+  bool _freshSolver;
+  // the sizes (and distinct sizes) whose groundings are already in the SAT solver (zeros for a fresh solver)
+  DArray<unsigned> _groundedSortSizes;
+  DArray<unsigned> _groundedDistinctSortSizes;
+  // the first SAT variable not yet allocated
+  unsigned _nextVar;
+  // the marker guarding symmetry clauses of the current sizes (only if _incremental)
+  unsigned _symmetryMarker;
+
+  /**
+   * Variable allocation for sizes encoded earlier by the same SAT solver
+   *
+   * A grounding keeps the variable of the oldest generation whose sizes it fits into.
+   */
+  struct Generation {
+    CLASS_NAME(FiniteModelBuilder::Generation);
+    USE_ALLOCATOR(FiniteModelBuilder::Generation);
+
+    DArray<unsigned> sortSizes;
+    DArray<unsigned> fOffsets;
+    DArray<unsigned> pOffsets;
+  };
+  Stack<Generation*> _oldGenerations;
+  void destroyOldGenerations();
+
   // Structures to record symbols removed during preprocessing i.e. via definition elimination
   // These are ignored throughout finite model building and then the definitions (recorded here)
   // are used to give the interpretation of the function/predicate if a model is found
@@ -152,17 +206,24 @@ private:
   DArray<unsigned> del_f;
   DArray<unsigned> del_p;
 
-  // Add a SATClause to the SAT solver
-  void addSATClause(SATClause* cl);
-  // Add a singleton SATClause in the form of a SATLiteral to the SAT solver
+  // Add a clause given by its literals to the SAT solver (without creating a SATClause)
+  void addSATClause(const SATLiteralStack& lits);
+  // Add a singleton clause in the form of a SATLiteral to the SAT solver
   void addSATClause(SATLiteral lit){
     static SATLiteralStack satClauseLits;
     satClauseLits.reset();
     satClauseLits.push(lit);
-    addSATClause(SATClause::fromStack(satClauseLits));
+    addSATClause(satClauseLits);
   }
-  // SAT clauses to be added. We record them so we can delete them after calling the SAT solver
-  SATClauseStack _clausesToBeAdded;
+  // number of clauses passed to the current SAT solver (an estimate of the encoding size)
+  unsigned _addedClauseCount;
+
+  // collect into _symmetryFalseVars the function variables false by the symmetry ordering
+  void collectSymmetryFalseVars();
+  // Variables of f(grounding)=d that the (unguarded) symmetry ordering and functionality
+  // make false, i.e. for the i-th ordered grounded term of a sort with d > i.
+  // Instances containing such a negative literal are satisfied and not generated.
+  DHSet<unsigned> _symmetryFalseVars;
 
   // The inferred signature of sorts (see SortInference.hpp)
   SortedSignature* _sortedSignature;
@@ -188,9 +249,15 @@ private:
   // if (_xmass) {
 
   /* Each distinctSort has as many markers as is its current size.
-   * Their offsets are stored on per sort basis.
+   * Their variables are stored on per sort basis.
    */
-  DArray<unsigned> marker_offsets;
+  DArray<Stack<unsigned>> _markerVars;
+  // the distinct sort of each marker variable
+  DHMap<unsigned,unsigned> _markerSorts;
+
+  unsigned marker(unsigned dsort, unsigned idx) {
+    return _markerVars[dsort][idx];
+  }
 
   // } else {
 
@@ -206,19 +273,10 @@ private:
   // }
 
   /**
-   * use marker_offsets to figure out to which sort does a variable belong
+   * figure out to which sort does a marker variable belong
    */
   unsigned which_sort(unsigned var) {
-    ASS_GE(var,marker_offsets[0]);
-    unsigned j;
-    for (j = 0; j < _distinctSortSizes.size()-1; j++) {
-      if (var < marker_offsets[j+1]) {
-        return j;
-      }
-    }
-    ASS_EQ(j,_distinctSortSizes.size()-1);
-    ASS_GE(var,_distinctSortSizes[j]);
-    return j;
+    return _markerSorts.get(var);
   }
 
   /** Parameters to the FBM saturation **/
@@ -258,6 +316,9 @@ private:
 
   DSAEnumerator* _dsaEnumerator;
 
+  // Computes the nogood on the current sizes from the failed assumptions of an unsatisfiable call
+  void computeNogood(Constraint_Generator_Vals& nogood);
+
   class HackyDSAE : public DSAEnumerator {
     struct Constraint_Generator {
       CLASS_NAME(FiniteModedlBuilder::HackyDSAE::Constraint_Generator);
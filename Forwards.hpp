@@ -156,6 +156,7 @@ class V2CIndex;
 
 class Sorts;
 class Signature;
+class Theory;
 
 typedef VirtualIterator<Var> VarIterator;
 typedef RCPtr<Constraint> ConstraintRCPtr;
@@ -322,6 +323,7 @@ class ActiveClauseContainer;
 
 class Limits;
 class Splitter;
+class ClauseSharing;
 class ConsequenceFinder;
 class LabelFinder;
 class SymElOutput;
@@ -351,6 +353,8 @@ namespace SAT
 using namespace Lib;
 
 class SATClause;
+class SATClauseArena;
+class SATClauseExchange;
 class SATLiteral;
 class SATInference;
 
@@ -522,6 +522,32 @@ unsigned HashingClauseVariantIndex::computeHashAndCountVariables(Literal* l, Var
   return hash;
 }
 
+/**
+ * Return true if the literals @c lits sorted by @c litOrder are in an order
+ * that doesn't depend on the names of variables, so that numbering variables
+ * by their first occurrence gives the same numbers for all variants.
+ *
+ * This fails when two literals are equal up to variables, or when the
+ * two sides of a non-ground equality are.
+ */
+bool HashingClauseVariantIndex::isCanonicalOrder(Literal* const * lits, Stack<unsigned>& litOrder)
+{
+  CALL("HashingClauseVariantIndex::isCanonicalOrder");
+
+  unsigned length = litOrder.size();
+  for(unsigned i=0; i<length; i++) {
+    Literal* l = lits[litOrder[i]];
+    if (i>0 && VariableIgnoringComparator::compare(lits[litOrder[i-1]],l) == EQUAL) {
+      return false;
+    }
+    if (l->isEquality() && !l->ground() &&
+        VariableIgnoringComparator::compare(l->nthArgument(0),l->nthArgument(1)) == EQUAL) {
+      return false;
+    }
+  }
+  return true;
+}
+
 unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned length)
 {
   CALL("HashingClauseVariantIndex::computeHash");
@@ -538,6 +564,8 @@ unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned
 
   static VarCounts varCnts;
   varCnts.reset();
+  _varNumbers.reset();
+  _numberVariables = isCanonicalOrder(lits, litOrder);
 
   unsigned hash = 2166136261u;
   for(unsigned i=0; i<length; i++) {
@@ -545,7 +573,7 @@ unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned
     hash = computeHashAndCountVariables(lits[li],varCnts,hash);
   }
 
-  if (varCnts.size() > 0) {
+  if (varCnts.size() > 0 && !_numberVariables) {
     static Stack<unsigned char> varCntHistogram;
     varCntHistogram.reset();
     VarCounts::Iterator it(varCnts);
@@ -30,6 +30,7 @@
 #include "Lib/Array.hpp"
 #include "Lib/List.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
 
 namespace Indexing {
 
@@ -82,12 +83,22 @@ private:
   ClauseList* _emptyClauses;
 };
 
+/**
+ * Clause variant index based on a hash that is invariant under
+ * variable renaming.
+ *
+ * Literals are hashed in an order that ignores variables. When this order
+ * is strict, variables are hashed by the order of their first occurrence,
+ * so that the clauses in a bucket are mostly variants of each other.
+ * Otherwise (e.g. for p(X,Y) | p(Y,X)) variables are only counted.
+ */
 class HashingClauseVariantIndex : public ClauseVariantIndex
 {
 public:
   CLASS_NAME(HashingClauseVariantIndex);
   USE_ALLOCATOR(HashingClauseVariantIndex);
 
+  HashingClauseVariantIndex() : _numberVariables(false) {}
   virtual ~HashingClauseVariantIndex();
 
   virtual void insert(Clause* cl) override;
@@ -106,7 +117,7 @@ private:
   }
 
   unsigned computeHashAndCountVariables(unsigned var, VarCounts& varCnts, unsigned hash_begin) {
-    const unsigned varHash = 1u;
+    unsigned varHash = 1u;
 
     unsigned char* pcnt;
     if (varCnts.getValuePtr(var,pcnt)) {
@@ -115,6 +126,14 @@ private:
       (*pcnt)++;
     }
 
+    if (_numberVariables) {
+      unsigned* pnum;
+      if (_varNumbers.getValuePtr(var,pnum)) {
+        *pnum = _varNumbers.size()+1; // 1 is taken by unnumbered variables
+      }
+      varHash = *pnum;
+    }
+
     // cout << "will hash variable" << endl;
 
     return Hash::hash((const unsigned char*)&varHash,sizeof(varHash),hash_begin);
@@ -124,8 +143,13 @@ private:
   unsigned computeHashAndCountVariables(Literal* l, VarCounts& varCnts, unsigned hash_begin);
 
   unsigned computeHash(Literal* const * lits, unsigned length);
+  bool isCanonicalOrder(Literal* const * lits, Stack<unsigned>& litOrder);
 
   DHMap<unsigned, ClauseList*> _entries;
+
+  /** Hash variables by the order of their first occurrence (during computeHash) */
+  bool _numberVariables;
+  DHMap<unsigned, unsigned> _varNumbers;
 };
 
 };// namespace Indexing
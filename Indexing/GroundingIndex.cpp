@@ -32,6 +32,7 @@
 
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -47,6 +48,9 @@ GroundingIndex::GroundingIndex(const Options& opt)
     case Options::SatSolver::VAMPIRE:
     	_solver = new TWLSolver(opt,true);
     	break;
+    case Options::SatSolver::LINGELING:
+      _solver = new LingelingInterfacing(opt,true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       //cout << "Warning, Z3 not curently used for Global Subsumption" << endl; 
@@ -73,6 +73,47 @@ TermSharing::~TermSharing()
 #endif
 }
 
+/**
+ * Remove the terms whose function symbol has number @b functions or higher
+ * and the literals whose predicate has number @b predicates or higher.
+ *
+ * To be called when these symbols are removed from the signature (see
+ * Signature::rollback()), so that the terms are not taken for terms over
+ * the symbols added later under the same numbers. Terms containing the
+ * removed terms as proper subterms need not be removed, they are never
+ * found again.
+ */
+void TermSharing::removeSymbolsFrom(unsigned functions, unsigned predicates)
+{
+  CALL("TermSharing::removeSymbolsFrom");
+
+  Stack<Term*> terms;
+  Set<Term*,TermSharing>::Iterator ts(_terms);
+  while (ts.hasNext()) {
+    Term* t = ts.next();
+    if (t->functor() >= functions) {
+      terms.push(t);
+    }
+  }
+  while (terms.isNonEmpty()) {
+    ALWAYS(_terms.remove(terms.pop()));
+    _totalTerms--;
+  }
+
+  Stack<Literal*> literals;
+  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  while (ls.hasNext()) {
+    Literal* l = ls.next();
+    if (l->functor() >= predicates) {
+      literals.push(l);
+    }
+  }
+  while (literals.isNonEmpty()) {
+    ALWAYS(_literals.remove(literals.pop()));
+    _totalLiterals--;
+  }
+} // TermSharing::removeSymbolsFrom
+
 /**
  * Insert a new term in the index and return the result.
  * @since 28/12/2007 Manchester
@@ -53,6 +53,8 @@ public:
 
   Literal* tryGetOpposite(Literal* l);
 
+  void removeSymbolsFrom(unsigned functions, unsigned predicates);
+
   /** The hash function of this literal */
   inline static unsigned hash(const Literal* l)
   { return l->hash(); }
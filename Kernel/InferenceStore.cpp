@@ -31,6 +31,7 @@
 #include "Lib/StringUtils.hpp"
 #include "Lib/Sort.hpp"
 
+#include "Shell/BufferedPrinter.hpp"
 #include "Shell/LaTeX.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
@@ -271,7 +272,7 @@ struct InferenceStore::ProofPrinter
   USE_ALLOCATOR(InferenceStore::ProofPrinter);
   
   ProofPrinter(ostream& out, InferenceStore* is)
-  : _is(is), out(out)
+  : _is(is), out(out), bout(out)
   {
     CALL("InferenceStore::ProofPrinter::ProofPrinter");
 
@@ -299,6 +300,7 @@ struct InferenceStore::ProofPrinter
       handleStep(cs);
     }
     if(delayPrinting) printDelayed();
+    bout.flush();
   }
 
 protected:
@@ -328,64 +330,65 @@ protected:
       env.statistics->inductionInProof++;
     }
 
-    out << _is->getUnitIdStr(cs) << ". ";
+    bout << cs->number() << ". ";
     if (cs->isClause()) {
       Clause* cl=cs->asClause();
 
       if (env.colorUsed) {
-        out << " C" << cl->color() << " ";
+        bout << " C" << static_cast<unsigned>(cl->color()) << " ";
       }
 
-      out << cl->literalsOnlyToString() << " ";
+      bout.printClauseLiterals(cl);
+      bout << ' ';
       if (cl->splits() && !cl->splits()->isEmpty()) {
-        out << "<- {" << cl->splits()->toString() << "} ";
+        bout << "<- {" << cl->splits()->toString() << "} ";
       }
       if(proofExtra){
-        out << "("<<cl->age()<<':'<<cl->weight();
+        bout << "("<<cl->age()<<':'<<cl->weight();
         if (cl->numSelected()>0) {
-          out<< ':'<< cl->numSelected();
+          bout<< ':'<< cl->numSelected();
         }
-        out<<") ";
+        bout<<") ";
       }
       if(cl->isTheoryDescendant()){
-        out << "(TD) ";
+        bout << "(TD) ";
       }
       if(cl->inductionDepth()>0){
-        out << "(I " << cl->inductionDepth() << ") ";
+        bout << "(I " << cl->inductionDepth() << ") ";
       }
     }
     else {
       FormulaUnit* fu=static_cast<FormulaUnit*>(cs);
       if (env.colorUsed && fu->inheritedColor() != COLOR_INVALID) {
-        out << " IC" << fu->inheritedColor() << " ";
+        bout << " IC" << static_cast<unsigned>(fu->inheritedColor()) << " ";
       }
-      out << fu->formula()->toString() << ' ';
+      bout << fu->formula()->toString() << ' ';
     }
 
-    out <<"["<<Inference::ruleName(rule);
+    bout <<"["<<Inference::ruleName(rule);
 
     if (outputAxiomNames && rule==Inference::INPUT) {
       ASS(!parents.hasNext()); //input clauses don't have parents
       vstring name;
       if (Parse::TPTP::findAxiomName(cs, name)) {
-	out << " " << name;
+	bout << " " << name;
       }
     }
 
     bool first=true;
     while(parents.hasNext()) {
       Unit* prem=parents.next();
-      out << (first ? ' ' : ',');
-      out << _is->getUnitIdStr(prem);
+      bout << (first ? ' ' : ',');
+      bout << prem->number();
       first=false;
     }
 
     // print Extra
     vstring extra = cs->inference()->extra(); 
     if(extra != ""){
-      out << ", " << extra;
+      bout << ", " << extra;
     }
-    out << "]" << endl;
+    bout << "]\n";
   }
 
   void handleStep(Unit* cs)
@@ -428,6 +431,8 @@ protected:
 
   InferenceStore* _is;
   ostream& out;
+  /** Used by the default @b printStep, written into @b out at the end of @b print() */
+  BufferedPrinter bout;
 
   bool outputAxiomNames;
   bool delayPrinting;
@@ -21,6 +21,7 @@
  * Implements class Signature for handling signatures
  */
 
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Shell/Options.hpp"
@@ -245,6 +246,161 @@ Signature::~Signature ()
   }
 } // Signature::~Signature
 
+Signature::Checkpoint::~Checkpoint()
+{
+  CALL("Signature::Checkpoint::~Checkpoint");
+
+  while(_funs.isNonEmpty()) {
+    delete _funs.pop();
+  }
+  while(_preds.isNonEmpty()) {
+    delete _preds.pop();
+  }
+}
+
+/**
+ * Save the current state of the signature into @b cp
+ */
+void Signature::checkpoint(Checkpoint& cp) const
+{
+  CALL("Signature::checkpoint");
+  ASS(cp._funs.isEmpty());
+  ASS(cp._preds.isEmpty());
+
+  for (unsigned i = 0; i < _funs.length(); i++) {
+    cp._funs.push(new Symbol(*_funs[i]));
+  }
+  for (unsigned i = 0; i < _preds.length(); i++) {
+    cp._preds.push(new Symbol(*_preds[i]));
+  }
+  cp._nextFreshSymbolNumber = _nextFreshSymbolNumber;
+  cp._skolemFunctionCount = _skolemFunctionCount;
+  cp._foolConstantsDefined = _foolConstantsDefined;
+  cp._foolTrue = _foolTrue;
+  cp._foolFalse = _foolFalse;
+  cp._distinctGroupsAddedTo = _distinctGroupsAddedTo;
+  for (unsigned i = 0; i < _distinctGroupMembers.length(); i++) {
+    cp._distinctGroupSizes.push(_distinctGroupMembers[i]->length());
+  }
+  cp._dividesNvalues = _dividesNvalues.length();
+  cp._strings = _strings;
+  cp._integers = _integers;
+  cp._rationals = _rationals;
+  cp._reals = _reals;
+  DHMap<unsigned, TermAlgebra*>::Iterator tait(_termAlgebras);
+  while (tait.hasNext()) {
+    cp._termAlgebraSorts.push(tait.nextKey());
+  }
+} // Signature::checkpoint
+
+/**
+ * Return the signature to the state saved in @b cp: remove the symbols and
+ * distinct groups added since then and restore the properties of the older
+ * symbols. Terms over the removed symbols must not be used any more (see
+ * TermSharing::removeSymbolsFrom()).
+ */
+void Signature::rollback(const Checkpoint& cp)
+{
+  CALL("Signature::rollback");
+  ASS_GE(_funs.length(), cp._funs.length());
+  ASS_GE(_preds.length(), cp._preds.length());
+
+  removeNamesFrom(_funNames, cp._funs.length());
+  removeNamesFrom(_predNames, cp._preds.length());
+
+  Stack<Theory::MonomorphisedInterpretation> interpretations;
+  DHMap<Theory::MonomorphisedInterpretation, unsigned>::Iterator iit(_iSymbols);
+  while (iit.hasNext()) {
+    Theory::MonomorphisedInterpretation mi;
+    unsigned number;
+    iit.next(mi, number);
+    if (number >= (Theory::isFunction(mi.first) ? cp._funs.length() : cp._preds.length())) {
+      interpretations.push(mi);
+    }
+  }
+  while (interpretations.isNonEmpty()) {
+    ALWAYS(_iSymbols.remove(interpretations.pop()));
+  }
+
+  while (_funs.length() > cp._funs.length()) {
+    Symbol* sym = _funs.pop();
+    _arityCheck.remove(sym->name());
+    sym->destroyFnSymbol();
+  }
+  while (_preds.length() > cp._preds.length()) {
+    Symbol* sym = _preds.pop();
+    _arityCheck.remove(sym->name());
+    sym->destroyPredSymbol();
+  }
+  for (unsigned i = 0; i < _funs.length(); i++) {
+    *_funs[i] = *cp._funs[i];
+  }
+  for (unsigned i = 0; i < _preds.length(); i++) {
+    *_preds[i] = *cp._preds[i];
+  }
+
+  while (_distinctGroupPremises.length() > cp._distinctGroupSizes.length()) {
+    _distinctGroupPremises.pop();
+    delete _distinctGroupMembers.pop();
+  }
+  for (unsigned i = 0; i < _distinctGroupMembers.length(); i++) {
+    _distinctGroupMembers[i]->truncate(cp._distinctGroupSizes[i]);
+  }
+  _dividesNvalues.truncate(cp._dividesNvalues);
+
+  // term algebras declared since then, including the ones of tuple sorts
+  // which Theory::Tuples creates on demand
+  DHSet<unsigned> oldAlgebras;
+  oldAlgebras.loadFromIterator(Stack<unsigned>::ConstIterator(cp._termAlgebraSorts));
+  Stack<unsigned> newAlgebras;
+  DHMap<unsigned, TermAlgebra*>::Iterator tait(_termAlgebras);
+  while (tait.hasNext()) {
+    unsigned sort = tait.nextKey();
+    if (!oldAlgebras.contains(sort)) {
+      newAlgebras.push(sort);
+    }
+  }
+  while (newAlgebras.isNonEmpty()) {
+    TermAlgebra* ta;
+    ALWAYS(_termAlgebras.pop(newAlgebras.pop(), ta));
+    delete ta;
+  }
+  theory->forgetFunctionsFrom(cp._funs.length());
+
+  _nextFreshSymbolNumber = cp._nextFreshSymbolNumber;
+  _skolemFunctionCount = cp._skolemFunctionCount;
+  _foolConstantsDefined = cp._foolConstantsDefined;
+  _foolTrue = cp._foolTrue;
+  _foolFalse = cp._foolFalse;
+  _distinctGroupsAddedTo = cp._distinctGroupsAddedTo;
+  _strings = cp._strings;
+  _integers = cp._integers;
+  _rationals = cp._rationals;
+  _reals = cp._reals;
+} // Signature::rollback
+
+/**
+ * Remove from @b names the names of symbols with numbers @b number and higher
+ */
+void Signature::removeNamesFrom(SymbolMap& names, unsigned number)
+{
+  CALL("Signature::removeNamesFrom");
+
+  Stack<vstring> removed;
+  SymbolMap::Iterator it(names);
+  while (it.hasNext()) {
+    vstring name;
+    unsigned symbol;
+    it.next(name, symbol);
+    if (symbol >= number) {
+      removed.push(name);
+    }
+  }
+  while (removed.isNonEmpty()) {
+    ALWAYS(names.remove(removed.pop()));
+  }
+} // Signature::removeNamesFrom
+
 /**
  * Add an integer constant to the signature. If defaultSort is true, treat it as
  * a term of the default sort, otherwise as an interepreted integer value.
@@ -456,12 +456,59 @@ class Signature
     return (p == 0); // see the ASSERT in Signature::Signature
   }
 
+  /**
+   * State of the signature saved by checkpoint(), to which rollback()
+   * returns the signature
+   */
+  class Checkpoint
+  {
+  public:
+    CLASS_NAME(Signature::Checkpoint);
+    USE_ALLOCATOR(Checkpoint);
+
+    Checkpoint() {}
+    ~Checkpoint();
+
+    /** number of function symbols at the checkpoint */
+    unsigned functions() const { return _funs.length(); }
+    /** number of predicate symbols at the checkpoint */
+    unsigned predicates() const { return _preds.length(); }
+  private:
+    Checkpoint(const Checkpoint&);
+    Checkpoint& operator=(const Checkpoint&);
+
+    friend class Signature;
+
+    /** copies of the function symbols existing at the checkpoint */
+    Stack<Symbol*> _funs;
+    /** copies of the predicate symbols existing at the checkpoint */
+    Stack<Symbol*> _preds;
+    int _nextFreshSymbolNumber;
+    unsigned _skolemFunctionCount;
+    bool _foolConstantsDefined;
+    unsigned _foolTrue;
+    unsigned _foolFalse;
+    bool _distinctGroupsAddedTo;
+    /** number of members of each distinct group */
+    Stack<unsigned> _distinctGroupSizes;
+    unsigned _dividesNvalues;
+    unsigned _strings;
+    unsigned _integers;
+    unsigned _rationals;
+    unsigned _reals;
+    /** sorts of the term algebras existing at the checkpoint */
+    Stack<unsigned> _termAlgebraSorts;
+  };
+
   Signature();
   ~Signature();
 
   CLASS_NAME(Signature);
   USE_ALLOCATOR(Signature);
 
+  void checkpoint(Checkpoint& cp) const;
+  void rollback(const Checkpoint& cp);
+
   bool functionExists(const vstring& name,unsigned arity) const;
   bool predicateExists(const vstring& name,unsigned arity) const;
 
@@ -525,6 +572,7 @@ private:
   unsigned _foolTrue;
   unsigned _foolFalse;
 
+  static void removeNamesFrom(SymbolMap& names, unsigned number);
   static bool isProtectedName(vstring name);
   static bool charNeedsQuoting(char c, bool first);
   /** Stack of function symbols */
@@ -73,6 +73,34 @@ Sorts::~Sorts()
   }
 } // Sorts::~Sorts
 
+/**
+ * Remove the sorts with numbers @b count and higher, @b hasSort is the
+ * value hasSort() had when there were @b count sorts
+ */
+void Sorts::rollback(unsigned count, bool hasSort)
+{
+  CALL("Sorts::rollback");
+  ASS_GE(_sorts.length(), count);
+
+  Stack<vstring> removed;
+  SymbolMap::Iterator it(_sortNames);
+  while (it.hasNext()) {
+    vstring name;
+    unsigned sort;
+    it.next(name, sort);
+    if (sort >= count) {
+      removed.push(name);
+    }
+  }
+  while (removed.isNonEmpty()) {
+    ALWAYS(_sortNames.remove(removed.pop()));
+  }
+  while (_sorts.length() > count) {
+    delete _sorts.pop();
+  }
+  _hasSort = hasSort;
+} // Sorts::rollback
+
 /**
  * Add a new or existing sort and return its number.
  * @author Andrei Voronkov
@@ -199,6 +199,8 @@ public:
   /** true if there is a sort different from built-ins */
   bool hasSort() const {return _hasSort;}
 
+  void rollback(unsigned count, bool hasSort);
+
 private:
   SymbolMap _sortNames;
   Stack<SortInfo*> _sorts;
@@ -1073,6 +1073,29 @@ unsigned Theory::getArrayExtSkolemFunction(unsigned sort) {
   return skolemFunction; 
 }
 
+/**
+ * Forget the cached function symbols with numbers @b number and higher,
+ * which are being removed by Signature::rollback
+ */
+void Theory::forgetFunctionsFrom(unsigned number)
+{
+  CALL("Theory::forgetFunctionsFrom");
+
+  Stack<unsigned> sorts;
+  DHMap<unsigned,unsigned>::Iterator it(_arraySkolemFunctions);
+  while (it.hasNext()) {
+    unsigned sort;
+    unsigned functor;
+    it.next(sort, functor);
+    if (functor >= number) {
+      sorts.push(sort);
+    }
+  }
+  while (sorts.isNonEmpty()) {
+    _arraySkolemFunctions.remove(sorts.pop());
+  }
+}
+
 unsigned Theory::Tuples::getFunctor(unsigned arity, unsigned* sorts) {
   CALL("Theory::Tuples::getFunctor(unsigned arity, unsigned* sorts)");
   return getFunctor(env.sorts->addTupleSort(arity, sorts));
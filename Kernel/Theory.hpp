@@ -29,6 +29,7 @@
 #include "Forwards.hpp"
 
 #include "Lib/DHMap.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Exception.hpp"
 
 #include "Shell/TermAlgebra.hpp"
@@ -274,6 +275,9 @@ std::ostream& operator<< (ostream& out, const RealConstantType& val) {
 class Theory
 {
 public:
+  CLASS_NAME(Theory);
+  USE_ALLOCATOR(Theory);
+
   /**
    * Interpreted symbols and predicates
    *
@@ -449,6 +453,7 @@ public:
   static bool isPolymorphic(Interpretation i);
 
   unsigned getArrayExtSkolemFunction(unsigned i);
+  void forgetFunctionsFrom(unsigned number);
 
   static Theory theory_obj;
   static Theory* instance();
@@ -553,6 +558,8 @@ public:
   Term* representRealConstant(vstring str);
 private:
   Theory();
+  /** a problem state of the environment has a theory of its own */
+  friend struct Lib::Environment::State;
   static OperatorType* getConversionOperationType(Interpretation i);
 
   DHMap<unsigned,unsigned> _arraySkolemFunctions;
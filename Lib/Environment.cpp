@@ -23,6 +23,8 @@
  * @since 06/05/2007 Manchester
  */
 
+#include <algorithm>
+
 #include "Debug/Tracer.hpp"
 
 #include "Lib/Sys/SyncPipe.hpp"
@@ -31,6 +33,7 @@
 
 #include "Kernel/Signature.hpp"
 #include "Kernel/Sorts.hpp"
+#include "Kernel/Theory.hpp"
 
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
@@ -97,13 +100,73 @@ Environment::~Environment()
 }
 
 /**
- * If the global time limit reached set Statistics::terminationReason
- * to TIME_LIMIT and return true, otherwise return false.
+ * Create a fresh problem state with default options and an empty signature
+ */
+Environment::State::State()
+  : property(0),
+    clausePriorities(0),
+    maxClausePriority(1),
+    colorUsed(false),
+    interpretedOperationsUsed(false)
+{
+  CALL("Environment::State::State");
+
+  options = new Options;
+  statistics = new Statistics;
+  sorts = new Sorts;
+  signature = new Signature;
+  theory = new Theory;
+  sharing = new TermSharing;
+}
+
+Environment::State::~State()
+{
+  CALL("Environment::State::~State");
+
+  delete sharing;
+  delete theory;
+  delete signature;
+  delete sorts;
+  delete statistics;
+  if(clausePriorities) delete clausePriorities;
+  {
+    BYPASSING_ALLOCATOR; // use of std::function in options
+    delete options;
+  }
+}
+
+/**
+ * Exchange the problem state of the environment with @c st
+ *
+ * Calling the function twice with the same object restores the
+ * original state, so states can be entered and left in a stack-like manner.
+ */
+void Environment::swapState(State& st)
+{
+  CALL("Environment::swapState");
+
+  std::swap(options, st.options);
+  std::swap(sorts, st.sorts);
+  std::swap(signature, st.signature);
+  std::swap(Kernel::theory, st.theory);
+  std::swap(sharing, st.sharing);
+  std::swap(statistics, st.statistics);
+  std::swap(property, st.property);
+  std::swap(clausePriorities, st.clausePriorities);
+  std::swap(maxClausePriority, st.maxClausePriority);
+  std::swap(colorUsed, st.colorUsed);
+  std::swap(interpretedOperationsUsed, st.interpretedOperationsUsed);
+}
+
+/**
+ * If the time limit of the process has been reached, set
+ * Statistics::terminationReason to TIME_LIMIT and return true,
+ * otherwise return false.
  * @since 25/03/2008 Torrevieja
  */
-bool Environment::timeLimitReached() const
+bool Environment::globalTimeLimitReached() const
 {
-  CALL("Environment::timeLimitReached");
+  CALL("Environment::globalTimeLimitReached");
 
   if (options->timeLimitInDeciseconds() &&
       timer->elapsedDeciseconds() > options->timeLimitInDeciseconds()) {
@@ -111,15 +174,55 @@ bool Environment::timeLimitReached() const
     return true;
   }
   return false;
+} // Environment::globalTimeLimitReached
+
+/**
+ * True if the time limit of the process or the deadline of the task run
+ * by the current thread (see ScopedDeadline) has been reached
+ */
+bool Environment::timeLimitReached() const
+{
+  CALL("Environment::timeLimitReached");
+
+  if (globalTimeLimitReached()) {
+    return true;
+  }
+  if (ScopedDeadline::passed()) {
+    statistics->terminationReason = Shell::Statistics::TIME_LIMIT;
+    return true;
+  }
+  return false;
 } // Environment::timeLimitReached
 
+/**
+ * Time check for code that is not prepared to be interrupted by a
+ * TimeLimitExceededException, such as preprocessing, clausification and
+ * the SAT solvers. If the time limit of the process has been reached,
+ * terminate it (as the SIGALRM handler would, see Timer::checkTimeLimit()).
+ * If only the deadline of the current task has passed, throw the
+ * exception; tasks with a deadline are run by ProvingHelper::runVampire(),
+ * which catches it.
+ */
+void Environment::timeSafePoint() const
+{
+  CALL("Environment::timeSafePoint");
+
+  Timer::checkTimeLimit();
+  if (ScopedDeadline::passed()) {
+    statistics->terminationReason = Shell::Statistics::TIME_LIMIT;
+    throw TimeLimitExceededException();
+  }
+} // Environment::timeSafePoint
+
 
 /**
- * Return remaining time in miliseconds.
+ * Return remaining time in miliseconds, taking into account the
+ * deadline of the current task, if any.
  */
 int Environment::remainingTime() const
 {
-  return options->timeLimitInDeciseconds()*100 - timer->elapsedMilliseconds();
+  int res = options->timeLimitInDeciseconds()*100 - timer->elapsedMilliseconds();
+  return min(res, ScopedDeadline::remainingMilliseconds());
 }
 
 /**
@@ -78,6 +78,7 @@ public:
   void setPriorityOutput(ostream* stm);
   ostream* getPriorityOutput() { return _priorityOutput; }
 
+  bool globalTimeLimitReached() const;
   bool timeLimitReached() const;
 
   template<int Period>
@@ -92,6 +93,20 @@ public:
       }
     }
   }
+  /**
+   * Like timeSafePoint(), but only checks every @c Period calls.
+   */
+  template<int Period>
+  void timeSafePointSometime() const
+  {
+    static int counter=0;
+    counter++;
+    if(counter==Period) {
+      counter=0;
+      timeSafePoint();
+    }
+  }
+  void timeSafePoint() const;
   /** Time remaining until the end of the time-limit in miliseconds */
   int remainingTime() const;
   /** set to true when coloring is used for symbol elimination or interpolation */
@@ -99,6 +114,35 @@ public:
   /** set to true when there are some interpreted operations */
   bool interpretedOperationsUsed;
 
+  /**
+   * The part of the environment that belongs to a single problem:
+   * its options, symbols, shared terms and statistics, and the theory
+   * (Kernel::theory), which caches symbol numbers. Several of these
+   * can be kept aside and exchanged with the current one by swapState().
+   */
+  struct State
+  {
+    CLASS_NAME(Environment::State);
+    USE_ALLOCATOR(Environment::State);
+
+    State();
+    ~State();
+
+    Shell::Options* options;
+    Kernel::Sorts* sorts;
+    Kernel::Signature* signature;
+    Kernel::Theory* theory;
+    Indexing::TermSharing* sharing;
+    Shell::Statistics* statistics;
+    Shell::Property* property;
+    DHMap<const Kernel::Unit*,unsigned>* clausePriorities;
+    unsigned maxClausePriority;
+    bool colorUsed;
+    bool interpretedOperationsUsed;
+  };
+
+  void swapState(State& st);
+
 private:
   int _outputDepth;
   /** if non-zero, all output will go here */
@@ -289,6 +289,40 @@ protected:
   } // Map::replace
 
   
+  /**
+   * Remove the pair with key @b key from the map.
+   * Return true if there was such a pair.
+   */
+  bool remove(const Key key)
+  {
+    CALL("Map::remove");
+
+    unsigned code = Hash::hash(key);
+    if (code == 0) {
+      code = 1;
+    }
+    Entry* entry;
+    for (entry = firstEntryForCode(code); entry->occupied(); entry = nextEntry(entry)) {
+      if (entry->code == code && Hash::equals(entry->key, key)) {
+        break;
+      }
+    }
+    if (!entry->occupied()) {
+      return false;
+    }
+    entry->code = 0;
+    _noOfEntries--;
+    // the entries after the removed one may have been placed behind it,
+    // so they are inserted again
+    for (entry = nextEntry(entry); entry->occupied(); entry = nextEntry(entry)) {
+      unsigned entryCode = entry->code;
+      entry->code = 0;
+      _noOfEntries--;
+      insert(entry->key, entry->value, entryCode);
+    }
+    return true;
+  } // Map::remove
+
   /**
    * Assign pointer to value stored under @b key into @b pval.
    * If nothing was previously stored under @b key, initialize
@@ -0,0 +1,220 @@
+
+/*
+ * File CpuPlacement.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file CpuPlacement.cpp
+ * Implements class CpuPlacement.
+ */
+
+#include "Lib/Portability.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sched.h>
+#include <dirent.h>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Int.hpp"
+
+#include "CpuPlacement.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+using namespace std;
+
+#if !(__APPLE__ || __CYGWIN__)
+
+static const char* CPU_DIR = "/sys/devices/system/cpu/";
+static const char* NODE_DIR = "/sys/devices/system/node/";
+
+/**
+ * Read a single integer from file @b fname, return -1 if it cannot be read
+ */
+static int readSysInt(vstring fname)
+{
+  CALL("readSysInt");
+
+  ifstream in(fname.c_str());
+  int res;
+  if (!(in >> res)) {
+    return -1;
+  }
+  return res;
+}
+
+/**
+ * Assign NUMA node numbers to the CPUs in @b nodeOf
+ */
+static void readNodes(DHMap<unsigned,int>& nodeOf)
+{
+  CALL("readNodes");
+
+  DIR* dirp = opendir(NODE_DIR);
+  if (!dirp) {
+    return;
+  }
+  struct dirent* dp;
+  while ((dp = readdir(dirp)) != NULL) {
+    unsigned node;
+    if (strncmp(dp->d_name, "node", 4) != 0 || !Int::stringToUnsignedInt(dp->d_name+4, node)) {
+      continue;
+    }
+    // the list has the form like "0-7,16-23"
+    ifstream in((vstring(NODE_DIR)+dp->d_name+"/cpulist").c_str());
+    vstring list;
+    if (!(in >> list)) {
+      continue;
+    }
+    const char* p = list.c_str();
+    while (*p) {
+      char* end;
+      unsigned from = strtoul(p, &end, 10);
+      unsigned to = from;
+      if (*end == '-') {
+        to = strtoul(end+1, &end, 10);
+      }
+      for (unsigned cpu = from; cpu <= to; cpu++) {
+        nodeOf.set(cpu, node);
+      }
+      if (end == p) {
+        break;
+      }
+      p = (*end == ',') ? end+1 : end;
+    }
+  }
+  closedir(dirp);
+}
+
+CpuPlacement::CpuPlacement()
+{
+  CALL("CpuPlacement::CpuPlacement");
+
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return;
+  }
+
+  DHMap<unsigned,int> nodeOf;
+  readNodes(nodeOf);
+
+  // the first hardware thread of each core, and the others, per socket
+  DHMap<int,unsigned> socketIndex;
+  Stack<Stack<Cpu> > firstThreads;
+  Stack<Stack<Cpu> > otherThreads;
+  DHSet<vstring> coreSeen;
+
+  for (unsigned id = 0; id < CPU_SETSIZE; id++) {
+    if (!CPU_ISSET(id, &allowed)) {
+      continue;
+    }
+    vstring topology = vstring(CPU_DIR)+"cpu"+Int::toString(id)+"/topology/";
+    Cpu cpu;
+    cpu.id = id;
+    cpu.socket = readSysInt(topology+"physical_package_id");
+    cpu.core = readSysInt(topology+"core_id");
+    cpu.node = -1;
+    nodeOf.find(id, cpu.node);
+
+    unsigned socket;
+    if (!socketIndex.find(cpu.socket, socket)) {
+      socket = firstThreads.size();
+      socketIndex.insert(cpu.socket, socket);
+      firstThreads.push(Stack<Cpu>());
+      otherThreads.push(Stack<Cpu>());
+    }
+    // without the topology, each CPU counts as a core of its own
+    if (cpu.core == -1 || coreSeen.insert(Int::toString(cpu.socket)+":"+Int::toString(cpu.core))) {
+      firstThreads[socket].push(cpu);
+    }
+    else {
+      otherThreads[socket].push(cpu);
+    }
+  }
+
+  Stack<Stack<Cpu> >* groups[] = { &firstThreads, &otherThreads };
+  for (unsigned g = 0; g < 2; g++) {
+    Stack<Stack<Cpu> >& perSocket = *groups[g];
+    for (unsigned i = 0; ; i++) {
+      bool added = false;
+      for (unsigned s = 0; s < perSocket.size(); s++) {
+        if (i < perSocket[s].size()) {
+          _order.push(perSocket[s][i]);
+          added = true;
+        }
+      }
+      if (!added) {
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * Restrict process @b pid to run on @b cpu. Return false if that failed.
+ */
+bool CpuPlacement::pin(pid_t pid, const Cpu& cpu)
+{
+  CALL("CpuPlacement::pin");
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu.id, &set);
+  return sched_setaffinity(pid, sizeof(set), &set) == 0;
+}
+
+#else
+
+CpuPlacement::CpuPlacement()
+{
+}
+
+bool CpuPlacement::pin(pid_t pid, const Cpu& cpu)
+{
+  return false;
+}
+
+#endif
+
+/**
+ * Return the CPU for worker number @b worker. If there are more workers
+ * than CPUs, the CPUs are used over again.
+ */
+const CpuPlacement::Cpu& CpuPlacement::cpuFor(unsigned worker) const
+{
+  CALL("CpuPlacement::cpuFor");
+  ASS_G(size(),0);
+
+  return _order[worker % _order.size()];
+}
+
+void CpuPlacement::output(ostream& out, const Cpu& cpu)
+{
+  out << "cpu " << cpu.id << " (socket " << cpu.socket << ", core " << cpu.core << ", node " << cpu.node << ")";
+}
+
+}
+}
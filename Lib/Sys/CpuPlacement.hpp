@@ -0,0 +1,83 @@
+
+/*
+ * File CpuPlacement.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file CpuPlacement.hpp
+ * Defines class CpuPlacement.
+ */
+
+#ifndef __CpuPlacement__
+#define __CpuPlacement__
+
+#include <ostream>
+#include <unistd.h>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * Placement of worker processes on the CPUs the current process may run on.
+ *
+ * The CPUs are ordered so that the workers get one hardware thread of each
+ * physical core first, alternating between the sockets, and only then the
+ * remaining hardware threads (SMT siblings) of the cores. A worker pinned to
+ * a CPU gets its new memory from the NUMA node of the CPU, which is where
+ * the kernel allocates by default.
+ *
+ * The topology is read from /sys on Linux; elsewhere no CPUs are known
+ * and nothing gets pinned.
+ */
+class CpuPlacement
+{
+public:
+  CLASS_NAME(CpuPlacement);
+  USE_ALLOCATOR(CpuPlacement);
+
+  struct Cpu
+  {
+    unsigned id;
+    /** physical package, -1 if unknown */
+    int socket;
+    /** core within the package, -1 if unknown */
+    int core;
+    /** NUMA node, -1 if unknown */
+    int node;
+  };
+
+  CpuPlacement();
+
+  /** Number of CPUs available for the workers */
+  unsigned size() const { return _order.size(); }
+  const Cpu& cpuFor(unsigned worker) const;
+
+  static bool pin(pid_t pid, const Cpu& cpu);
+  static void output(std::ostream& out, const Cpu& cpu);
+
+private:
+  Stack<Cpu> _order;
+};
+
+}
+}
+
+#endif // __CpuPlacement__
@@ -11,6 +11,7 @@
 #include "./unistd.h"
 #include "./sys/types.h"
 #include "./sys/wait.h"
+#include "./sys/resource.h"
 
 #include "Lib/Environment.hpp"
 #include "Lib/List.hpp"
@@ -23,6 +24,17 @@ namespace Lib
 namespace Sys
 {
 
+/** Peak resident memory in kilobytes from @b usage */
+static size_t peakMemory(const struct rusage& usage)
+{
+#if __APPLE__
+  // reported in bytes rather than kilobytes
+  return usage.ru_maxrss/1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
 Multiprocessing* Multiprocessing::instance()
 {
   static Multiprocessing inst;
@@ -30,7 +42,7 @@ Multiprocessing* Multiprocessing::instance()
 }
 
 Multiprocessing::Multiprocessing()
-: _preFork(0), _postForkParent(0), _postForkChild(0)
+: _preFork(0), _postForkParent(0), _postForkChild(0), _lastChildPeakMemory(0)
 {
 
 }
@@ -235,13 +247,59 @@ pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code)
   CALL("Multiprocessing::poll_child");
 
   int status;
-  pid_t pid = waitpid(-1, &status, WUNTRACED);
+  struct rusage usage;
+  pid_t pid = wait4(-1, &status, WUNTRACED, &usage);
   stopped = WIFSTOPPED(status);
   exited = WIFEXITED(status);
   if(exited)
   {
     code = WEXITSTATUS(status);
   }
+  if(!stopped)
+  {
+    _lastChildPeakMemory = peakMemory(usage);
+  }
+  return pid;
+}
+
+/**
+ * Like poll_children(bool&,bool&,int&), but wait at most @b timeMs
+ * milliseconds for a child to change its state. Return 0 if none did.
+ */
+pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code, unsigned timeMs)
+{
+  CALL("Multiprocessing::poll_children/4");
+
+  int dueTime = env.timer->elapsedMilliseconds()+timeMs;
+
+  int status;
+  struct rusage usage;
+  pid_t pid;
+  for(;;) {
+    errno=0;
+    pid = wait4(WAIT_ANY, &status, WNOHANG | WUNTRACED, &usage);
+    if(pid==-1) {
+      SYSTEM_FAIL("Call to waitpid() function failed.", errno);
+    }
+    if(pid) {
+      break;
+    }
+    if(dueTime<=env.timer->elapsedMilliseconds()) {
+      return 0;
+    }
+    sleep(10);
+  }
+
+  stopped = WIFSTOPPED(status);
+  exited = WIFEXITED(status);
+  if(exited)
+  {
+    code = WEXITSTATUS(status);
+  }
+  if(!stopped)
+  {
+    _lastChildPeakMemory = peakMemory(usage);
+  }
   return pid;
 }
 
@@ -27,6 +27,12 @@ public:
   void kill(pid_t child, int signal);
   void killNoCheck(pid_t child, int signal);
   pid_t poll_children(bool &stopped, bool &exited, int &code);
+  pid_t poll_children(bool &stopped, bool &exited, int &code, unsigned timeMs);
+  /**
+   * Peak resident memory in kilobytes of the child that terminated last
+   * as reported by poll_children, or 0 if not known.
+   */
+  size_t lastChildPeakMemory() const { return _lastChildPeakMemory; }
 private:
   Multiprocessing();
   ~Multiprocessing();
@@ -36,6 +42,8 @@ private:
   VoidFuncList* _preFork;
   VoidFuncList* _postForkParent;
   VoidFuncList* _postForkChild;
+
+  size_t _lastChildPeakMemory;
 };
 
 }// namespace Sys
@@ -0,0 +1,62 @@
+
+/*
+ * File SharedMemory.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SharedMemory.cpp
+ * Implements class SharedMemory.
+ */
+
+#include <cerrno>
+
+#include "Lib/Portability.hpp"
+
+#include <sys/mman.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Exception.hpp"
+
+#include "SharedMemory.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+SharedMemory::SharedMemory(size_t size)
+: _size(size)
+{
+  CALL("SharedMemory::SharedMemory");
+  ASS_G(size,0);
+
+  //anonymous mappings are zero-filled
+  _address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(_address==MAP_FAILED) {
+    SYSTEM_FAIL("Cannot create shared memory.",errno);
+  }
+}
+
+SharedMemory::~SharedMemory()
+{
+  CALL("SharedMemory::~SharedMemory");
+
+  munmap(_address, _size);
+}
+
+}
+}
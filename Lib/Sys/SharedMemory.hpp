@@ -0,0 +1,64 @@
+
+/*
+ * File SharedMemory.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SharedMemory.hpp
+ * Defines class SharedMemory.
+ */
+
+#ifndef __SharedMemory__
+#define __SharedMemory__
+
+#include <cstddef>
+
+#include "Forwards.hpp"
+
+#include "Lib/Exception.hpp"
+#include "Lib/Portability.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A zero-initialized memory region shared by the process that created it
+ * and all the processes forked from it afterwards.
+ *
+ * The region is unmapped in each process when its object is destroyed.
+ * There is no synchronization, the users of the region must take care
+ * of it themselves.
+ */
+class SharedMemory {
+public:
+  explicit SharedMemory(size_t size);
+  ~SharedMemory();
+
+  void* address() const { return _address; }
+  size_t size() const { return _size; }
+
+private:
+  SharedMemory(const SharedMemory&);
+  SharedMemory& operator=(const SharedMemory&);
+
+  void* _address;
+  size_t _size;
+};
+
+}
+}
+
+#endif // __SharedMemory__
@@ -0,0 +1,152 @@
+
+/*
+ * File SharedRing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SharedRing.cpp
+ * Implements class SharedRing.
+ */
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "SharedRing.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+/** Offset of the first slot, so that the write position has a cache line of its own */
+static const size_t SLOTS_OFFSET = 64;
+
+static size_t slotSizeFor(unsigned slotWords, size_t headerSize)
+{
+  size_t size = headerSize+slotWords*sizeof(unsigned);
+  size_t align = sizeof(unsigned long long);
+  return (size+align-1)/align*align;
+}
+
+SharedRing::SharedRing(unsigned slotWords, unsigned capacity)
+: _slotWords(slotWords), _slotSize(slotSizeFor(slotWords, sizeof(SlotHeader))), _capacity(capacity),
+  _memory(SLOTS_OFFSET+capacity*_slotSize), _worker(0), _readPos(0), _stalledPolls(0)
+{
+  CALL("SharedRing::SharedRing");
+  ASS_G(capacity,0);
+
+  char* mem = static_cast<char*>(_memory.address());
+  _writePos = reinterpret_cast<Ticket*>(mem);
+  _slots = mem+SLOTS_OFFSET;
+}
+
+/**
+ * Set the index of the current worker. To be called in each
+ * worker process before it starts publishing messages.
+ */
+void SharedRing::setWorker(unsigned worker)
+{
+  CALL("SharedRing::setWorker");
+
+  _worker = worker;
+}
+
+/**
+ * Make the message of @c length words at @c words available to the other workers
+ */
+void SharedRing::publish(const unsigned* words, unsigned length)
+{
+  CALL("SharedRing::publish");
+  ASS_LE(length,_slotWords);
+
+  Ticket t = __atomic_fetch_add(_writePos, 1, __ATOMIC_RELAXED);
+  SlotHeader& s = slotFor(t);
+  unsigned* slotWords = wordsOf(s);
+
+  __atomic_store_n(&s.ticket, 0, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  __atomic_store_n(&s.worker, _worker, __ATOMIC_RELAXED);
+  __atomic_store_n(&s.length, length, __ATOMIC_RELAXED);
+  for(unsigned i=0; i<length; i++) {
+    __atomic_store_n(&slotWords[i], words[i], __ATOMIC_RELAXED);
+  }
+
+  __atomic_store_n(&s.ticket, t+1, __ATOMIC_RELEASE);
+}
+
+/**
+ * If there is a message published by another worker that the current one
+ * has not consumed yet, put its words into @c words and return true.
+ * Otherwise return false.
+ */
+bool SharedRing::consume(Stack<unsigned>& words)
+{
+  CALL("SharedRing::consume");
+
+  Ticket writePos = __atomic_load_n(_writePos, __ATOMIC_ACQUIRE);
+  if(writePos-_readPos > _capacity) {
+    //we are too late for the oldest ones
+    _readPos = writePos-_capacity;
+    _stalledPolls = 0;
+  }
+
+  while(_readPos<writePos) {
+    SlotHeader& s = slotFor(_readPos);
+    unsigned* slotWords = wordsOf(s);
+    Ticket expected = _readPos+1;
+
+    Ticket before = __atomic_load_n(&s.ticket, __ATOMIC_ACQUIRE);
+    if(before<expected) {
+      //the message is still being written, we will try it next time,
+      //unless its writer seems to be stuck
+      if(++_stalledPolls<MAX_STALLED_POLLS) {
+        return false;
+      }
+      _stalledPolls = 0;
+      _readPos++;
+      continue;
+    }
+    _stalledPolls = 0;
+    if(before>expected) {
+      //the slot has been reused in the meantime
+      _readPos++;
+      continue;
+    }
+
+    unsigned worker = __atomic_load_n(&s.worker, __ATOMIC_RELAXED);
+    unsigned len = __atomic_load_n(&s.length, __ATOMIC_RELAXED);
+    if(len>_slotWords) {
+      len = _slotWords; //the slot is being rewritten, the ticket check below fails
+    }
+    words.reset();
+    for(unsigned i=0; i<len; i++) {
+      words.push(__atomic_load_n(&slotWords[i], __ATOMIC_RELAXED));
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    Ticket after = __atomic_load_n(&s.ticket, __ATOMIC_RELAXED);
+    _readPos++;
+
+    if(after==expected && worker!=_worker) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+}
@@ -0,0 +1,105 @@
+
+/*
+ * File SharedRing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SharedRing.hpp
+ * Defines class SharedRing.
+ */
+
+#ifndef __SharedRing__
+#define __SharedRing__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SharedMemory.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * Ring buffer of short messages (sequences of unsigned words) exchanged
+ * between processes forked after the object was created.
+ *
+ * A writer reserves a slot by an atomic increment of the write position
+ * and publishes the message by storing the ticket of the slot last. Each
+ * reader keeps its own read position. Nobody ever waits: a reader that
+ * falls behind by more than the buffer capacity skips the overwritten
+ * messages, a message overwritten while being read is dropped, and so is
+ * a message still being written after MAX_STALLED_POLLS calls of consume
+ * (its writer may have been stopped or killed in the middle of publish).
+ */
+class SharedRing
+{
+public:
+  CLASS_NAME(SharedRing);
+  USE_ALLOCATOR(SharedRing);
+
+  SharedRing(unsigned slotWords, unsigned capacity);
+
+  /** Maximal number of words of a message */
+  unsigned slotWords() const { return _slotWords; }
+
+  void setWorker(unsigned worker);
+
+  void publish(const unsigned* words, unsigned length);
+  bool consume(Stack<unsigned>& words);
+
+private:
+  typedef unsigned long long Ticket;
+
+  /** Number of consume calls after which an unfinished message is skipped */
+  static const unsigned MAX_STALLED_POLLS = 64;
+
+  struct SlotHeader
+  {
+    /** one more than the number of the message stored in the slot, 0 while being written */
+    Ticket ticket;
+    unsigned worker;
+    unsigned length;
+  };
+
+  SlotHeader& slotFor(Ticket t)
+  { return *reinterpret_cast<SlotHeader*>(_slots+(t%_capacity)*_slotSize); }
+  static unsigned* wordsOf(SlotHeader& s)
+  { return reinterpret_cast<unsigned*>(&s+1); }
+
+  unsigned _slotWords;
+  /** Size of a slot in bytes */
+  size_t _slotSize;
+  unsigned _capacity;
+
+  SharedMemory _memory;
+  /** Number of messages ever published, shared by all workers */
+  Ticket* _writePos;
+  char* _slots;
+
+  /** Index of the current worker, its own messages are not consumed */
+  unsigned _worker;
+  /** Number of the next message to be consumed by the current worker */
+  Ticket _readPos;
+  /** Number of consume calls that found the message at _readPos unfinished */
+  unsigned _stalledPolls;
+};
+
+}
+}
+
+#endif // __SharedRing__
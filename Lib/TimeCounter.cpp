@@ -29,6 +29,7 @@
 #include "Lib/Timer.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/SliceProgress.hpp"
 #include "Shell/UIHelper.hpp"
 
 #include "TimeCounter.hpp"
@@ -113,6 +114,10 @@ void TimeCounter::startMeasuring(TimeCounterUnit tcu)
 
   _tcu=tcu;
   s_measureInitTimes[_tcu]=currTime;
+
+  if(SliceProgress::instance()) {
+    SliceProgress::instance()->setTimeCounter(tcu);
+  }
 }
 
 void TimeCounter::stopMeasuring()
@@ -138,6 +143,10 @@ void TimeCounter::stopMeasuring()
 
   ASS_EQ(s_currTop,this);
   s_currTop = previousTop;
+
+  if(SliceProgress::instance()) {
+    SliceProgress::instance()->setTimeCounter(current());
+  }
 }
 
 void TimeCounter::snapShot()
@@ -188,6 +197,25 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   }
 
   addCommentSignForSZS(out);
+  outputUnitName(tcu, out);
+  out<<": ";
+
+  Timer::printMSString(out, s_measuredTimes[tcu]);
+
+  if (s_measuredTimesChildren[tcu] > 0) {
+    out << " ( own ";
+    Timer::printMSString(out, s_measuredTimes[tcu]-s_measuredTimesChildren[tcu]);
+    out << " ) ";
+  }
+  
+  out<<endl;
+}
+
+/**
+ * Output the description of @b tcu, as used in the time report
+ */
+void TimeCounter::outputUnitName(TimeCounterUnit tcu, ostream& out)
+{
   switch(tcu) {
   case TC_RAND_OPT:
     out << "random option generation";
@@ -411,16 +439,5 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   default:
     ASSERTION_VIOLATION;
   }
-  out<<": ";
-
-  Timer::printMSString(out, s_measuredTimes[tcu]);
-
-  if (s_measuredTimesChildren[tcu] > 0) {
-    out << " ( own ";
-    Timer::printMSString(out, s_measuredTimes[tcu]-s_measuredTimesChildren[tcu]);
-    out << " ) ";
-  }
-  
-  out<<endl;
 }
 
@@ -125,6 +125,13 @@ public:
   }
 
   static void printReport(ostream& out);
+  static void outputUnitName(TimeCounterUnit tcu, ostream& out);
+
+  /** The innermost unit being measured, TC_OTHER if there is none */
+  static TimeCounterUnit current()
+  {
+    return s_currTop ? s_currTop->_tcu : TC_OTHER;
+  }
 
 
   /**
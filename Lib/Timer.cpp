@@ -21,6 +21,7 @@
  * Implements class Timer.
  */
 
+#include <climits>
 #include <ctime>
 #include <cerrno>
 
@@ -49,26 +50,21 @@ using namespace Lib;
 
 bool Timer::s_timeLimitEnforcement = true;
 
-#if UNIX_USE_SIGALRM
-
-
-
-#include "./stdlib.h"
-#include "./signal.h"
-#include "./sys/time.h"
-#include "./sys/times.h"
-
-#include "Lib/Sys/Multiprocessing.hpp"
-
-
-
-int timer_sigalrm_counter=-1;
-
-int Timer::s_ticksPerSec;
-int Timer::s_initGuarantedMiliseconds;
-
+/**
+ * Milliseconds of the monotonic clock since some unspecified moment.
+ * Read through the vDSO, so it is cheap enough to be called often.
+ */
+long long Lib::Timer::monotonicMilliseconds()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<long long>(ts.tv_sec)*1000 + ts.tv_nsec/1000000;
+}
 
-void timeLimitReached()
+/**
+ * Print the time limit message and terminate the process
+ */
+static void timeLimitReached()
 {
   using namespace Shell;
 
@@ -98,6 +94,68 @@ void timeLimitReached()
   System::terminateImmediately(1);
 }
 
+/**
+ * Terminate the process if the global time limit is enforced and has been
+ * reached. The SIGALRM handler calls this on every tick, without it this
+ * is to be called at the points where the process can be safely stopped.
+ */
+void Lib::Timer::checkTimeLimit()
+{
+  if(s_timeLimitEnforcement && env.globalTimeLimitReached()) {
+    timeLimitReached();
+  }
+}
+
+#if UNIX_USE_MONOTONIC_CLOCK
+
+long long Timer::s_epoch = -1;
+
+/** number of miliseconds (of wall-clock time) passed since the timer was initialized */
+int Lib::Timer::miliseconds()
+{
+  return static_cast<int>(monotonicMilliseconds() - s_epoch);
+}
+
+void Lib::Timer::ensureTimerInitialized()
+{
+  if(s_epoch == -1) {
+    s_epoch = monotonicMilliseconds();
+  }
+}
+
+void Lib::Timer::deinitializeTimer()
+{
+}
+
+void Lib::Timer::syncClock()
+{
+  //the clock is exact
+}
+
+void Lib::Timer::makeChildrenIncluded()
+{
+  //here are children always included as we measure the wall clock time
+}
+
+#elif UNIX_USE_SIGALRM
+
+
+
+#include "./stdlib.h"
+#include "./signal.h"
+#include "./sys/time.h"
+#include "./sys/times.h"
+
+#include "Lib/Sys/Multiprocessing.hpp"
+
+
+
+int timer_sigalrm_counter=-1;
+
+int Timer::s_ticksPerSec;
+int Timer::s_initGuarantedMiliseconds;
+
+
 void
 timer_sigalrm_handler (int sig)
 {
@@ -111,9 +169,7 @@ timer_sigalrm_handler (int sig)
 
   timer_sigalrm_counter++;
 
-  if(Timer::s_timeLimitEnforcement && env.timeLimitReached()) {
-    timeLimitReached();
-  }
+  Timer::checkTimeLimit();
 
 #if DEBUG_TIMER_CHANGES
   if(timer_sigalrm_counter<0) {
@@ -361,6 +417,45 @@ Timer* Timer::instance()
   return inst.ptr();
 }
 
+thread_local ScopedDeadline* ScopedDeadline::s_innermost = 0;
+
+/**
+ * Set the deadline of the current thread to @b timeLimitMs milliseconds
+ * from now, unless an outer deadline comes earlier
+ */
+ScopedDeadline::ScopedDeadline(int timeLimitMs)
+: _deadline(Timer::monotonicMilliseconds() + timeLimitMs), _outer(s_innermost)
+{
+  if(_outer && _outer->_deadline < _deadline) {
+    _deadline = _outer->_deadline;
+  }
+  s_innermost = this;
+}
+
+ScopedDeadline::~ScopedDeadline()
+{
+  ASS_EQ(s_innermost, this);
+  s_innermost = _outer;
+}
+
+/** True if the current thread has a deadline and it has passed */
+bool ScopedDeadline::passed()
+{
+  return s_innermost && Timer::monotonicMilliseconds() >= s_innermost->_deadline;
+}
+
+/**
+ * Milliseconds left until the deadline of the current thread,
+ * or INT_MAX if it has none
+ */
+int ScopedDeadline::remainingMilliseconds()
+{
+  if(!s_innermost) {
+    return INT_MAX;
+  }
+  return static_cast<int>(s_innermost->_deadline - Timer::monotonicMilliseconds());
+}
+
 };// namespace Lib
 
 //#include <iostream>
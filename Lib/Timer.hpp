@@ -38,6 +38,21 @@
 #define UNIX_USE_SIGALRM 1 // MS: only the UNIX_USE_SIGALRM seems to be working currently (experiment with SMTCOMP mode); the problem with debugging under UNIX_USE_SIGALRM might have really gone, so let's try
 #endif
 
+#ifndef UNIX_USE_MONOTONIC_CLOCK
+/**
+ * When set, the timer reads CLOCK_MONOTONIC instead of counting SIGALRM
+ * ticks. There is no signal handler then, so the time limit is only
+ * enforced where it is checked explicitly (see Timer::checkTimeLimit(),
+ * Environment::timeLimitReached() and Environment::timeSafePoint()).
+ */
+#define UNIX_USE_MONOTONIC_CLOCK 0
+#endif
+
+#if UNIX_USE_MONOTONIC_CLOCK
+#undef UNIX_USE_SIGALRM
+#define UNIX_USE_SIGALRM 0
+#endif
+
 //we don't need SIGALRM in Api, and it causes problems debugging
 #ifdef VAPI_LIBRARY
 #if VAPI_LIBRARY
@@ -128,6 +143,9 @@ public:
   { s_timeLimitEnforcement = enabled; }
 
   static void syncClock();
+  static void checkTimeLimit();
+
+  static long long monotonicMilliseconds();
 
   static bool s_timeLimitEnforcement;
 private:
@@ -143,6 +161,11 @@ private:
 
   int miliseconds();
 
+#if UNIX_USE_MONOTONIC_CLOCK
+  /** value of monotonicMilliseconds() when the timer was initialized */
+  static long long s_epoch;
+#endif
+
 #if UNIX_USE_SIGALRM
   static void suspendTimerBeforeFork();
   static void restoreTimerAfterFork();
@@ -161,6 +184,36 @@ private:
   }
 }; // class Timer
 
+/**
+ * A time limit of the task run by the current thread in the scope of
+ * the object, such as a single call of ProvingHelper::runVampire().
+ *
+ * Unlike the global time limit, reaching the deadline does not terminate
+ * the process. Environment::timeLimitReached() starts returning true, so
+ * the task stops with a TimeLimitExceededException at its next check.
+ * Deadlines can be nested, the earliest one applies.
+ */
+class ScopedDeadline
+{
+public:
+  explicit ScopedDeadline(int timeLimitMs);
+  ~ScopedDeadline();
+
+  static bool passed();
+  static int remainingMilliseconds();
+
+private:
+  ScopedDeadline(const ScopedDeadline&);
+  ScopedDeadline& operator=(const ScopedDeadline&);
+
+  /** the deadline in Timer::monotonicMilliseconds() */
+  long long _deadline;
+  /** the deadline whose scope this one is in */
+  ScopedDeadline* _outer;
+
+  static thread_local ScopedDeadline* s_innermost;
+};
+
 } // namespace Lib
 
 #endif // LIB_TIMER_HPP_
@@ -106,6 +106,8 @@ Solver::Solver() :
   , conflict_budget    (-1)
   , propagation_budget (-1)
   , asynch_interrupt   (false)
+  , term_callback      (NULL)
+  , term_state         (NULL)
 {}
 
 
@@ -718,6 +720,9 @@ lbool Solver::search(int nof_conflicts)
             // CONFLICT
             conflicts++; conflictC++;
             if (decisionLevel() == 0) return l_False;
+            // let the caller stop the search without resetting the restart sequence
+            if (term_callback && conflicts % TERM_CHECK_CONFLICTS == 0 && term_callback(term_state))
+                asynch_interrupt = true;
 
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
@@ -116,6 +116,7 @@ public:
     void    budgetOff();
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
+    void    setTermCallback(int (*cb)(void*), void* state); // Interrupt the solver when 'cb(state)' returns non-zero (polled every TERM_CHECK_CONFLICTS conflicts).
 
     // Memory managment:
     //
@@ -241,6 +242,9 @@ protected:
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
     bool                asynch_interrupt;
+    int               (*term_callback)(void*);
+    void*               term_state;
+    static const uint64_t TERM_CHECK_CONFLICTS = 256;
 
     // Main internal methods:
     //
@@ -377,6 +381,7 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+inline void     Solver::setTermCallback(int (*cb)(void*), void* state){ term_callback = cb; term_state = state; }
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
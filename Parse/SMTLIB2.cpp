@@ -65,7 +65,8 @@ SMTLIB2::SMTLIB2(const Options& opts)
 : _logicSet(false),
   _logic(SMT_UNDEFINED),
   _numeralsAreReal(false),
-  _formulas(nullptr)
+  _formulas(nullptr),
+  _incremental(opts.mode() == Options::Mode::SMTLIB_INCREMENTAL)
 {
   CALL("SMTLIB2::SMTLIB2");
 }
@@ -221,6 +222,11 @@ void SMTLIB2::readBenchmark(LExprList* bench)
     }
 
     if (ibRdr.tryAcceptAtom("check-sat")) {
+      if (_incremental) {
+        _checkSatQueries.push(_formulas);
+        ibRdr.acceptEOL();
+        continue;
+      }
       if (bRdr.hasNext()) {
         LispListReader exitRdr(bRdr.readList());
         if (!exitRdr.tryAcceptAtom("exit")) {
@@ -250,7 +256,14 @@ void SMTLIB2::readBenchmark(LExprList* bench)
     }
 
     if (ibRdr.tryAcceptAtom("push")) {
-      LOG1("ignoring push");
+      readPush(readLevelCount(ibRdr,"push"));
+      ibRdr.acceptEOL();
+      continue;
+    }
+
+    if (ibRdr.tryAcceptAtom("pop")) {
+      readPop(readLevelCount(ibRdr,"pop"));
+      ibRdr.acceptEOL();
       continue;
     }
 
@@ -265,6 +278,62 @@ void SMTLIB2::readBenchmark(LExprList* bench)
 
 //  ----------------------------------------------------------------------
 
+unsigned SMTLIB2::readLevelCount(LispListReader& rdr, const vstring& entry)
+{
+  CALL("SMTLIB2::readLevelCount");
+
+  if (!rdr.hasNext()) {
+    return 1;
+  }
+  vstring numStr = rdr.readAtom();
+  unsigned num;
+  if (!Int::stringToUnsignedInt(numStr,num)) {
+    USER_ERROR("Invalid number of levels in "+entry+": "+numStr);
+  }
+  return num;
+}
+
+void SMTLIB2::readPush(unsigned levels)
+{
+  CALL("SMTLIB2::readPush");
+
+  for (unsigned i = 0; i < levels; i++) {
+    _assertionLevels.push(AssertionLevel(_formulas,_declarationTrail.size(),_sortDeclarationTrail.size()));
+  }
+}
+
+void SMTLIB2::readPop(unsigned levels)
+{
+  CALL("SMTLIB2::readPop");
+
+  if (levels > _assertionLevels.size()) {
+    USER_ERROR("Cannot pop "+Int::toString(levels)+" levels, only "+Int::toString((unsigned)_assertionLevels.size())+" pushed");
+  }
+  if (!levels) {
+    return;
+  }
+
+  AssertionLevel lev;
+  for (unsigned i = 0; i < levels; i++) {
+    lev = _assertionLevels.pop();
+  }
+
+  // the units are shared with the snapshots in _checkSatQueries, so we don't destroy them
+  _formulas = lev.formulas;
+
+  while (_declarationTrail.size() > lev.declarationCnt) {
+    ALWAYS(_declaredFunctions.remove(_declarationTrail.pop()));
+  }
+  while (_sortDeclarationTrail.size() > lev.sortDeclarationCnt) {
+    vstring name = _sortDeclarationTrail.pop();
+    if (!_declaredSorts.remove(name)) {
+      ALWAYS(_sortDefinitions.remove(name));
+    }
+  }
+}
+
+//  ----------------------------------------------------------------------
+
 const char * SMTLIB2::s_smtlibLogicNameStrings[] = {
     "ALIA",
     "ALL",
@@ -448,6 +517,9 @@ void SMTLIB2::readDeclareSort(const vstring& name, const vstring& arity)
   }
 
   ALWAYS(_declaredSorts.insert(name,val));
+  if (_assertionLevels.isNonEmpty()) {
+    _sortDeclarationTrail.push(name);
+  }
 }
 
 void SMTLIB2::readDefineSort(const vstring& name, LExprList* args, LExpr* body)
@@ -462,6 +534,9 @@ void SMTLIB2::readDefineSort(const vstring& name, LExprList* args, LExpr* body)
   // current solution: crash only later, at application site
 
   ALWAYS(_sortDefinitions.insert(name,SortDefinition(args,body)));
+  if (_assertionLevels.isNonEmpty()) {
+    _sortDeclarationTrail.push(name);
+  }
 }
 
 //  ----------------------------------------------------------------------
@@ -767,31 +842,46 @@ SMTLIB2::DeclaredFunction SMTLIB2::declareFunctionOrPredicate(const vstring& nam
   unsigned symNum;
   Signature::Symbol* sym;
   OperatorType* type;
+  bool isPredicate = rangeSort == Sorts::SRT_BOOL;
 
-  if (rangeSort == Sorts::SRT_BOOL) { // predicate
-    symNum = env.signature->addPredicate(name, argSorts.size(), added);
-
-    sym = env.signature->getPredicate(symNum);
-
+  if (isPredicate) {
     type = OperatorType::getPredicateType(argSorts.size(),argSorts.begin());
 
     LOG1("declareFunctionOrPredicate-Predicate");
   } else { // proper function
-    if (argSorts.size() > 0) {
-      symNum = env.signature->addFunction(name, argSorts.size(), added);
-    } else {
-      symNum = TPTP::addUninterpretedConstant(name,_overflow,added);
-    }
-
-    sym = env.signature->getFunction(symNum);
-
     type = OperatorType::getFunctionType(argSorts.size(), argSorts.begin(), rangeSort);
 
     LOG1("declareFunctionOrPredicate-Function");
   }
 
-  ASS(added);
-  sym->setType(type);
+  // The vampire symbol of a name declared on an assertion level that has
+  // been popped stays in the signature. It is reused when the name is
+  // declared again with the same type, otherwise a suffix is added.
+  vstring symName = name;
+  for (unsigned i = 0; ; i++) {
+    if (isPredicate) {
+      symNum = env.signature->addPredicate(symName, argSorts.size(), added);
+      sym = env.signature->getPredicate(symNum);
+      if (added || sym->predType() == type) {
+        break;
+      }
+    } else {
+      if (argSorts.size() > 0) {
+        symNum = env.signature->addFunction(symName, argSorts.size(), added);
+      } else {
+        symNum = TPTP::addUninterpretedConstant(symName,_overflow,added);
+      }
+      sym = env.signature->getFunction(symNum);
+      if (added || sym->fnType() == type) {
+        break;
+      }
+    }
+    symName = name+"_"+Int::toString(i);
+  }
+
+  if (added) {
+    sym->setType(type);
+  }
 
   DeclaredFunction res = make_pair(symNum,type->isFunctionType());
 
@@ -799,6 +889,9 @@ SMTLIB2::DeclaredFunction SMTLIB2::declareFunctionOrPredicate(const vstring& nam
   LOG2("declareFunctionOrPredicate -symNum ",symNum);
 
   ALWAYS(_declaredFunctions.insert(name,res));
+  if (_assertionLevels.isNonEmpty()) {
+    _declarationTrail.push(name);
+  }
 
   return res;
 }
@@ -902,10 +995,15 @@ void SMTLIB2::readDeclareDatatypes(LExprList* sorts, LExprList* datatypes, bool
     }
 
     ALWAYS(_declaredSorts.insert(dtypeName, 0));
+    if (_assertionLevels.isNonEmpty()) {
+      _sortDeclarationTrail.push(dtypeName);
+    }
     bool added;
     unsigned srt = env.sorts->addSort(dtypeName + "()", added,false);
-    ASS(added);
-    (void)srt; // to get rid of compiler warning when logging is off
+    if (!added && !env.signature->isTermAlgebraSort(srt)) {
+      // the sort was declared by declare-sort on a popped assertion level
+      USER_ERROR("Redeclaring popped sort symbol as datatype: "+dtypeName);
+    }
     // TODO: is it really OK we normally don't need the sort?
     LOG2("reading datatype "+dtypeName+" as sort ",srt);
     dtypeNames.push(dtypeName+"()");
@@ -953,7 +1051,20 @@ void SMTLIB2::readDeclareDatatypes(LExprList* sorts, LExprList* datatypes, bool
       constructors.push(buildTermAlgebraConstructor(constrName, taSort, destructorNames, argSorts));
     }
 
-    ASS(!env.signature->isTermAlgebraSort(taSort));
+    if (env.signature->isTermAlgebraSort(taSort)) {
+      // declared on an assertion level that has been popped; the term
+      // algebra stays in the signature and is only reused if identical
+      TermAlgebra* prev = env.signature->getTermAlgebraOfSort(taSort);
+      if (!sameTermAlgebraConstructors(prev, constructors) || prev->allowsCyclicTerms() != codatatype) {
+        USER_ERROR("Redeclaring popped datatype with a different definition: " + taName);
+      }
+      Stack<TermAlgebraConstructor*>::Iterator cit(constructors);
+      while (cit.hasNext()) {
+        delete cit.next();
+      }
+      continue;
+    }
+
     TermAlgebra* ta = new TermAlgebra(taSort, constructors.size(), constructors.begin(), codatatype);
 
     if (ta->emptyDomain()) {
@@ -976,15 +1087,23 @@ TermAlgebraConstructor* SMTLIB2::buildTermAlgebraConstructor(vstring constrName,
 
   bool added;
   unsigned functor = env.signature->addFunction(constrName, arity, added);
-  ASS(added);
 
   OperatorType* constructorType = OperatorType::getFunctionType(arity, argSorts.begin(), taSort);
-  env.signature->getFunction(functor)->setType(constructorType);
-  env.signature->getFunction(functor)->markTermAlgebraCons();
+  Signature::Symbol* constrSym = env.signature->getFunction(functor);
+  if (added) {
+    constrSym->setType(constructorType);
+    constrSym->markTermAlgebraCons();
+  } else if (!constrSym->termAlgebraCons() || constrSym->fnType() != constructorType) {
+    // left over from an assertion level that has been popped
+    USER_ERROR("Redeclaring popped function symbol as a different constructor: " + constrName);
+  }
 
   LOG1("build constructor "+constrName+": "+constructorType->toString());
 
   ALWAYS(_declaredFunctions.insert(constrName, make_pair(functor, true)));
+  if (_assertionLevels.isNonEmpty()) {
+    _declarationTrail.push(constrName);
+  }
 
   Lib::Array<unsigned> destructorFunctors(arity);
   for (unsigned i = 0; i < arity; i++) {
@@ -999,20 +1118,25 @@ TermAlgebraConstructor* SMTLIB2::buildTermAlgebraConstructor(vstring constrName,
     bool added;
     unsigned destructorFunctor = isPredicate ? env.signature->addPredicate(destructorName, 1, added)
                                              : env.signature->addFunction(destructorName,  1, added);
-    ASS(added);
 
     OperatorType* destructorType = isPredicate ? OperatorType::getPredicateType(1, &taSort)
                                            : OperatorType::getFunctionType(1, &taSort, destructorSort);
 
     LOG1("build destructor "+destructorName+": "+destructorType->toString());
 
-    if (isPredicate) {
-      env.signature->getPredicate(destructorFunctor)->setType(destructorType);
-    } else {
-      env.signature->getFunction(destructorFunctor)->setType(destructorType);
+    Signature::Symbol* destructorSym = isPredicate ? env.signature->getPredicate(destructorFunctor)
+                                                   : env.signature->getFunction(destructorFunctor);
+    if (added) {
+      destructorSym->setType(destructorType);
+    } else if ((isPredicate ? destructorSym->predType() : destructorSym->fnType()) != destructorType) {
+      // left over from an assertion level that has been popped
+      USER_ERROR("Redeclaring popped function symbol as a different destructor: " + destructorName);
     }
 
     ALWAYS(_declaredFunctions.insert(destructorName, make_pair(destructorFunctor, !isPredicate)));
+    if (_assertionLevels.isNonEmpty()) {
+      _declarationTrail.push(destructorName);
+    }
 
     destructorFunctors[i] = destructorFunctor;
   }
@@ -1020,6 +1144,32 @@ TermAlgebraConstructor* SMTLIB2::buildTermAlgebraConstructor(vstring constrName,
   return new TermAlgebraConstructor(functor, destructorFunctors);
 }
 
+/**
+ * True if @b constructors have the same functors and destructors as
+ * the constructors of @b ta, in the same order.
+ */
+bool SMTLIB2::sameTermAlgebraConstructors(TermAlgebra* ta, const Stack<TermAlgebraConstructor*>& constructors)
+{
+  CALL("SMTLIB2::sameTermAlgebraConstructors");
+
+  if (ta->nConstructors() != constructors.size()) {
+    return false;
+  }
+  for (unsigned i = 0; i < constructors.size(); i++) {
+    TermAlgebraConstructor* c = ta->constructor(i);
+    TermAlgebraConstructor* d = constructors[i];
+    if (c->functor() != d->functor()) {
+      return false;
+    }
+    for (unsigned j = 0; j < c->arity(); j++) {
+      if (c->destructorFunctor(j) != d->destructorFunctor(j)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool SMTLIB2::ParseResult::asFormula(Formula*& resFrm)
 {
   CALL("SMTLIB2::ParseResult::asFormula");
@@ -61,6 +61,17 @@ public:
    **/
   UnitList* getFormulas() const { return _formulas; }
 
+  /**
+   * Formulas asserted at the time of each "check-sat" entry, in the order
+   * in which the entries appeared.
+   *
+   * Only collected in incremental mode (see Options::Mode::SMTLIB_INCREMENTAL),
+   * otherwise parsing stops at the first "check-sat".
+   * The lists share their tails with each other and with getFormulas(),
+   * since assertions made under a common prefix of "push" levels are the same units.
+   */
+  const Stack<UnitList*>& getCheckSatQueries() const { return _checkSatQueries; }
+
   /**
    * Return the parsed logic (or LO_INVALID if not set).
    */
@@ -68,15 +79,15 @@ public:
     return _logic;
   }
 
-private:
-
-  static const char * s_smtlibLogicNameStrings[];
-
   /**
    * Maps a string to a SmtlibLogic value.
    */
   static SMTLIBLogic getLogicFromString(const vstring& str);
 
+private:
+
+  static const char * s_smtlibLogicNameStrings[];
+
   /**
    * Have we seen "set-logic" entry yet?
    */
@@ -274,6 +285,8 @@ private:
   TermAlgebraConstructor* buildTermAlgebraConstructor(vstring constrName, unsigned taSort,
                                                       Stack<vstring> destructorNames, Stack<unsigned> argSorts);
 
+  static bool sameTermAlgebraConstructors(TermAlgebra* ta, const Stack<TermAlgebraConstructor*>& constructors);
+
   /**
    * Parse result of parsing an smtlib term (which can be of sort Bool and therefore represented in vampire by a formula)
    */
@@ -430,6 +443,67 @@ private:
    */
   UnitList* _formulas;
 
+  /**
+   * Are we collecting all the "check-sat" queries of an incremental benchmark
+   * or stopping at the first one?
+   */
+  bool _incremental;
+
+  /**
+   * A level of the assertion stack opened by "push".
+   *
+   * As units are pushed to the front of _formulas, popping a level
+   * amounts to restoring the list head from the time of the corresponding "push".
+   * Function symbols declared within the level are removed from _declaredFunctions
+   * (the vampire symbols stay in the signature, but can no longer be referred to)
+   * and sorts declared or defined within it from _declaredSorts and _sortDefinitions.
+   */
+  struct AssertionLevel {
+    AssertionLevel() : formulas(nullptr), declarationCnt(0), sortDeclarationCnt(0) {}
+    AssertionLevel(UnitList* formulas, unsigned declarationCnt, unsigned sortDeclarationCnt)
+     : formulas(formulas), declarationCnt(declarationCnt), sortDeclarationCnt(sortDeclarationCnt) {}
+
+    UnitList* formulas;
+    /** length of _declarationTrail at the time of "push" */
+    unsigned declarationCnt;
+    /** length of _sortDeclarationTrail at the time of "push" */
+    unsigned sortDeclarationCnt;
+  };
+
+  Stack<AssertionLevel> _assertionLevels;
+
+  /**
+   * Names of function symbols in the order of their declaration,
+   * only recorded while there is an open assertion level.
+   */
+  Stack<vstring> _declarationTrail;
+
+  /**
+   * Names of declared and defined sorts (including datatypes) in the order
+   * of their declaration, only recorded while there is an open assertion level.
+   */
+  Stack<vstring> _sortDeclarationTrail;
+
+  /**
+   * Snapshots of _formulas taken at the "check-sat" entries.
+   */
+  Stack<UnitList*> _checkSatQueries;
+
+  /**
+   * Handle "push" entry.
+   */
+  void readPush(unsigned levels);
+
+  /**
+   * Handle "pop" entry.
+   */
+  void readPop(unsigned levels);
+
+  /**
+   * Read the optional numeral argument of "push" and "pop" (which defaults to 1).
+   */
+  unsigned readLevelCount(LispListReader& rdr, const vstring& entry);
+
   /**
    * To support a mechanism for dealing with large arithmetic constants.
    * Adapted from the tptp parser.
@@ -296,5 +296,67 @@ void GrowingClauseDisposer::onRestart()
 
 }
 
+///////////////////////////
+// LBDClauseDisposer
+
+void LBDClauseDisposer::onClauseInConflict(SATClause* cl)
+{
+  CALL("LBDClauseDisposer::onClauseInConflict");
+
+  DecayingClauseDisposer::onClauseInConflict(cl);
+  cl->setUsed(true);
+}
+
+void LBDClauseDisposer::onConflict()
+{
+  CALL("LBDClauseDisposer::onConflict");
+
+  DecayingClauseDisposer::onConflict();
+  _phaseIdx++;
+}
+
+void LBDClauseDisposer::onSafeSpot()
+{
+  CALL("LBDClauseDisposer::onSafeSpot");
+
+  if(_phaseIdx<_phaseLen) {
+    return;
+  }
+  _phaseIdx = 0;
+  _phaseLen += _phaseIncrease;
+
+  markAllRemovableUnkept();
+
+  //the least active clauses of the local tier get popped first
+  static BinaryHeap<SATClause*, ClauseActivityComparator> localTier;
+  localTier.reset();
+
+  SATClauseStack::Iterator lrnIt(getLearntStack());
+  while(lrnIt.hasNext()) {
+    SATClause* cl = lrnIt.next();
+    bool used = cl->used();
+    cl->setUsed(false);
+    if(cl->kept()) {
+      //used as a premise of the current assignment
+      continue;
+    }
+    if(cl->lbd()<=CORE_LBD || (cl->lbd()<=TIER2_LBD && used)) {
+      cl->setKept(true);
+      continue;
+    }
+    localTier.insert(cl);
+  }
+
+  size_t removedCnt = localTier.size()/2;
+  for(size_t i=0; i<removedCnt; i++) {
+    localTier.pop();
+  }
+  while(!localTier.isEmpty()) {
+    localTier.pop()->setKept(true);
+  }
+  keepBinary();
+
+  removeUnkept();
+}
 
 }
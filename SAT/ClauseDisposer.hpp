@@ -175,6 +175,42 @@ protected:
   size_t _survivorCnt;
 };
 
+/**
+ * Performs learnt clause disposal based on the literal block distance (LBD)
+ *
+ * Learnt clauses are divided into three tiers. Clauses with LBD at most
+ * @c CORE_LBD are kept forever. Clauses with LBD at most @c TIER2_LBD are
+ * kept as long as they take part in some conflict between two successive
+ * removals. Of the remaining clauses we remove the less active half.
+ *
+ * Removal is performed at the first safe spot after @c _phaseLen conflicts.
+ * The length of successive phases is increased by @c _phaseIncrease.
+ *
+ * "Gilles Audemard, Laurent Simon, Predicting Learnt Clauses Quality in
+ * Modern SAT Solvers, 2009"
+ */
+class LBDClauseDisposer : public DecayingClauseDisposer
+{
+public:
+  CLASS_NAME(LBDClauseDisposer);
+  USE_ALLOCATOR(LBDClauseDisposer);
+
+  static const unsigned CORE_LBD = 2;
+  static const unsigned TIER2_LBD = 6;
+
+  LBDClauseDisposer(TWLSolver& solver, ActivityType decayFactor = 1.001f)
+   : DecayingClauseDisposer(solver, decayFactor), _phaseIdx(0), _phaseLen(2000), _phaseIncrease(300) {}
+
+  virtual void onClauseInConflict(SATClause* cl);
+  virtual void onSafeSpot();
+  virtual void onConflict();
+protected:
+
+  size_t _phaseIdx;
+  size_t _phaseLen;
+  size_t _phaseIncrease;
+};
+
 }
 
 #endif // __ClauseDisposer__
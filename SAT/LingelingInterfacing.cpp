@@ -0,0 +1,285 @@
+/*
+ * File LingelingInterfacing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LingelingInterfacing.cpp
+ * Implements class LingelingInterfacing
+ */
+
+#include <cstdlib>
+#include <climits>
+
+#include "Forwards.hpp"
+
+#include "Lib/System.hpp"
+#include "Lib/Environment.hpp"
+#include "Shell/UIHelper.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "LingelingInterfacing.hpp"
+
+namespace SAT
+{
+
+using namespace Shell;
+using namespace Lib;
+
+/*
+ * Memory manager passed to Lingeling. Lingeling allocates outside of our
+ * allocator (as Minisat does), we only report running out of memory
+ * in the usual way instead of letting Lingeling abort.
+ */
+
+static void* lglAlloc(void*, size_t bytes)
+{
+  void* res = malloc(bytes);
+  if (!res && bytes) {
+    LingelingInterfacing::reportLingelingOutOfMemory();
+  }
+  return res;
+}
+
+static void* lglRealloc(void*, void* ptr, size_t, size_t bytes)
+{
+  void* res = realloc(ptr, bytes);
+  if (!res && bytes) {
+    LingelingInterfacing::reportLingelingOutOfMemory();
+  }
+  return res;
+}
+
+static void lglDealloc(void*, void* ptr, size_t)
+{
+  free(ptr);
+}
+
+/*
+ * Termination callback of Lingeling. It cannot be interrupted by an
+ * exception, so it is only told to stop and the time limit is dealt
+ * with when lglsat returns.
+ */
+static int lglTimeLimitReached(void*)
+{
+  return env.timeLimitReached();
+}
+
+LingelingInterfacing::LingelingInterfacing(const Shell::Options& opts, bool generateProofs)
+: _status(SATISFIABLE), _varCnt(0), _freezeVars(true), _modelSize(0)
+{
+  CALL("LingelingInterfacing::LingelingInterfacing");
+
+  _solver = lglminit(0, lglAlloc, lglRealloc, lglDealloc);
+  // Lingeling reports nothing unless asked to, but be sure
+  lglsetopt(_solver, "verbose", -1);
+  lglsetopt(_solver, "seed", opts.randomSeed());
+  lglseterm(_solver, lglTimeLimitReached, 0);
+}
+
+LingelingInterfacing::~LingelingInterfacing()
+{
+  CALL("LingelingInterfacing::~LingelingInterfacing");
+
+  lglrelease(_solver);
+}
+
+void LingelingInterfacing::reportLingelingOutOfMemory()
+{
+  env.beginOutput();
+  reportSpiderStatus('m');
+  env.out() << "Lingeling ran out of memory" << endl;
+  if(env.statistics) {
+    env.statistics->print(env.out());
+  }
+#if VDEBUG
+  Debug::Tracer::printStack(env.out());
+#endif
+  env.endOutput();
+  System::terminateImmediately(1);
+}
+
+/**
+ * Make the solver handle clauses with variables up to @b newVarCnt
+ */
+void LingelingInterfacing::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("LingelingInterfacing::ensureVarCount");
+
+  while(_varCnt < newVarCnt) {
+    newVar();
+  }
+}
+
+unsigned LingelingInterfacing::newVar()
+{
+  CALL("LingelingInterfacing::newVar");
+  ASS_L(_varCnt,(unsigned)INT_MAX);
+
+  unsigned var = ++_varCnt;
+  if (_freezeVars) {
+    // also makes Lingeling aware of the variable
+    lglfreeze(_solver, (int)var);
+  }
+  return var;
+}
+
+void LingelingInterfacing::addClause(SATClause* cl)
+{
+  CALL("LingelingInterfacing::addClause");
+
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  ASS(!hasAssumptions());
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    lgladd(_solver, vampireLit2Lingeling((*cl)[i]));
+  }
+  lgladd(_solver, 0);
+}
+
+void LingelingInterfacing::addClauseLiterals(const SATLiteralStack& lits)
+{
+  CALL("LingelingInterfacing::addClauseLiterals");
+  ASS(!hasAssumptions());
+
+  for(unsigned i=0;i<lits.size();i++) {
+    lgladd(_solver, vampireLit2Lingeling(lits[i]));
+  }
+  lgladd(_solver, 0);
+}
+
+void LingelingInterfacing::addAssumption(SATLiteral lit)
+{
+  CALL("LingelingInterfacing::addAssumption");
+
+  _assumptions.push(lit);
+}
+
+/**
+ * Solve modulo assumptions and set status.
+ *
+ * Lingeling forgets the assumptions after each call, so they are
+ * passed to it again every time.
+ */
+void LingelingInterfacing::solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solveModuloAssumptionsAndSetStatus");
+
+  SATLiteralStack::Iterator it(_assumptions);
+  while (it.hasNext()) {
+    lglassume(_solver, vampireLit2Lingeling(it.next()));
+  }
+
+  // negative value means no limit
+  lglsetopt(_solver, "clim", conflictCountLimit == UINT_MAX ? -1 : (int)min(conflictCountLimit,(unsigned)INT_MAX));
+
+  int res = lglsat(_solver);
+  if (res == LGL_UNKNOWN) {
+    env.timeSafePoint();
+  }
+  if (res == LGL_SATISFIABLE) {
+    _status = SATISFIABLE;
+    storeModel();
+  } else if (res == LGL_UNSATISFIABLE) {
+    _status = UNSATISFIABLE;
+  } else {
+    _status = UNKNOWN;
+  }
+}
+
+void LingelingInterfacing::storeModel()
+{
+  CALL("LingelingInterfacing::storeModel");
+
+  _model.ensure(_varCnt+1);
+  _modelSize = _varCnt;
+  for (unsigned var = 1; var <= _varCnt; var++) {
+    int val = lglderef(_solver, (int)var);
+    _model[var] = val > 0 ? TRUE : val < 0 ? FALSE : DONT_CARE;
+  }
+}
+
+SATSolver::Status LingelingInterfacing::solve(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solve");
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+  return _status;
+}
+
+SATSolver::Status LingelingInterfacing::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("LingelingInterfacing::solveUnderAssumptions");
+
+  ASS(!hasAssumptions());
+
+  _assumptions.loadFromIterator(SATLiteralStack::ConstIterator(assumps));
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+
+  if (_status == SATSolver::UNSATISFIABLE) {
+    _failedAssumptionBuffer.reset();
+    if (!lglinconsistent(_solver)) {
+      SATLiteralStack::Iterator it(_assumptions);
+      while (it.hasNext()) {
+        SATLiteral lit = it.next();
+        if (lglfailed(_solver, vampireLit2Lingeling(lit))) {
+          _failedAssumptionBuffer.push(lit);
+        }
+      }
+    }
+  }
+
+  _assumptions.reset();
+
+  return _status;
+}
+
+SATSolver::VarAssignment LingelingInterfacing::getAssignment(unsigned var)
+{
+  CALL("LingelingInterfacing::getAssignment");
+  ASS_EQ(_status, SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if (var > _modelSize) { // new vars have been added but the model didn't grow yet
+    return DONT_CARE;
+  }
+  return _model[var];
+}
+
+bool LingelingInterfacing::isZeroImplied(unsigned var)
+{
+  CALL("LingelingInterfacing::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  return lglfixed(_solver, (int)var) != 0;
+}
+
+void LingelingInterfacing::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("LingelingInterfacing::collectZeroImplied");
+
+  for (unsigned var = 1; var <= _varCnt; var++) {
+    int val = lglfixed(_solver, (int)var);
+    if (val) {
+      acc.push(SATLiteral(var, val > 0 ? 1 : 0));
+    }
+  }
+}
+
+} // namespace SAT
@@ -0,0 +1,156 @@
+/*
+ * File LingelingInterfacing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LingelingInterfacing.hpp
+ * Defines class LingelingInterfacing
+ */
+#ifndef __LingelingInterfacing__
+#define __LingelingInterfacing__
+
+#include "Lib/DArray.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+extern "C" {
+#include "lglib.h"
+}
+
+namespace SAT{
+
+/**
+ * Interface to the Lingeling SAT solver
+ *
+ * Lingeling may eliminate variables during inprocessing, after which
+ * they cannot appear in new clauses or assumptions. By default all
+ * variables are therefore frozen when allocated, which keeps the solver
+ * fully incremental. A user that adds all clauses before the first call
+ * to solve can call @b allowVariableElimination() instead.
+ */
+class LingelingInterfacing : public PrimitiveProofRecordingSATSolver
+{
+public:
+  CLASS_NAME(LingelingInterfacing);
+  USE_ALLOCATOR(LingelingInterfacing);
+
+  LingelingInterfacing(const Shell::Options& opts, bool generateProofs=false);
+  virtual ~LingelingInterfacing();
+
+  /**
+   * Can be called only when all assumptions are retracted
+   *
+   * A requirement is that in a clause, each variable occurs at most once.
+   */
+  virtual void addClause(SATClause* cl) override;
+
+  /**
+   * Add a clause given by its literals, without creating a SATClause
+   * (and without recording it for refutations)
+   */
+  virtual void addClauseLiterals(const SATLiteralStack& lits) override;
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  /**
+   * If status is @c SATISFIABLE, return assignment of variable @c var
+   */
+  virtual VarAssignment getAssignment(unsigned var) override;
+
+  /**
+   * Return true if the variable @c var is fixed on the top level
+   */
+  virtual bool isZeroImplied(unsigned var) override;
+  /**
+   * Collect zero-implied literals.
+   *
+   * @see isZeroImplied()
+   */
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  /**
+   * Not supported, 0 is returned.
+   */
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return 0; }
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+
+  virtual unsigned newVar() override;
+
+  virtual void suggestPolarity(unsigned var, unsigned pol) override {
+    lglsetphase(_solver, pol ? (int)var : -(int)var);
+  }
+
+  /**
+   * Add an assumption into the solver.
+   */
+  virtual void addAssumption(SATLiteral lit) override;
+
+  virtual void retractAllAssumptions() override {
+    _assumptions.reset();
+    _status = UNKNOWN;
+  };
+
+  virtual bool hasAssumptions() const override {
+    return _assumptions.isNonEmpty();
+  };
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {
+    // unsupported by lingeling; intentionally no-op
+  };
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+  /**
+   * Do not freeze the variables allocated from now on, so that
+   * Lingeling may eliminate them.
+   *
+   * No clause may then be added after a call to solve.
+   */
+  void allowVariableElimination() { _freezeVars = false; }
+
+  static void reportLingelingOutOfMemory();
+
+private:
+  void solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit);
+  void storeModel();
+
+  int vampireLit2Lingeling(SATLiteral lit) {
+    ASS_G(lit.var(),0); ASS_LE(lit.var(),_varCnt);
+    return lit.isPositive() ? (int)lit.var() : -(int)lit.var();
+  }
+
+  Status _status;
+  LGL* _solver;
+  /** number of variables allocated so far, they are 1.._varCnt */
+  unsigned _varCnt;
+  bool _freezeVars;
+  SATLiteralStack _assumptions;
+
+  /**
+   * Assignment of the last satisfiable call.
+   *
+   * Lingeling gives access to its model only until the next clause is added,
+   * while the SATSolver interface keeps it until the next call to solve.
+   */
+  DArray<VarAssignment> _model;
+  unsigned _modelSize;
+};
+
+}//end SAT namespace
+
+#endif /*__LingelingInterfacing__*/
@@ -43,7 +43,16 @@ using namespace Lib;
 using namespace Minisat;
 
 const unsigned MinisatInterfacingNewSimp::VAR_MAX = std::numeric_limits<Minisat::Var>::max() / 2;
-  
+
+/**
+ * Termination callback for Minisat, it is polled every few conflicts.
+ * The time limit itself is then dealt with when solveLimited returns.
+ */
+static int minisatTimeLimitReached(void*)
+{
+  return env.timeLimitReached();
+}
+
 MinisatInterfacingNewSimp::MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs):
   _status(SATISFIABLE)
 {
@@ -53,6 +62,7 @@ MinisatInterfacingNewSimp::MinisatInterfacingNewSimp(const Shell::Options& opts,
   // (or even forwarding them to vampire's options)  
   //_solver.mem_lim(opts.memoryLimit()*2);
   limitMemory(opts.memoryLimit()*1);
+  _solver.setTermCallback(minisatTimeLimitReached, 0);
 }
 
 void MinisatInterfacingNewSimp::reportMinisatOutOfMemory() {
@@ -137,6 +147,11 @@ void MinisatInterfacingNewSimp::solveModuloAssumptionsAndSetStatus(unsigned conf
 
     _solver.setConfBudget(conflictCountLimit); // treating UINT_MAX as \infty
     lbool res = _solver.solveLimited(_assumptions,true,true);
+    if (res == l_Undef) {
+      // the conflict budget ran out or the termination callback fired
+      _solver.clearInterrupt();
+      env.timeSafePoint();
+    }
 
     //cout << "After: vars " << bef - _solver.eliminated_vars << ", non-unit clauses " << _solver.nClauses() << endl;
   
@@ -179,6 +194,28 @@ void MinisatInterfacingNewSimp::addClause(SATClause* cl)
   }
 }
 
+/**
+ * Add clause given by its literals into the solver.
+ */
+void MinisatInterfacingNewSimp::addClauseLiterals(const SATLiteralStack& lits)
+{
+  CALL("MinisatInterfacingNewSimp::addClauseLiterals");
+
+  ASS_EQ(_assumptions.size(),0);
+
+  try {
+    static vec<Lit> mcl;
+    mcl.clear();
+
+    for(unsigned i=0;i<lits.size();i++) {
+      mcl.push(vampireLit2Minisat(lits[i]));
+    }
+    _solver.addClause(mcl);
+  } catch (Minisat::OutOfMemoryException&){
+      reportMinisatOutOfMemory();
+  }
+}
+
 /**
  * Perform solving and return status.
  */
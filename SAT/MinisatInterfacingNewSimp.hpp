@@ -52,6 +52,15 @@ public:
    * A requirement is that in a clause, each variable occurs at most once.
    */
   virtual void addClause(SATClause* cl) override;
+
+  /**
+   * Add a clause given by its literals, without creating a SATClause
+   *
+   * Can be called only when all assumptions are retracted.
+   * Unlike above, duplicate literals and complementary pairs are allowed
+   * (Minisat removes the former and drops the clause for the latter).
+   */
+  virtual void addClauseLiterals(const SATLiteralStack& lits) override;
   
   /**
    * Opportunity to perform in-processing of the clause database.
@@ -63,6 +72,31 @@ public:
     _solver.simplify();
   }
 
+  /**
+   * Switch off variable elimination, so that clauses over any variable
+   * can still be added after a call to solve.
+   *
+   * (Minisat otherwise eliminates variables during the first solve.)
+   */
+  void disableVariableElimination() {
+    CALL("MinisatInterfacingNewSimp::disableVariableElimination");
+    _solver.eliminate(true);
+  }
+
+  /**
+   * Make the search depend on @c seed: the initial variable activities
+   * are randomized and a small fraction of the decisions is random.
+   *
+   * Must be called before any variables are added.
+   */
+  void setRandomSeed(unsigned seed) {
+    CALL("MinisatInterfacingNewSimp::setRandomSeed");
+    // minisat needs a positive seed
+    _solver.random_seed = seed+1;
+    _solver.rnd_init_act = true;
+    _solver.random_var_freq = 0.02;
+  }
+
   virtual Status solve(unsigned conflictCountLimit) override;
   
   /**
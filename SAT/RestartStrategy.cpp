@@ -22,6 +22,7 @@
  */
 
 #include <math.h>
+#include <algorithm>
 
 #include "Debug/Assertion.hpp"
 #include "Debug/Tracer.hpp"
@@ -84,5 +85,27 @@ size_t MinisatRestartStrategy::getNextConflictCount()
   return _innerCnt;
 }
 
+/**
+ * Update exponential moving average @c avg with value @c val. While fewer
+ * than 1/alpha values were seen, compute the plain average instead, so that
+ * the average is not biased towards the initial zero.
+ */
+void GlucoseRestartStrategy::updateAverage(float& avg, float val, float alpha, size_t cnt)
+{
+  float weight = std::max(alpha, 1.0f/cnt);
+  avg += (val-avg)*weight;
+}
+
+bool GlucoseRestartStrategy::onConflict(unsigned learntLbd)
+{
+  CALL("GlucoseRestartStrategy::onConflict");
+
+  _conflictCnt++;
+  _sinceRestart++;
+  updateAverage(_fastAvg, learntLbd, 1.0f/32, _conflictCnt);
+  updateAverage(_slowAvg, learntLbd, 1.0f/4096, _conflictCnt);
+
+  return _sinceRestart>=_minConflicts && _fastAvg > _margin*_slowAvg;
+}
 
 }
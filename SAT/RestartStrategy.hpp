@@ -35,6 +35,13 @@ public:
   virtual size_t getNextConflictCount() = 0;
   virtual void reset() = 0;
 
+  /**
+   * Called after each conflict with the literal block distance of the
+   * learnt clause. Return true if the solver should restart as soon as
+   * possible, regardless of the conflict count.
+   */
+  virtual bool onConflict(unsigned learntLbd) { return false; }
+
 protected:
   static size_t increase(size_t val, float quotient);
 };
@@ -129,6 +136,48 @@ private:
   float _increase;
 };
 
+/**
+ * Dynamic restarts in the style of Glucose
+ *
+ * We keep a fast and a slow moving average of the literal block distance
+ * of learnt clauses. When the recently learnt clauses are notably worse
+ * than the long term average (the fast average exceeds the slow one
+ * multiplied by @c margin), the solver is probably in a bad part of the
+ * search space and we restart. At least @c minConflicts conflicts must
+ * pass between two restarts.
+ *
+ * "Gilles Audemard, Laurent Simon, Refining Restarts Strategies for SAT
+ * and UNSAT, 2012"
+ */
+class GlucoseRestartStrategy : public RestartStrategy {
+public:
+  CLASS_NAME(GlucoseRestartStrategy);
+  USE_ALLOCATOR(GlucoseRestartStrategy);
+
+  GlucoseRestartStrategy(size_t minConflicts = 50, float margin=1.25f)
+  : _minConflicts(minConflicts), _margin(margin), _conflictCnt(0),
+    _fastAvg(0), _slowAvg(0), _sinceRestart(0) {}
+
+  /** Restarts are triggered only by @c onConflict() */
+  virtual size_t getNextConflictCount() { _sinceRestart = 0; return static_cast<size_t>(-1); }
+  /**
+   * The averages are kept between calls to the solver, as they
+   * describe the clauses in the solver rather than the current call.
+   */
+  virtual void reset() { _sinceRestart = 0; }
+  virtual bool onConflict(unsigned learntLbd);
+private:
+  static void updateAverage(float& avg, float val, float alpha, size_t cnt);
+
+  size_t _minConflicts;
+  float _margin;
+
+  size_t _conflictCnt;
+  float _fastAvg;
+  float _slowAvg;
+  size_t _sinceRestart;
+};
+
 }
 
 #endif // __RestartStrategy__
@@ -37,6 +37,7 @@
 #include "Shell/Statistics.hpp"
 
 #include "SATInference.hpp"
+#include "SATClauseArena.hpp"
 
 #include "SATClause.hpp"
 
@@ -71,7 +72,7 @@ void* SATClause::operator new(size_t sz,unsigned lits)
 }
 
 SATClause::SATClause(unsigned length,bool kept)
-  : _activity(0), _length(length), _kept(kept?1:0), _nonDestroyable(0), _inference(0)
+  : _activity(0), _length(length), _kept(kept?1:0), _nonDestroyable(0), _inArena(0), _dead(0), _lbd(0), _used(0), _inference(0)
 //      , _genCounter(0xFFFFFFFF)
 {
   env.statistics->satClauses++;
@@ -103,6 +104,13 @@ void SATClause::destroy()
   if(_inference) {
     delete _inference;
   }
+
+  if(_inArena) {
+    //the memory is reclaimed by SATClauseArena::compact()
+    _inference = 0;
+    _dead = 1;
+    return;
+  }
   
   //We have to get sizeof(SATClause) + (_length-1)*sizeof(SATLiteral*)
   //this way, because _length-1 wouldn't behave well for
@@ -185,6 +193,27 @@ SATClause* SATClause::fromStack(SATLiteralStack& stack)
   return rcl;
 }
 
+/**
+ * Create a clause from @c stack in the given @c arena
+ */
+SATClause* SATClause::fromStack(SATLiteralStack& stack, SATClauseArena& arena)
+{
+  CALL("SATClause::fromStack/2");
+
+  unsigned clen = stack.size();
+  SATClause* rcl=arena.allocate(clen);
+
+  SATLiteralStack::BottomFirstIterator it(stack);
+
+  unsigned i=0;
+  while(it.hasNext()) {
+    (*rcl)[i]=it.next();
+    i++;
+  }
+  ASS_EQ(i, clen);
+  return rcl;
+}
+
 SATClause* SATClause::copy(SATClause* cl)
 {
   CALL("SATClause::copy");
@@ -53,6 +53,7 @@ using namespace Kernel;
  */
 class SATClause
 {
+  friend class SATClauseArena;
 public:
   DECL_ELEMENT_TYPE(SATLiteral);
 
@@ -88,6 +89,18 @@ public:
   inline void makeKept() { _kept=true; }
   inline void setKept(bool kept) { _kept=kept; }
 
+  /**
+   * Literal block distance (number of distinct decision levels) of a learnt
+   * clause at the time it was learnt or last took part in a conflict,
+   * or 0 for clauses that were not learnt by the TWLSolver
+   */
+  inline unsigned lbd() const { return _lbd; }
+  inline void setLbd(unsigned lbd) { _lbd=lbd; }
+
+  /** True if the clause took part in a conflict since the last clause disposal */
+  inline bool used() const { return _used; }
+  inline void setUsed(bool used) { _used=used; }
+
   /** Return a pointer to the array of literals. */
   inline SATLiteral* literals() { return _literals; }
 
@@ -126,6 +139,7 @@ public:
   static SATClause* fromFOClause(NamingContext& context, Clause* clause);
 
   static SATClause* fromStack(SATLiteralStack& stack);
+  static SATClause* fromStack(SATLiteralStack& stack, SATClauseArena& arena);
 
   static SATClause* copy(SATClause* cl);
 
@@ -135,12 +149,19 @@ protected:
   ActivityType _activity;
 
   /** number of literals */
-  unsigned _length : 30;
+  unsigned _length : 28;
 
   unsigned _kept : 1;
   unsigned _nonDestroyable : 1;
+  /** the clause was allocated by a SATClauseArena */
+  unsigned _inArena : 1;
+  /** an arena clause that was destroyed, its memory awaits compaction */
+  unsigned _dead : 1;
 //  unsigned _genCounter;
 
+  unsigned _lbd : 31;
+  unsigned _used : 1;
+
   SATInference* _inference;
 
 
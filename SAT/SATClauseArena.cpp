@@ -0,0 +1,219 @@
+/*
+ * File SATClauseArena.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SATClauseArena.cpp
+ * Implements class SATClauseArena.
+ */
+
+#include <cstring>
+#include <new>
+#include <algorithm>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "SATClause.hpp"
+
+#include "SATClauseArena.hpp"
+
+namespace SAT
+{
+
+SATClauseArena::~SATClauseArena()
+{
+  CALL("SATClauseArena::~SATClauseArena");
+
+  while(_chunks.isNonEmpty()) {
+    releaseChunk(_chunks.pop());
+  }
+  while(_pinnedChunks.isNonEmpty()) {
+    releaseChunk(_pinnedChunks.pop());
+  }
+  while(_holes.isNonEmpty()) {
+    Stack<char*>* lenHoles = _holes.pop();
+    if(lenHoles) {
+      delete lenHoles;
+    }
+  }
+}
+
+/**
+ * Return the number of bytes a clause of length @c length occupies
+ * in the arena, so that the next clause is properly aligned.
+ */
+size_t SATClauseArena::clauseSize(unsigned length)
+{
+  //see SATClause::operator new
+  size_t size = sizeof(SATClause);
+  if(length>0) {
+    size += (length-1)*sizeof(SATLiteral);
+  }
+  size_t align = sizeof(void*);
+  return (size+align-1)/align*align;
+}
+
+void* SATClauseArena::allocateRaw(size_t size)
+{
+  CALL("SATClauseArena::allocateRaw");
+
+  if(_chunks.isEmpty() || _chunks.top().used+size > _chunks.top().size) {
+    size_t chunkSize = std::max(_chunkSize, size);
+    char* mem = static_cast<char*>(ALLOC_KNOWN(chunkSize,"SATClauseArena::Chunk"));
+    _chunks.push(Chunk(mem, chunkSize));
+    _size += chunkSize;
+  }
+  Chunk& ch = _chunks.top();
+  void* res = ch.mem+ch.used;
+  ch.used += size;
+  return res;
+}
+
+void SATClauseArena::releaseChunk(const Chunk& ch)
+{
+  CALL("SATClauseArena::releaseChunk");
+
+  DEALLOC_KNOWN(ch.mem, ch.size, "SATClauseArena::Chunk");
+}
+
+/**
+ * Create a new clause of length @c length in the arena
+ */
+SATClause* SATClauseArena::allocate(unsigned length)
+{
+  CALL("SATClauseArena::allocate");
+
+  void* mem;
+  if(length<_holes.size() && _holes[length] && _holes[length]->isNonEmpty()) {
+    //the place of a dead clause of the same length in a pinned chunk
+    mem = _holes[length]->pop();
+  }
+  else {
+    mem = allocateRaw(clauseSize(length));
+  }
+  SATClause* res = ::new(mem) SATClause(length);
+  res->_inArena = 1;
+  return res;
+}
+
+/**
+ * Return true if chunk @c ch contains a clause that was not destroyed
+ */
+bool SATClauseArena::hasLiveClause(const Chunk& ch)
+{
+  CALL("SATClauseArena::hasLiveClause");
+
+  size_t ofs = 0;
+  while(ofs<ch.used) {
+    SATClause* cl = reinterpret_cast<SATClause*>(ch.mem+ofs);
+    if(!cl->_dead) {
+      return true;
+    }
+    ofs += clauseSize(cl->length());
+  }
+  return false;
+}
+
+/**
+ * Add the places of the dead clauses in chunk @c ch to the holes
+ */
+void SATClauseArena::collectHoles(const Chunk& ch)
+{
+  CALL("SATClauseArena::collectHoles");
+
+  size_t ofs = 0;
+  while(ofs<ch.used) {
+    SATClause* cl = reinterpret_cast<SATClause*>(ch.mem+ofs);
+    unsigned length = cl->length();
+    if(cl->_dead) {
+      while(_holes.size()<=length) {
+        _holes.push(0);
+      }
+      if(!_holes[length]) {
+        _holes[length] = new Stack<char*>();
+      }
+      _holes[length]->push(ch.mem+ofs);
+    }
+    ofs += clauseSize(length);
+  }
+}
+
+/**
+ * Move the clauses on the stack @c live into fresh chunks and release
+ * the chunks with no live clauses in them.
+ *
+ * The clauses in @c live are replaced by their new copies, and each
+ * moved clause is mapped to its copy in @c relocated. Clauses on
+ * @c live that are not in the arena or are non-destroyable stay where
+ * they are. All other clauses of the arena must be dead.
+ *
+ * The chunks that still contain some (non-destroyable) clauses are kept,
+ * and the places of the dead clauses in them are reused by allocate().
+ */
+void SATClauseArena::compact(SATClauseStack& live, DHMap<SATClause*,SATClause*>& relocated)
+{
+  CALL("SATClauseArena::compact");
+
+  static Stack<Chunk> oldChunks;
+  oldChunks.reset();
+  while(_chunks.isNonEmpty()) {
+    Chunk ch = _chunks.pop();
+    _size -= ch.size;
+    oldChunks.push(ch);
+  }
+  while(_pinnedChunks.isNonEmpty()) {
+    Chunk ch = _pinnedChunks.pop();
+    _size -= ch.size;
+    oldChunks.push(ch);
+  }
+  //the holes are collected again from the chunks that stay
+  for(unsigned i=0; i<_holes.size(); i++) {
+    if(_holes[i]) {
+      _holes[i]->reset();
+    }
+  }
+
+  unsigned liveCnt = live.size();
+  for(unsigned i=0; i<liveCnt; i++) {
+    SATClause* cl = live[i];
+    if(!cl->_inArena || cl->_nonDestroyable) {
+      continue;
+    }
+    ASS(!cl->_dead);
+    size_t size = clauseSize(cl->length());
+    SATClause* moved = static_cast<SATClause*>(allocateRaw(size));
+    memcpy(static_cast<void*>(moved), cl, size);
+    //the copy now owns the inference
+    cl->_dead = 1;
+    relocated.insert(cl, moved);
+    live[i] = moved;
+  }
+
+  while(oldChunks.isNonEmpty()) {
+    Chunk ch = oldChunks.pop();
+    if(hasLiveClause(ch)) {
+      _pinnedChunks.push(ch);
+      _size += ch.size;
+      collectHoles(ch);
+    }
+    else {
+      releaseChunk(ch);
+    }
+  }
+}
+
+}
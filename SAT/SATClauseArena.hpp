@@ -0,0 +1,102 @@
+/*
+ * File SATClauseArena.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SATClauseArena.hpp
+ * Defines class SATClauseArena.
+ */
+
+#ifndef __SATClauseArena__
+#define __SATClauseArena__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+/**
+ * Contiguous storage for SAT clauses with a short lifetime, such as
+ * the learnt clauses of a SAT solver.
+ *
+ * Clauses are allocated one after another in large chunks. Calling
+ * @b SATClause::destroy() on such clause only marks it as dead, the memory
+ * is reclaimed by @b compact(), which moves the live clauses into fresh
+ * chunks. The owner of the arena must then redirect its pointers to the
+ * moved clauses.
+ *
+ * Clauses that are non-destroyable (i.e. they are premises in a proof) are
+ * never moved, as we do not know who points to them. The chunks they are
+ * in are kept, and the places of the dead clauses in them are reused for
+ * new clauses of the same length.
+ */
+class SATClauseArena
+{
+public:
+  CLASS_NAME(SATClauseArena);
+  USE_ALLOCATOR(SATClauseArena);
+
+  SATClauseArena(size_t chunkSize = 1<<20)
+  : _chunkSize(chunkSize), _size(0) {}
+  ~SATClauseArena();
+
+  SATClause* allocate(unsigned length);
+
+  /** Number of bytes occupied by the arena */
+  size_t size() const { return _size; }
+
+  void compact(SATClauseStack& live, DHMap<SATClause*,SATClause*>& relocated);
+
+private:
+  struct Chunk
+  {
+    Chunk() {}
+    Chunk(char* mem, size_t size) : mem(mem), size(size), used(0) {}
+
+    char* mem;
+    size_t size;
+    /** number of bytes at the beginning of the chunk occupied by clauses */
+    size_t used;
+  };
+
+  static size_t clauseSize(unsigned length);
+  void* allocateRaw(size_t size);
+  bool hasLiveClause(const Chunk& ch);
+  void collectHoles(const Chunk& ch);
+  void releaseChunk(const Chunk& ch);
+
+  /** Chunks we allocate in, the current one is on the top */
+  Stack<Chunk> _chunks;
+  /** Chunks with non-destroyable clauses, other clauses are allocated in their holes */
+  Stack<Chunk> _pinnedChunks;
+  /**
+   * Places of dead clauses in the pinned chunks, by the clause length.
+   * Recomputed by each compact().
+   */
+  Stack<Stack<char*>*> _holes;
+
+  size_t _chunkSize;
+  size_t _size;
+};
+
+}
+
+#endif // __SATClauseArena__
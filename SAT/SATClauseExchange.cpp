@@ -0,0 +1,87 @@
+/*
+ * File SATClauseExchange.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SATClauseExchange.cpp
+ * Implements class SATClauseExchange.
+ */
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "SATClause.hpp"
+
+#include "SATClauseExchange.hpp"
+
+namespace SAT
+{
+
+SATClauseExchange::SATClauseExchange(unsigned capacity)
+: _ring(MAX_LENGTH, capacity)
+{
+  CALL("SATClauseExchange::SATClauseExchange");
+}
+
+/**
+ * Set the index of the current worker. To be called in each
+ * worker process before it starts publishing clauses.
+ */
+void SATClauseExchange::setWorker(unsigned worker)
+{
+  CALL("SATClauseExchange::setWorker");
+
+  _ring.setWorker(worker);
+}
+
+/**
+ * Make clause @c cl available to the other workers
+ */
+void SATClauseExchange::publish(SATClause* cl)
+{
+  CALL("SATClauseExchange::publish");
+  ASS_LE(cl->length(),MAX_LENGTH);
+
+  unsigned words[MAX_LENGTH];
+  unsigned len = cl->length();
+  for(unsigned i=0; i<len; i++) {
+    words[i] = (*cl)[i].content();
+  }
+  _ring.publish(words, len);
+}
+
+/**
+ * If there is a clause published by another worker that the current one
+ * has not consumed yet, put its literals into @c lits and return true.
+ * Otherwise return false.
+ */
+bool SATClauseExchange::consume(SATLiteralStack& lits)
+{
+  CALL("SATClauseExchange::consume");
+
+  static Stack<unsigned> words;
+  if(!_ring.consume(words)) {
+    return false;
+  }
+  lits.reset();
+  Stack<unsigned>::BottomFirstIterator wit(words);
+  while(wit.hasNext()) {
+    lits.push(SATLiteral(wit.next()));
+  }
+  return true;
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * File SATClauseExchange.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SATClauseExchange.hpp
+ * Defines class SATClauseExchange.
+ */
+
+#ifndef __SATClauseExchange__
+#define __SATClauseExchange__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Sys/SharedRing.hpp"
+
+#include "SATLiteral.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+/**
+ * Exchange of short clauses between SAT solvers running in forked
+ * processes on the same set of variables.
+ *
+ * The clauses are kept in a Sys::SharedRing, so they are exchanged among
+ * all processes forked after the object was created.
+ */
+class SATClauseExchange
+{
+public:
+  CLASS_NAME(SATClauseExchange);
+  USE_ALLOCATOR(SATClauseExchange);
+
+  /** Longest clause that can be exchanged */
+  static const unsigned MAX_LENGTH = 8;
+
+  SATClauseExchange(unsigned capacity = 1<<15);
+
+  void setWorker(unsigned worker);
+
+  void publish(SATClause* cl);
+  bool consume(SATLiteralStack& lits);
+
+private:
+  Sys::SharedRing _ring;
+};
+
+}
+
+#endif // __SATClauseExchange__
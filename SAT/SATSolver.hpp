@@ -24,6 +24,9 @@
 #ifndef __SATSolver__
 #define __SATSolver__
 
+#include "Lib/Exception.hpp"
+
+#include "SATClause.hpp"
 #include "SATLiteral.hpp"
 #include "SATInference.hpp"
 
@@ -58,6 +61,19 @@ public:
    */
   virtual void addClause(SATClause* cl) = 0;
 
+  /**
+   * Add a clause given by its literals.
+   *
+   * Solvers which copy the clause into their own representation override
+   * this to avoid creating a SATClause, the clause is then not recorded
+   * for refutations. By default a SATClause is created and passed to
+   * addClause(), which does not take its ownership.
+   */
+  virtual void addClauseLiterals(const SATLiteralStack& lits) {
+    CALL("SATSolver::addClauseLiterals");
+    addClause(SATClause::fromStack(const_cast<SATLiteralStack&>(lits)));
+  }
+
   void addClausesIter(SATClauseIterator cit) {
     CALL("SATSolver::addClauses");
     while (cit.hasNext()) {
@@ -22,6 +22,8 @@
  */
 
 
+#include <algorithm>
+
 #include "Debug/Assertion.hpp"
 
 #include "Lib/TimeCounter.hpp"
@@ -37,6 +39,7 @@
 #include "Shell/Statistics.hpp"
 
 #include "SATClause.hpp"
+#include "SATClauseExchange.hpp"
 #include "SATInference.hpp"
 #include "SATLiteral.hpp"
 
@@ -64,9 +67,13 @@ namespace SAT
 
 using namespace Lib;
 
+/** The learnt clause arena is not compacted while smaller than this (in bytes) */
+static const size_t MIN_LEARNT_ARENA_LIMIT = 4*1024*1024;
+
 TWLSolver::TWLSolver(const Options& opt, bool generateProofs)
 : _generateProofs(generateProofs), _status(SATISFIABLE), _assignment(0), _assignmentLevels(0),
-_windex(0), _varCnt(0), _level(1), _assumptionsAdded(false), _assumptionCnt(0), _unsatisfiableAssumptions(false)
+_windex(0), _varCnt(0), _level(1), _assumptionsAdded(false), _assumptionCnt(0), _unsatisfiableAssumptions(false),
+_learntArenaLimit(MIN_LEARNT_ARENA_LIMIT), _exchange(0)
 {
   switch(opt.satVarSelector()) {
   case Options::SatVarSelector::ACTIVE:
@@ -97,6 +104,9 @@ _windex(0), _varCnt(0), _level(1), _assumptionsAdded(false), _assumptionCnt(0),
   case Options::SatRestartStrategy::MINISAT:
     _restartStrategy = new MinisatRestartStrategy(opt.satRestartMinisatInit(), opt.satRestartMinisatIncrease());
     break;
+  case Options::SatRestartStrategy::GLUCOSE:
+    _restartStrategy = new GlucoseRestartStrategy(opt.satRestartGlucoseMinConflicts(), opt.satRestartGlucoseMargin());
+    break;
   }
 
   switch(opt.satClauseDisposer()) {
@@ -106,6 +116,9 @@ _windex(0), _varCnt(0), _level(1), _assumptionsAdded(false), _assumptionCnt(0),
   case Options::SatClauseDisposer::MINISAT:
     _clauseDisposer = new MinisatClauseDisposer(*this, opt.satVarActivityDecay());
     break;
+  case Options::SatClauseDisposer::LBD:
+    _clauseDisposer = new LBDClauseDisposer(*this, opt.satVarActivityDecay());
+    break;
   }
 
   _doLearntMinimization = opt.satLearntMinimization();
@@ -657,6 +670,34 @@ bool TWLSolver::isRedundant(SATLiteral lit, ArraySet& seenVars, SATClauseList*&
   return true;
 }
 
+/**
+ * Return the literal block distance of @c cl, i.e. the number of distinct
+ * decision levels among its assigned literals.
+ */
+unsigned TWLSolver::computeLbd(SATClause* cl)
+{
+  CALL("TWLSolver::computeLbd");
+
+  static ArraySet seenLevels;
+  seenLevels.ensure(_level+1);
+  seenLevels.reset();
+
+  unsigned res = 0;
+  unsigned clen = cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    SATLiteral lit = (*cl)[i];
+    if(isUndefined(lit)) {
+      continue;
+    }
+    unsigned lev = getAssignmentLevel(lit);
+    if(!seenLevels.find(lev)) {
+      seenLevels.insert(lev);
+      res++;
+    }
+  }
+  return res;
+}
+
 SATClause* TWLSolver::getLearntClause(SATClause* conflictClause)
 {
   CALL("TWLSolver::getLearntClause");
@@ -681,6 +722,13 @@ SATClause* TWLSolver::getLearntClause(SATClause* conflictClause)
     if(_generateProofs) {
       SATClauseList::push(cl, premises);
     }
+    if(cl->lbd()>LBDClauseDisposer::CORE_LBD) {
+      //a learnt clause may have become more useful since it was learnt
+      unsigned lbd = computeLbd(cl);
+      if(lbd<cl->lbd()) {
+        cl->setLbd(lbd);
+      }
+    }
     recordClauseActivity(cl);
     SATClause::Iterator cit(*cl);
     while(cit.hasNext()) {
@@ -714,7 +762,8 @@ SATClause* TWLSolver::getLearntClause(SATClause* conflictClause)
     doSubsumptionResolution(resLits, premises);
   }
 
-  SATClause* res = SATClause::fromStack(resLits);
+  SATClause* res = SATClause::fromStack(resLits, _learntArena);
+  res->setLbd(computeLbd(res));
 
   if(_generateProofs) {
     ASS(premises);
@@ -750,6 +799,71 @@ SATClause* TWLSolver::getLearntClause(SATClause* conflictClause)
   return res;
 }
 
+/**
+ * Reclaim the memory of learnt clauses removed by the clause disposer
+ * and put the remaining ones next to each other.
+ *
+ * Must be called only at a safe spot (see ClauseDisposer::onSafeSpot()),
+ * as learnt clauses move.
+ */
+void TWLSolver::compactLearntClauses()
+{
+  CALL("TWLSolver::compactLearntClauses");
+
+  static DHMap<SATClause*,SATClause*> relocated;
+  relocated.reset();
+
+  _learntArena.compact(_learntClauses, relocated);
+
+  if(!relocated.isEmpty()) {
+    unsigned watchCnt = (_varCnt+1)*2;
+    for(unsigned i=2; i<watchCnt; i++) {
+      WatchStack& ws = _windex[i];
+      unsigned wsSize = ws.size();
+      for(unsigned j=0; j<wsSize; j++) {
+        relocated.find(ws[j].cl, ws[j].cl);
+      }
+    }
+    for(unsigned var=1; var<=_varCnt; var++) {
+      if(_assignmentPremises[var]) {
+        relocated.find(_assignmentPremises[var], _assignmentPremises[var]);
+      }
+    }
+  }
+
+  _learntArenaLimit = std::max(MIN_LEARNT_ARENA_LIMIT, 2*_learntArena.size());
+}
+
+/**
+ * Add the clauses learnt by the other solvers of the clause exchange
+ * as our own learnt clauses.
+ *
+ * Must be called on level 1.
+ */
+void TWLSolver::importSharedClauses()
+{
+  CALL("TWLSolver::importSharedClauses");
+  ASS(_exchange);
+  ASS(!_generateProofs);
+  ASS_EQ(_level, 1);
+
+  static SATLiteralStack lits;
+  while(_exchange->consume(lits)) {
+    SATClause* cl = SATClause::fromStack(lits, _learntArena);
+    ASS(cl->hasUniqueVariables());
+    cl->setLbd(cl->length());
+    _learntClauses.push(cl);
+    recordClauseActivity(cl);
+
+    if(cl->length()==1) {
+      addUnitClause(cl);
+    }
+    else {
+      addNonunitClause(cl);
+    }
+  }
+}
+
 TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned var, unsigned& litIndex)
 {
   CALL("TWLSolver::visitWatchedClause");
@@ -757,6 +871,7 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
   ASS_G(var,0); ASS_LE(var,_varCnt);
 
   if(isTrue(watch.blocker)) {
+    //the clause is true, we don't even need to look at it
     return VR_NONE;
   }
 
@@ -774,7 +889,9 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
 
   if(watch.blocker!=otherWatched && isTrue(otherWatched)) {
 //  if(isTrue(otherWatched)) {
-    return VR_NONE; //the other watched literal is true
+    //the other watched literal is true
+    litIndex = otherWatchIndex;
+    return VR_CHANGE_BLOCKER;
   }
   ASS(!isTrue(otherWatched));
 
@@ -785,7 +902,8 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
     SATLiteral lit=(*cl)[i];
     if(isTrue(lit)) {
       //clause is true
-      return VR_NONE;
+      litIndex = i;
+      return VR_CHANGE_BLOCKER;
     }
     else if(undefIndex==clen && isUndefined(lit)) {
       undefIndex=i;
@@ -842,6 +960,11 @@ SATClause* TWLSolver::propagate(unsigned var)
       tgtStack.push(Watch(cl, (*cl)[1-curWatchIndex]));
       break;
     }
+    case VR_CHANGE_BLOCKER:
+      //next time the clause is visited only while the new blocker is not true
+      watch.blocker = (*cl)[litIndex];
+      wit.replace(watch);
+      break;
     case VR_CONFLICT:
       return cl;
     case VR_PROPAGATE:
@@ -1429,6 +1552,9 @@ TWLSolver::SatLoopResult TWLSolver::runSatLoop(unsigned conflictCountLimit)
 
     if(restartASAP) {
       backtrack(1);
+      if(_exchange) {
+	importSharedClauses();
+      }
       _variableSelector->onRestart();
       _clauseDisposer->onRestart();
       conflictsBeforeRestart = _restartStrategy->getNextConflictCount();
@@ -1437,6 +1563,9 @@ TWLSolver::SatLoopResult TWLSolver::runSatLoop(unsigned conflictCountLimit)
 
     if(_toPropagate.isEmpty()) {
       _clauseDisposer->onSafeSpot();
+      if(_learntArena.size()>_learntArenaLimit) {
+	compactLearntClauses();
+      }
     }
 
     if(!anythingToPropagate()) {
@@ -1477,6 +1606,12 @@ TWLSolver::SatLoopResult TWLSolver::runSatLoop(unsigned conflictCountLimit)
       _clauseDisposer->onConflict();
       SATClause* learnt = getLearntClause(conflict);
       ASS_REP(isFalse(learnt),learnt);
+      if(_restartStrategy->onConflict(learnt->lbd())) {
+	restartASAP = true;
+      }
+      if(_exchange && learnt->length()<=SATClauseExchange::MAX_LENGTH) {
+	_exchange->publish(learnt);
+      }
 
       if(learnt->length()==0) {
 	throw UnsatException(learnt);
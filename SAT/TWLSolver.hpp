@@ -38,6 +38,7 @@
 
 #include "SATLiteral.hpp"
 #include "SATClause.hpp"
+#include "SATClauseArena.hpp"
 #include "SATSolver.hpp"
 
 namespace SAT {
@@ -45,6 +46,14 @@ namespace SAT {
 using namespace Lib;
 using namespace Shell;
 
+/**
+ * Record in a watch stack of a literal
+ *
+ * @c blocker is a literal of the clause @c cl. The clause is true while the
+ * blocker is true, so in that case it does not need to be visited at all.
+ * The blocker starts as the other watched literal, and is replaced by
+ * a true literal whenever such is found in a visit.
+ */
 struct Watch
 {
   Watch() {}
@@ -118,6 +127,15 @@ public:
     return _refutation;
   }
 
+  /**
+   * Share short learnt clauses with other solvers through @c exchange,
+   * and import theirs at restarts. The other solvers must have the same
+   * set of input clauses.
+   */
+  void setClauseExchange(SATClauseExchange* exchange) { _exchange = exchange; }
+
+  unsigned computeLbd(SATClause* cl);
+
   void assertValid();
   void printAssignment();
 
@@ -196,7 +214,9 @@ private:
     /** Propagate literal at @c litIndex position */
     VR_PROPAGATE,
     /** Replace the current watch by watching literal at @c litIndex position */
-    VR_CHANGE_WATCH
+    VR_CHANGE_WATCH,
+    /** The clause is true, make the (true) literal at @c litIndex position the blocker */
+    VR_CHANGE_BLOCKER
   };
 
   ClauseVisitResult visitWatchedClause(Watch watch, unsigned var, unsigned& litIndex);
@@ -211,6 +231,8 @@ private:
   void doShallowMinimize(SATLiteralStack& lits, ArraySet& seenVars);
   void doDeepMinimize(SATLiteralStack& lits, ArraySet& seenVars, SATClauseList*& premises);
   bool isRedundant(SATLiteral lit, ArraySet& seenVars, SATClauseList*& premises);
+  void compactLearntClauses();
+  void importSharedClauses();
   SATClause* getLearntClause(SATClause* conflictClause);
 
   void insertIntoWatchIndex(SATClause* cl);
@@ -308,6 +330,13 @@ private:
    * The most recently learn clauses are at the top
    */
   SATClauseStack _learntClauses;
+  /** Storage of the learnt clauses */
+  SATClauseArena _learntArena;
+  /** When the arena grows over this many bytes, it is compacted */
+  size_t _learntArenaLimit;
+
+  /** Exchange of learnt clauses with other solvers, or zero */
+  SATClauseExchange* _exchange;
   
   ArrayMap<EmptyStruct> _propagationScheduled;
   Deque<unsigned> _toPropagate;
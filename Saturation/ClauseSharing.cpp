@@ -0,0 +1,226 @@
+
+/*
+ * File ClauseSharing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseSharing.cpp
+ * Implements class ClauseSharing.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "ClauseSharing.hpp"
+
+namespace Saturation
+{
+
+/** Maximal number of words of a serialised clause */
+static const unsigned SLOT_WORDS = 64;
+/** Number of slots in the ring */
+static const unsigned CAPACITY = 1<<14;
+
+ClauseSharing* ClauseSharing::s_instance = 0;
+
+ClauseSharing::ClauseSharing()
+: _ring(SLOT_WORDS, CAPACITY),
+  _sortBound(env.sorts->count()),
+  _functionBound(env.signature->functions()),
+  _predicateBound(env.signature->predicates())
+{
+  CALL("ClauseSharing::ClauseSharing");
+}
+
+/**
+ * Create the exchange. To be called in the parent process before
+ * the workers are forked.
+ */
+void ClauseSharing::create()
+{
+  CALL("ClauseSharing::create");
+  ASS(!s_instance);
+
+  s_instance = new ClauseSharing();
+}
+
+/**
+ * Set the index of the current worker. To be called in each
+ * worker process before it starts publishing clauses.
+ */
+void ClauseSharing::setWorker(unsigned worker)
+{
+  CALL("ClauseSharing::setWorker");
+
+  _ring.setWorker(worker);
+}
+
+/**
+ * Make clause @b cl available to the other workers, unless it is
+ * too long or contains something that cannot be exchanged
+ *
+ * The clause is published only if it holds in the other workers as
+ * well, so it must not depend on splitting and must be derived only
+ * from the shared symbols.
+ */
+void ClauseSharing::publish(Clause* cl)
+{
+  CALL("ClauseSharing::publish");
+
+  unsigned len = cl->length();
+  if (len==0 || len>MAX_LENGTH || !cl->noSplits() || cl->color()!=COLOR_TRANSPARENT) {
+    return;
+  }
+
+  static Stack<unsigned> words;
+  words.reset();
+  words.push(len);
+  for (unsigned i=0; i<len; i++) {
+    if (!encodeLiteral((*cl)[i], words)) {
+      return;
+    }
+  }
+  _ring.publish(words.begin(), words.size());
+  env.statistics->sharedClausesPublished++;
+}
+
+/**
+ * Return a clause published by another worker that the current one
+ * has not consumed yet, or zero if there is none
+ */
+Clause* ClauseSharing::consume()
+{
+  CALL("ClauseSharing::consume");
+
+  static Stack<unsigned> words;
+  static Stack<Literal*> lits;
+  if (!_ring.consume(words)) {
+    return 0;
+  }
+
+  unsigned pos = 0;
+  unsigned len = words[pos++];
+  lits.reset();
+  for (unsigned i=0; i<len; i++) {
+    lits.push(decodeLiteral(words, pos));
+  }
+  ASS_EQ(pos, words.size());
+
+  Clause* res = Clause::fromStack(lits, Unit::AXIOM, new Inference(Inference::EXTERNAL));
+  env.statistics->sharedClausesImported++;
+  return res;
+}
+
+bool ClauseSharing::encodeTerm(TermList t, Stack<unsigned>& words)
+{
+  CALL("ClauseSharing::encodeTerm");
+
+  if (words.size()==SLOT_WORDS) {
+    return false;
+  }
+  if (t.isOrdinaryVar()) {
+    words.push((t.var()<<1) | 1);
+    return true;
+  }
+  if (!t.isTerm()) {
+    return false;
+  }
+  Term* trm = t.term();
+  if (trm->isSpecial() || trm->functor()>=_functionBound) {
+    return false;
+  }
+  words.push(trm->functor()<<1);
+  for (TermList* arg = trm->args(); !arg->isEmpty(); arg = arg->next()) {
+    if (!encodeTerm(*arg, words)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ClauseSharing::encodeLiteral(Literal* l, Stack<unsigned>& words)
+{
+  CALL("ClauseSharing::encodeLiteral");
+
+  if (l->functor()>=_predicateBound || words.size()+2>SLOT_WORDS) {
+    return false;
+  }
+  words.push((l->functor()<<1) | (l->isPositive() ? 1 : 0));
+  if (l->isEquality()) {
+    unsigned sort = SortHelper::getEqualityArgumentSort(l);
+    if (sort>=_sortBound) {
+      return false;
+    }
+    words.push(sort);
+  }
+  for (TermList* arg = l->args(); !arg->isEmpty(); arg = arg->next()) {
+    if (!encodeTerm(*arg, words)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TermList ClauseSharing::decodeTerm(const Stack<unsigned>& words, unsigned& pos)
+{
+  CALL("ClauseSharing::decodeTerm");
+
+  unsigned word = words[pos++];
+  if (word & 1) {
+    return TermList(word>>1, false);
+  }
+  unsigned fn = word>>1;
+  unsigned arity = env.signature->functionArity(fn);
+  if (arity==0) {
+    return TermList(Term::createConstant(fn));
+  }
+  DArray<TermList> args(arity);
+  for (unsigned i=0; i<arity; i++) {
+    args[i] = decodeTerm(words, pos);
+  }
+  return TermList(Term::create(fn, arity, args.array()));
+}
+
+Literal* ClauseSharing::decodeLiteral(const Stack<unsigned>& words, unsigned& pos)
+{
+  CALL("ClauseSharing::decodeLiteral");
+
+  unsigned header = words[pos++];
+  unsigned pred = header>>1;
+  bool polarity = header & 1;
+  if (pred==0) {
+    unsigned sort = words[pos++];
+    TermList lhs = decodeTerm(words, pos);
+    TermList rhs = decodeTerm(words, pos);
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+  unsigned arity = env.signature->predicateArity(pred);
+  DArray<TermList> args(arity);
+  for (unsigned i=0; i<arity; i++) {
+    args[i] = decodeTerm(words, pos);
+  }
+  return Literal::create(pred, arity, polarity, false, args.array());
+}
+
+}
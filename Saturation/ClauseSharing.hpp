@@ -0,0 +1,98 @@
+
+/*
+ * File ClauseSharing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseSharing.hpp
+ * Defines class ClauseSharing.
+ */
+
+#ifndef __ClauseSharing__
+#define __ClauseSharing__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Sys/SharedRing.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Exchange of short derived clauses between proof attempts running
+ * in parallel in forked processes (the slices of a portfolio).
+ *
+ * The object must be created before the processes are forked. Only
+ * clauses over the sorts and symbols that existed at that point are
+ * exchanged, since the symbols introduced later (e.g. by preprocessing)
+ * may have different meaning in different processes. Clauses are
+ * serialised into a Sys::SharedRing: each literal is written as its
+ * header (predicate and polarity, followed by the argument sort for
+ * equalities) and its arguments in prefix order, with the arities of
+ * function symbols taken from the signature.
+ *
+ * A consumed clause is an input unit with the EXTERNAL inference, its
+ * derivation stays in the process that published it. Proofs using such
+ * clauses are therefore not complete, so the portfolio modes only create
+ * the exchange when no proof is output.
+ */
+class ClauseSharing
+{
+public:
+  CLASS_NAME(ClauseSharing);
+  USE_ALLOCATOR(ClauseSharing);
+
+  /** Longest clause that is exchanged */
+  static const unsigned MAX_LENGTH = 2;
+
+  static void create();
+  /** Return the exchange, or zero if it was not created */
+  static ClauseSharing* instance() { return s_instance; }
+
+  void setWorker(unsigned worker);
+
+  void publish(Clause* cl);
+  Clause* consume();
+
+private:
+  ClauseSharing();
+
+  bool encodeTerm(TermList t, Stack<unsigned>& words);
+  bool encodeLiteral(Literal* l, Stack<unsigned>& words);
+  TermList decodeTerm(const Stack<unsigned>& words, unsigned& pos);
+  Literal* decodeLiteral(const Stack<unsigned>& words, unsigned& pos);
+
+  static ClauseSharing* s_instance;
+
+  Sys::SharedRing _ring;
+  /** Number of sorts shared by all processes */
+  unsigned _sortBound;
+  /** Number of function symbols shared by all processes */
+  unsigned _functionBound;
+  /** Number of predicate symbols shared by all processes */
+  unsigned _predicateBound;
+};
+
+}
+
+#endif // __ClauseSharing__
@@ -105,6 +105,10 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
       Preprocess prepro(opt);
       prepro.preprocess(prb);
     }
+    // the preprocessing does not check the time by itself
+    if (env.timeLimitReached()) {
+      throw TimeLimitExceededException();
+    }
     runVampireSaturationImpl(prb, opt);
   }
   catch(MemoryLimitExceededException&) {
@@ -124,6 +128,20 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
   }
 }
 
+/**
+ * Like runVampire(Problem&,const Options&), but give up once @b timeLimitMs
+ * milliseconds pass, with the TIME_LIMIT termination reason, instead of
+ * terminating the process. This only limits the task run by the current
+ * thread, the global time limit still applies.
+ */
+void ProvingHelper::runVampire(Problem& prb, const Options& opt, int timeLimitMs)
+{
+  CALL("ProvingHelper::runVampire/3");
+
+  ScopedDeadline deadline(timeLimitMs);
+  runVampire(prb, opt);
+}
+
 /**
  * Private version of the @b runVampireSaturation function
  * that is not protected for resource-limit exceptions
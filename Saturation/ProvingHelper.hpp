@@ -35,6 +35,7 @@ class ProvingHelper {
 public:
   static void runVampireSaturation(Problem& prb, const Options& opt);
   static void runVampire(Problem& prb, const Options& opt);
+  static void runVampire(Problem& prb, const Options& opt, int timeLimitMs);
 private:
   static void runVampireSaturationImpl(Problem& prb, const Options& opt);
 };
@@ -75,11 +75,13 @@
 
 #include "Shell/AnswerExtractor.hpp"
 #include "Shell/Options.hpp"
+#include "Shell/SliceProgress.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 
 #include "Splitter.hpp"
 
+#include "ClauseSharing.hpp"
 #include "ConsequenceFinder.hpp"
 #include "LabelFinder.hpp"
 #include "Splitter.hpp"
@@ -115,7 +117,7 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   : MainLoop(prb, opt),
     _limits(opt),
     _clauseActivationInProgress(false),
-    _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0),
+    _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0), _clauseSharing(0),
     _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
     _instantiation(0),
 #if VZ3
@@ -391,6 +393,11 @@ void SaturationAlgorithm::onNewClause(Clause* cl)
   if (_answerLiteralManager) {
     _answerLiteralManager->onNewClause(cl);
   }
+
+  if (_clauseSharing && cl->age()>0) {
+    //input clauses and the imported ones are known to the others
+    _clauseSharing->publish(cl);
+  }
 }
 
 void SaturationAlgorithm::onNewUsefulPropositionalClause(Clause* c)
@@ -1150,6 +1157,27 @@ UnitList* SaturationAlgorithm::collectSaturatedSet()
   return res;
 }
 
+/**
+ * Add the clauses published by the proof attempts running in parallel
+ * as new clauses
+ */
+void SaturationAlgorithm::importSharedClauses()
+{
+  CALL("SaturationAlgorithm::importSharedClauses");
+  ASS(_clauseSharing);
+
+  //don't let a flood of clauses delay our own progress
+  static const unsigned MAX_IMPORTED = 32;
+
+  for (unsigned i=0; i<MAX_IMPORTED; i++) {
+    Clause* cl = _clauseSharing->consume();
+    if (!cl) {
+      break;
+    }
+    addNewClause(cl);
+  }
+}
+
 /**
  *
  * This function may throw RefutationFoundException and TimeLimitExceededException.
@@ -1158,6 +1186,10 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  if (_clauseSharing) {
+    importSharedClauses();
+  }
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
@@ -1182,6 +1214,7 @@ void SaturationAlgorithm::doOneAlgorithmStep()
   Clause* cl = _passive->popSelected();
   ASS_EQ(cl->store(),Clause::PASSIVE);
   cl->setStore(Clause::SELECTED);
+  unsigned selectedWeight = cl->weight();
 
   if (!handleClauseBeforeActivation(cl)) {
     return;
@@ -1191,6 +1224,11 @@ void SaturationAlgorithm::doOneAlgorithmStep()
   if (!isActivated) {
     handleUnsuccessfulActivation(cl);
   }
+
+  if (SliceProgress::instance()) {
+    SliceProgress::instance()->update(env.statistics->activeClauses, _active->size(), _passive->size(),
+        Allocator::getUsedMemory(), selectedWeight);
+  }
 }
 
 
@@ -1334,6 +1372,10 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
     res->_splitter = new Splitter();
   }
 
+  if(opt.clauseSharing()){
+    res->_clauseSharing = ClauseSharing::instance();
+  }
+
   // create generating inference engine
   CompositeGIE* gie=new CompositeGIE();
 
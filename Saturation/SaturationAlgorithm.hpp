@@ -159,6 +159,7 @@ protected:
   void onNewUsefulPropositionalClause(Clause* c);
   virtual void onClauseRetained(Clause* cl);
   void onAllProcessed();
+  void importSharedClauses();
   int elapsedTime();
   virtual bool isComplete();
 
@@ -207,6 +208,8 @@ protected:
   ScopedPtr<LiteralSelector> _selector;
 
   Splitter* _splitter;
+  /** exchange of clauses with parallel proof attempts, or zero */
+  ClauseSharing* _clauseSharing;
 
   ConsequenceFinder* _consFinder;
   LabelFinder* _labelFinder;
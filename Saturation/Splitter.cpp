@@ -52,6 +52,7 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "DP/ShortConflictMetaDP.hpp"
@@ -83,6 +84,9 @@ void SplittingBranchSelector::init()
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(_parent.getOptions(),true);
       break;      
+    case Options::SatSolver::LINGELING:
+      _solver = new LingelingInterfacing(_parent.getOptions(),true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
@@ -411,6 +415,61 @@ int SplittingBranchSelector::assertedGroundPositiveEqualityCompomentMaxAge()
   return max;
 }
 
+/**
+ * Make the decision procedure @c dp contain the literals of @c lits (only the
+ * positive equalities among them if @c onlyEqualities is true), given that it
+ * now contains the literals of @c asserted.
+ *
+ * When @c lits only extend the @c asserted set, just the new literals are
+ * added to @c dp, otherwise it is reset and filled from scratch.
+ * Return false if there was no change.
+ */
+bool SplittingBranchSelector::assertGroundLiterals(DecisionProcedure& dp, DHSet<Literal*>& asserted,
+    const LiteralStack& lits, bool onlyEqualities)
+{
+  CALL("SplittingBranchSelector::assertGroundLiterals");
+
+  static LiteralStack added;
+  added.reset();
+
+  unsigned keptCnt = 0;
+  LiteralStack::ConstIterator it(lits);
+  while(it.hasNext()) {
+    Literal* lit = it.next();
+    if(onlyEqualities && !(lit->isEquality() && lit->isPositive())) {
+      continue;
+    }
+    if(asserted.contains(lit)) {
+      keptCnt++;
+    }
+    else {
+      added.push(lit);
+    }
+  }
+
+  if(keptCnt<asserted.size()) {
+    // some literals are not true anymore
+    RSTAT_CTR_INC("ssat_dp_resets");
+    asserted.reset();
+    dp.reset();
+    added.reset();
+    LiteralStack::ConstIterator ait(lits);
+    while(ait.hasNext()) {
+      Literal* lit = ait.next();
+      if(!onlyEqualities || (lit->isEquality() && lit->isPositive())) {
+        added.push(lit);
+      }
+    }
+  }
+  else if(added.isEmpty()) {
+    return false;
+  }
+
+  asserted.loadFromIterator(LiteralStack::ConstIterator(added));
+  dp.addLiterals(pvi( LiteralStack::ConstIterator(added) ), onlyEqualities);
+  return true;
+}
+
 SATSolver::Status SplittingBranchSelector::processDPConflicts()
 {
   CALL("SplittingBranchSelector::processDPConflicts");
@@ -433,8 +492,7 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
       s2f.collectAssignment(*_solver, gndAssignment); 
       // ... moreover, _dp->addLiterals will filter the set anyway
 
-      _dp->reset();
-      _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+      assertGroundLiterals(*_dp, _dpAsserted, gndAssignment, false);
       DecisionProcedure::Status dpStatus = _dp->getStatus(_ccMultipleCores);
 
       if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
@@ -455,6 +513,10 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
 
       RSTAT_CTR_INC("ssat_dp_conflict");
       RSTAT_CTR_INC_MANY("ssat_dp_conflict_clauses",unsatCoreCnt);
+
+      // no more literals can be added after a conflict
+      _dp->reset();
+      _dpAsserted.reset();
     }
 
     // there was conflict, so we try looking for a different model
@@ -476,13 +538,16 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
     lastCheckedVar = _parent.maxSatVar();
 #endif
 
+    if(!assertGroundLiterals(*_dpModel, _dpModelAsserted, gndAssignment, true /*only equalities now*/)) {
+      // the equalities are the same as last time, and so is the model
+      return SATSolver::SATISFIABLE;
+    }
+
     RSTAT_CTR_INC("ssat_dp_model");
 
     static LiteralStack model;
     model.reset();
 
-    _dpModel->reset();
-    _dpModel->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ),true /*only equalities now*/);
     ALWAYS(_dpModel->getStatus(false) == DecisionProcedure::SATISFIABLE);
     _dpModel->getModel(model);
 
@@ -633,21 +698,28 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   }
   ASS_EQ(stat,SATSolver::SATISFIABLE);
 
-  unsigned _usedcnt=0; // for the statistics below
-  for(unsigned i=1; i<=maxSatVar; i++) {
-    SATSolver::VarAssignment asgn = getSolverAssimentConsideringCCModel(i);
-    updateSelection(i, asgn, addedComps, removedComps);
-    
-    if (asgn != SATSolver::DONT_CARE) {
-      _usedcnt++;
+  while(_lastTrackedVar<maxSatVar) {
+    _unfixedVars.push(++_lastTrackedVar);
+  }
+
+  Stack<unsigned>::StableDelIterator vit(_unfixedVars);
+  while(vit.hasNext()) {
+    unsigned var = vit.next();
+    SATSolver::VarAssignment asgn = getSolverAssimentConsideringCCModel(var);
+    updateSelection(var, asgn, addedComps, removedComps);
+
+    if(asgn!=SATSolver::DONT_CARE && _solver->isZeroImplied(var)) {
+      // the assignment of var cannot change anymore, so once the component
+      // it makes true is selected, there is nothing left to update for var
+      SplitLevel lvl = _parent.getNameFromLiteral(SATLiteral(var, asgn==SATSolver::TRUE));
+      if(_parent.isUsedName(lvl)) {
+        ASS(_selected.find(lvl));
+        vit.del();
+        RSTAT_CTR_INC("ssat_fixed_vars");
+      }
     }
   }
   /*
-  if(maxSatVar>=1){
-    int percent = (_usedcnt *100) / maxSatVar;
-    RSTAT_MCTR_INC("minimise_model_percent",percent);
-  }
-  
   RSTAT_CTR_INC_MANY("ssat_usual_activations", addedComps.size());
   RSTAT_CTR_INC_MANY("ssat_usual_deactivations", removedComps.size());
   */
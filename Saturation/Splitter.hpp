@@ -29,6 +29,7 @@
 #include "Lib/Allocator.hpp"
 #include "Lib/ArrayMap.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/ScopedPtr.hpp"
 
@@ -65,7 +66,7 @@ class Splitter;
  */
 class SplittingBranchSelector {
 public:
-  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent)  {}
+  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent), _lastTrackedVar(0)  {}
   ~SplittingBranchSelector(){
 #if VZ3
 {
@@ -96,6 +97,9 @@ private:
 
   int assertedGroundPositiveEqualityCompomentMaxAge();
 
+  bool assertGroundLiterals(DecisionProcedure& dp, DHSet<Literal*>& asserted,
+      const LiteralStack& lits, bool onlyEqualities);
+
   //options
   bool _eagerRemoval;
   Options::SplittingLiteralPolarityAdvice _literalPolarityAdvice;
@@ -109,6 +113,10 @@ private:
   ScopedPtr<DecisionProcedure> _dp;
   // use a separate copy of the decision procedure for ccModel computations and fill it up only with equalities
   ScopedPtr<SimpleCongruenceClosure> _dpModel;
+  /** Literals currently added to @c _dp */
+  DHSet<Literal*> _dpAsserted;
+  /** Literals currently added to @c _dpModel */
+  DHSet<Literal*> _dpModelAsserted;
   
   /**
    * Contains selected component names (splitlevels)
@@ -120,6 +128,17 @@ private:
    */
   ArraySet _trueInCCModel;
 
+  /**
+   * SAT variables whose assignment still needs to be checked after
+   * each model recomputation, in increasing order.
+   *
+   * A variable is dropped when it is fixed at the top level in the SAT
+   * solver and the component it makes true has been selected.
+   */
+  Stack<unsigned> _unfixedVars;
+  /** The greatest SAT variable that was added to @c _unfixedVars */
+  unsigned _lastTrackedVar;
+
 #ifdef VDEBUG
   unsigned lastCheckedVar;
 #endif
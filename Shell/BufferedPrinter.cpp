@@ -0,0 +1,315 @@
+/*
+ * File BufferedPrinter.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file BufferedPrinter.cpp
+ * Implements class BufferedPrinter.
+ */
+
+#include <cstring>
+#include <ostream>
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Theory.hpp"
+#include "Kernel/Unit.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "TPTPPrinter.hpp"
+
+#include "BufferedPrinter.hpp"
+
+namespace Shell
+{
+
+BufferedPrinter::BufferedPrinter(ostream& out)
+: _size(0), _out(out), _stack(64)
+{
+  CALL("BufferedPrinter::BufferedPrinter");
+}
+
+BufferedPrinter::~BufferedPrinter()
+{
+  CALL("BufferedPrinter::~BufferedPrinter");
+
+  flush();
+}
+
+/**
+ * Write the buffer into the target stream and flush the stream
+ */
+void BufferedPrinter::flush()
+{
+  CALL("BufferedPrinter::flush");
+
+  writeBuffer();
+  _out.flush();
+}
+
+void BufferedPrinter::writeBuffer()
+{
+  CALL("BufferedPrinter::writeBuffer");
+
+  if (_size) {
+    _out.write(_buf, _size);
+    _size=0;
+  }
+}
+
+void BufferedPrinter::write(const char* str, size_t len)
+{
+  CALL("BufferedPrinter::write");
+
+  if (_size+len>BUFFER_SIZE) {
+    writeBuffer();
+    if (len>BUFFER_SIZE) {
+      _out.write(str, len);
+      return;
+    }
+  }
+  memcpy(_buf+_size, str, len);
+  _size+=len;
+}
+
+BufferedPrinter& BufferedPrinter::operator<<(const char* str)
+{
+  write(str, strlen(str));
+  return *this;
+}
+
+BufferedPrinter& BufferedPrinter::operator<<(const vstring& str)
+{
+  write(str.data(), str.size());
+  return *this;
+}
+
+BufferedPrinter& BufferedPrinter::operator<<(unsigned num)
+{
+  char digits[16];
+  char* ptr=digits+sizeof(digits);
+  do {
+    *(--ptr)='0'+(num%10);
+    num/=10;
+  } while (num);
+  write(ptr, digits+sizeof(digits)-ptr);
+  return *this;
+}
+
+BufferedPrinter& BufferedPrinter::operator<<(int num)
+{
+  if (num<0) {
+    *this << '-';
+    return *this << (0u-static_cast<unsigned>(num));
+  }
+  return *this << static_cast<unsigned>(num);
+}
+
+void BufferedPrinter::printVariable(TermList var)
+{
+  ASS(var.isVar());
+
+  *this << (var.isOrdinaryVar() ? 'X' : 'S') << var.var();
+}
+
+/**
+ * Print a term in the same way as @b TermList::toString()
+ */
+void BufferedPrinter::printTerm(TermList t)
+{
+  CALL("BufferedPrinter::printTerm");
+
+  if (t.isVar()) {
+    printVariable(t);
+    return;
+  }
+  Term* trm=t.term();
+  if (trm->isSpecial()) {
+    *this << trm->toString();
+    return;
+  }
+  unsigned proj;
+  if (Theory::tuples()->findProjection(trm->functor(), false, proj)) {
+    *this << "$proj(" << proj << ", ";
+  }
+  else {
+    *this << trm->functionName();
+    if (!trm->arity()) {
+      return;
+    }
+    *this << '(';
+  }
+  printArgs(trm->args());
+}
+
+/**
+ * Print arguments of a term followed by the closing bracket,
+ * in the same way as @b TermList::asArgsToString()
+ */
+void BufferedPrinter::printArgs(const TermList* args)
+{
+  CALL("BufferedPrinter::printArgs");
+
+  size_t bottom=_stack.size();
+  _stack.push(args);
+
+  while (_stack.size()>bottom) {
+    const TermList* ts=_stack.pop();
+    if (!ts) { // comma
+      *this << ',';
+      continue;
+    }
+    if (ts->isEmpty()) {
+      *this << ')';
+      continue;
+    }
+    const TermList* tail=ts->next();
+    _stack.push(tail);
+    if (!tail->isEmpty()) {
+      _stack.push(0);
+    }
+    if (ts->isVar()) {
+      printVariable(*ts);
+      continue;
+    }
+    const Term* t=ts->term();
+    if (t->isSpecial()) {
+      *this << t->headToString();
+    }
+    else {
+      unsigned proj;
+      if (Theory::tuples()->findProjection(t->functor(), false, proj)) {
+        *this << "$proj(" << proj << ", ";
+      }
+      else {
+        *this << t->functionName();
+        if (t->arity()) {
+          *this << '(';
+        }
+      }
+    }
+    if (t->arity()) {
+      _stack.push(t->args());
+    }
+  }
+}
+
+/**
+ * Print a literal in the same way as @b Literal::toString()
+ */
+void BufferedPrinter::printLiteral(Literal* lit)
+{
+  CALL("BufferedPrinter::printLiteral");
+
+  if (lit->isEquality()) {
+    bool boolSort=SortHelper::getEqualityArgumentSort(lit)==Sorts::SRT_BOOL;
+    if (boolSort) {
+      *this << '(';
+    }
+    printTerm(*lit->nthArgument(0));
+    *this << (lit->isPositive() ? " = " : " != ");
+    printTerm(*lit->nthArgument(1));
+    if (boolSort) {
+      *this << ')';
+    }
+    return;
+  }
+
+  if (!lit->polarity()) {
+    *this << '~';
+  }
+  unsigned proj;
+  if (Theory::tuples()->findProjection(lit->functor(), true, proj)) {
+    *this << "$proj(" << proj << ", ";
+    printArgs(lit->args());
+    return;
+  }
+  *this << lit->predicateName();
+  if (lit->arity()) {
+    *this << '(';
+    printArgs(lit->args());
+  }
+}
+
+/**
+ * Print literals of a clause in the same way as
+ * @b Clause::literalsOnlyToString()
+ */
+void BufferedPrinter::printClauseLiterals(Clause* cl)
+{
+  CALL("BufferedPrinter::printClauseLiterals");
+
+  unsigned clen=cl->length();
+  if (!clen) {
+    *this << "$false";
+    return;
+  }
+  printLiteral((*cl)[0]);
+  for (unsigned i=1;i<clen;i++) {
+    *this << " | ";
+    printLiteral((*cl)[i]);
+  }
+}
+
+/**
+ * Print a unit in the same way as @b TPTPPrinter::toString(const Unit*)
+ *
+ * Only clauses are printed directly, formulas still go through
+ * @b TPTPPrinter.
+ */
+void BufferedPrinter::printTPTPUnit(Unit* u)
+{
+  CALL("BufferedPrinter::printTPTPUnit");
+
+  if (!u->isClause()) {
+    *this << TPTPPrinter::toString(u);
+    return;
+  }
+
+  const char* kind;
+  switch (u->inputType()) {
+  case Unit::ASSUMPTION:
+    kind = "hypothesis";
+    break;
+  case Unit::CONJECTURE:
+  case Unit::NEGATED_CONJECTURE:
+    kind = "negated_conjecture";
+    break;
+  case Unit::EXTENSIONALITY_AXIOM:
+    kind = "extensionality";
+    break;
+  default:
+    kind = "axiom";
+    break;
+  }
+
+  *this << "cnf(";
+  vstring unitName;
+  if (Parse::TPTP::findAxiomName(u, unitName)) {
+    *this << unitName;
+  }
+  else {
+    *this << 'u' << u->number();
+  }
+  *this << ',' << kind << ",\n    ";
+  printClauseLiterals(u->asClause());
+  *this << ").\n";
+}
+
+}
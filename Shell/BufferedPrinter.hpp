@@ -0,0 +1,96 @@
+/*
+ * File BufferedPrinter.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file BufferedPrinter.hpp
+ * Defines class BufferedPrinter.
+ */
+
+#ifndef __BufferedPrinter__
+#define __BufferedPrinter__
+
+#include <iosfwd>
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Printer writing terms, literals and clauses directly into an output
+ * buffer, without building intermediate strings
+ *
+ * The output is the same as that of the @b toString() functions of
+ * the printed objects (and of @b TPTPPrinter::toString for units).
+ * The buffer is written into the target stream when it gets full,
+ * on @b flush() and on destruction. Nothing else may be written into
+ * the target stream while the buffer is non-empty.
+ */
+class BufferedPrinter
+{
+public:
+  CLASS_NAME(BufferedPrinter);
+  USE_ALLOCATOR(BufferedPrinter);
+
+  BufferedPrinter(ostream& out);
+  ~BufferedPrinter();
+
+  BufferedPrinter& operator<<(char c)
+  {
+    if (_size==BUFFER_SIZE) {
+      writeBuffer();
+    }
+    _buf[_size++]=c;
+    return *this;
+  }
+  BufferedPrinter& operator<<(const char* str);
+  BufferedPrinter& operator<<(const vstring& str);
+  BufferedPrinter& operator<<(unsigned num);
+  BufferedPrinter& operator<<(int num);
+
+  void printTerm(TermList t);
+  void printLiteral(Literal* lit);
+  void printClauseLiterals(Clause* cl);
+  void printTPTPUnit(Unit* u);
+
+  void flush();
+private:
+  void write(const char* str, size_t len);
+  void writeBuffer();
+
+  void printVariable(TermList var);
+  void printArgs(const TermList* args);
+
+  static const size_t BUFFER_SIZE=1<<16;
+
+  char _buf[BUFFER_SIZE];
+  size_t _size;
+  ostream& _out;
+
+  /** Work stack of @b printArgs, kept to avoid reallocation */
+  Stack<const TermList*> _stack;
+};
+
+}
+
+#endif /* __BufferedPrinter__ */
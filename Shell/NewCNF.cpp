@@ -76,6 +76,10 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
       break;
   }
 
+  if (clausifyDisjunction(f, output)) {
+    return;
+  }
+
   ASS(_genClauses.empty());
   ASS(_queue.isEmpty());
   ASS(_occurrences.isEmpty());
@@ -86,6 +90,8 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
 
   // process the generalized clauses until they contain only literals
   while(_queue.isNonEmpty()) {
+    env.timeSafePointSometime<64>();
+
     Formula* g;
     Occurrences occurrences;
     dequeue(g, occurrences);
@@ -136,6 +142,82 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
   ASS(_occurrences.isEmpty());
 }
 
+/**
+ * If @b f is a universally quantified disjunction of shared literals,
+ * add the corresponding clause (unless it is a tautology) to @b output and return true.
+ * Otherwise return false and don't touch @b output.
+ *
+ * Large generated problems consist mostly of such formulas and for them
+ * going through the generalised clauses, occurrences and the queue
+ * costs much more than creating the clause directly.
+ * Duplicate literals and tautologies are treated as in pushLiteral.
+ */
+bool NewCNF::clausifyDisjunction(Formula* f, Stack<Clause*>& output)
+{
+  CALL("NewCNF::clausifyDisjunction");
+
+  while (f->connective() == FORALL) {
+    f = f->qarg();
+  }
+
+  Stack<Formula*>& todo = _disjunctionTodo;
+  Stack<Literal*>& literals = _disjunctionLiterals;
+  DHMap<Literal*,bool>& polarities = _disjunctionPolarities;
+  todo.reset();
+  literals.reset();
+  polarities.reset();
+
+  todo.push(f);
+  while (todo.isNonEmpty()) {
+    Formula* g = todo.pop();
+    switch (g->connective()) {
+      case OR: {
+        // reverse the pushed arguments, so that the literals keep their order
+        unsigned first = todo.size();
+        FormulaList::Iterator ait(g->args());
+        while (ait.hasNext()) {
+          todo.push(ait.next());
+        }
+        for (unsigned i = first, j = todo.size()-1; i < j; i++, j--) {
+          swap(todo[i], todo[j]);
+        }
+        break;
+      }
+      case LITERAL: {
+        Literal* l = g->literal();
+        if (!l->shared()) {
+          return false;
+        }
+        Literal* positive = l->isPositive() ? l : Literal::complementaryLiteral(l);
+        bool polarity;
+        if (polarities.find(positive, polarity)) {
+          if (polarity != l->isPositive()) {
+            LOG2(f->toString(), "is eliminated as it contains a tautology");
+            return true;
+          }
+          LOG2("Found duplicate literal", l->toString());
+          break;
+        }
+        polarities.insert(positive, l->isPositive());
+        literals.push(l);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  unsigned length = literals.size();
+  Inference* inference = new Inference1(Inference::CLAUSIFY, _beingClausified);
+  Clause* clause = new(length) Clause(length, _beingClausified->inputType(), inference);
+  for (unsigned i = 0; i < length; i++) {
+    (*clause)[i] = literals[i];
+  }
+  output.push(clause);
+
+  return true;
+}
+
 void NewCNF::process(Literal* literal, Occurrences &occurrences) {
   CALL("NewCNF::process(Literal*)");
 
@@ -81,6 +81,14 @@ private:
 
   FormulaUnit* _beingClausified;
 
+  bool clausifyDisjunction(Formula* f, Stack<Clause*>& output);
+
+  /** Working storage of clausifyDisjunction, reused between the calls */
+  Stack<Formula*> _disjunctionTodo;
+  Stack<Literal*> _disjunctionLiterals;
+  /** literal made positive --> its polarity */
+  DHMap<Literal*,bool> _disjunctionPolarities;
+
   /**
    * Queue of formulas to process.
    *
@@ -120,7 +120,9 @@ void Options::Options::init()
                                         "profile",
                                         "random_strategy",
                                         "sat_solver",
+                                        "server",
                                         "smtcomp",
+                                        "smtlib_incremental",
                                         "spider",
                                         "tclausify",
                                         "tpreprocess",
@@ -134,6 +136,8 @@ void Options::Options::init()
     "  -tpreprocess,tclausify: output modes for theory input"
     "  -output,profile: output information about the problem\n"
     "  -sat_solver: accepts problems in DIMACS and uses the internal sat solver\n   directly\n"
+    "  -server: reads jobs (a problem file followed by options) from the standard input\n   or from connections to the Unix socket given by server_socket, line by line,\n   and runs each in a forked child\n"
+    "  -smtlib_incremental: answers every check-sat of an smtlib2 benchmark using push/pop,\n   each in a child forked\n   after parsing; answers implied by earlier check-sats are reused\n   across push/pop, derived clauses are not\n"
     "Some modes are not currently maintained:\n"
     "  -bpa: perform bound propagation\n"
     "  -consequence_elimination: perform consequence elimination\n"
@@ -181,10 +185,69 @@ void Options::Options::init()
         Or(_mode.is(equal(Mode::SMTCOMP)))->
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
 
+    _scheduleFile = StringOptionValue("schedule_file","","");
+    _scheduleFile.description = "Read schedules from this file. A schedule defined in the file is used instead of the built-in one of the same name, see CASC/ScheduleDatabase.hpp for the format.";
+    _lookup.insert(&_scheduleFile);
+    _scheduleFile.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::CASC_LTB)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+
+    _runHistory = StringOptionValue("run_history","","");
+    _runHistory.description = "File with the outcomes of past portfolio slices, to which the outcomes of this run are appended. Slices with strategies that solved similar problems before run first, with their time adjusted to what those runs needed, and those that only failed on them run last.";
+    _lookup.insert(&_runHistory);
+    _runHistory.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _runHistory.setExperimental();
+
     _multicore = UnsignedOptionValue("cores","",1);
-    _multicore.description = "When running in portfolio mode mode specify the number of cores, set to 0 to use maximum";
+    _multicore.description = "When running in portfolio mode mode specify the number of cores, set to 0 to use maximum. In sat mode, the number of differently configured SAT solvers run in parallel.";
     _lookup.insert(&_multicore);
     _multicore.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))->
+        Or(_mode.is(equal(Mode::SAT)))));
+
+    _clauseSharing = BoolOptionValue("clause_sharing","",false);
+    _clauseSharing.description = "In portfolio modes, let the strategies running in parallel exchange short derived clauses over the symbols of the input problem. Imported clauses would appear in proofs without a justification, so sharing is only done with --proof off.";
+    _lookup.insert(&_clauseSharing);
+    _clauseSharing.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _clauseSharing.setExperimental();
+
+    _sliceQuantum = UnsignedOptionValue("slice_quantum","",0);
+    _sliceQuantum.description = "In portfolio modes, keep up to twice as many slices alive as there are cores and let them take turns in quanta of this many deciseconds, the ones making more progress first. A slice still gets at most its scheduled running time. If 0, slices run uninterrupted one after another.";
+    _lookup.insert(&_sliceQuantum);
+    _sliceQuantum.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _sliceQuantum.setExperimental();
+
+    _sliceStallLimit = UnsignedOptionValue("slice_stall_limit","",0);
+    _sliceStallLimit.description = "In portfolio modes, report and kill a slice that has been saturating but has not selected any clause for this many deciseconds. If 0, slices are never killed for that.";
+    _lookup.insert(&_sliceStallLimit);
+    _sliceStallLimit.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _sliceStallLimit.setExperimental();
+
+    _serverSocket = StringOptionValue("server_socket","","");
+    _serverSocket.description = "In the server mode, accept jobs on connections to a Unix domain socket created at this path instead of reading them from the standard input. Each connection is served by its own process, so jobs of different connections run at the same time.";
+    _lookup.insert(&_serverSocket);
+    _serverSocket.reliesOnHard(_mode.is(equal(Mode::SERVER)));
+
+    _pinWorkers = BoolOptionValue("pin_workers","",false);
+    _pinWorkers.description = "In portfolio modes, pin each slice to a CPU of its worker, using one hardware thread of every physical core before the SMT siblings, so that it also allocates memory from its own NUMA node. Do not use when several instances share the machine.";
+    _lookup.insert(&_pinWorkers);
+    _pinWorkers.reliesOnHard(_mode.is(equal(Mode::CASC)->
         Or(_mode.is(equal(Mode::CASC_SAT)))->
         Or(_mode.is(equal(Mode::SMTCOMP)))->
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
@@ -194,6 +257,12 @@ void Options::Options::init()
     _lookup.insert(&_ltbLearning);
     _ltbLearning.setExperimental();
 
+    _ltbParallelProblems = UnsignedOptionValue("ltb_parallel_problems","",1);
+    _ltbParallelProblems.description = "Number of problems of a batch to work on at the same time in LTB mode. The easier looking problems are started first, and the cores and the time of the batch are divided among the running problems.";
+    _lookup.insert(&_ltbParallelProblems);
+    _ltbParallelProblems.reliesOnHard(_mode.is(equal(Mode::CASC_LTB)));
+    _ltbParallelProblems.setExperimental();
+
     _ltbDirectory = StringOptionValue("ltb_directory","","");
     _ltbDirectory.description = "Directory for output from LTB mode. Default is to put output next to problem.";
     _lookup.insert(&_ltbDirectory);
@@ -550,6 +619,14 @@ void Options::Options::init()
     _lookup.insert(&_newCNF);
     _newCNF.tag(OptionTag::PREPROCESSING);
 
+    _clausifyWorkers = UnsignedOptionValue("clausify_workers","",1);
+    _clausifyWorkers.description="Number of forked processes that clausify the formulas with NewCNF. "
+                                 "The clauses and the introduced symbols are the same for the same number of workers. "
+                                 "Problems with FOOL, colors or preserved variable names are clausified sequentially.";
+    _lookup.insert(&_clausifyWorkers);
+    _clausifyWorkers.reliesOn(_newCNF.is(equal(true)));
+    _clausifyWorkers.tag(OptionTag::PREPROCESSING);
+
     _iteInliningThreshold = IntOptionValue("ite_inlining_threshold","", 0);
     _iteInliningThreshold.description="Threashold of inlining of if-then-else expressions. "
                                       "0 means that all expressions are named. "
@@ -790,6 +867,17 @@ void Options::Options::init()
     _fmbEnumerationStrategy.setExperimental();
     _lookup.insert(&_fmbEnumerationStrategy);
 
+    _fmbIncremental = BoolOptionValue("fmb_incremental","fmbi",false);
+    _fmbIncremental.description = "Keep the SAT solver between model sizes and only add the instances that are new for the larger sizes. Size-specific constraints are guarded by assumptions.";
+    _fmbIncremental.setExperimental();
+    _lookup.insert(&_fmbIncremental);
+
+    _fmbParallel = UnsignedOptionValue("fmb_parallel","fmbp",1);
+    _fmbParallel.description = "The number of domain size assignments tried at the same time, each in a forked worker with its own SAT solver. Nogoods learned by the workers are shared through the enumeration strategy. 1 means sequential.";
+    _fmbParallel.reliesOn(_fmbEnumerationStrategy.is(notEqual(FMBEnumerationStrategy::CONTOUR)));
+    _fmbParallel.setExperimental();
+    _lookup.insert(&_fmbParallel);
+
     _selection = SelectionOptionValue("selection","s",10);
     _selection.description=
     "Selection methods 2,3,4,10,11 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011 relax this restriction and are therefore not complete.\n"
@@ -1266,7 +1354,7 @@ void Options::Options::init()
     _instGenWithResolution.setRandomChoices({"on","off"});
 
     _useHashingVariantIndex = BoolOptionValue("use_hashing_clause_variant_index","uhcvi",false);
-    _useHashingVariantIndex.description= "Use clause variant index based on hashing for clause variant detection (affects inst_gen and avatar).";
+    _useHashingVariantIndex.description= "Use clause variant index based on hashing for clause variant detection (affects inst_gen and avatar). Otherwise a substitution tree is used.";
     _lookup.insert(&_useHashingVariantIndex);
     _useHashingVariantIndex.tag(OptionTag::OTHER);
     _useHashingVariantIndex.setExperimental();
@@ -1455,8 +1543,8 @@ void Options::Options::init()
     _satClauseActivityDecay.setExperimental();
 
     _satClauseDisposer = ChoiceOptionValue<SatClauseDisposer>("sat_clause_disposer","",SatClauseDisposer::MINISAT,
-                                                              {"growing","minisat"});
-    _satClauseDisposer.description="";
+                                                              {"growing","minisat","lbd"});
+    _satClauseDisposer.description="Policy for removing learnt clauses in the native SAT solver. lbd keeps clauses of low literal block distance (glue) and removes the less active half of the others periodically.";
     _lookup.insert(&_satClauseDisposer);
     _satClauseDisposer.tag(OptionTag::SAT);
     _satClauseDisposer.setExperimental();
@@ -1498,6 +1586,20 @@ void Options::Options::init()
     _satRestartLubyFactor.tag(OptionTag::SAT);
     _satRestartLubyFactor.setExperimental();
 
+    _satRestartGlucoseMargin = FloatOptionValue("sat_restart_glucose_margin","",1.25);
+    _satRestartGlucoseMargin.description="Restart when the recent average literal block distance of learnt clauses exceeds the long term one by this factor.";
+    _lookup.insert(&_satRestartGlucoseMargin);
+    _satRestartGlucoseMargin.tag(OptionTag::SAT);
+    _satRestartGlucoseMargin.addConstraint(greaterThan(1.0f));
+    _satRestartGlucoseMargin.setExperimental();
+
+    _satRestartGlucoseMinConflicts = IntOptionValue("sat_restart_glucose_min_conflicts","",50);
+    _satRestartGlucoseMinConflicts.description="Minimal number of conflicts between two glucose restarts.";
+    _lookup.insert(&_satRestartGlucoseMinConflicts);
+    _satRestartGlucoseMinConflicts.tag(OptionTag::SAT);
+    _satRestartGlucoseMinConflicts.addConstraint(greaterThan(0));
+    _satRestartGlucoseMinConflicts.setExperimental();
+
     _satRestartMinisatIncrease = FloatOptionValue("sat_restart_minisat_increase","",1.1);
     _satRestartMinisatIncrease.description="";
     _lookup.insert(&_satRestartMinisatIncrease);
@@ -1512,20 +1614,20 @@ void Options::Options::init()
     _satRestartMinisatInit.setExperimental();
 
     _satRestartStrategy = ChoiceOptionValue<SatRestartStrategy>("sat_restart_strategy","",SatRestartStrategy::LUBY,
-                                                                {"fixed","geometric","luby","minisat"});
-    _satRestartStrategy.description="";
+                                                                {"fixed","geometric","luby","minisat","glucose"});
+    _satRestartStrategy.description="Restart strategy of the native SAT solver. glucose restarts dynamically based on the literal block distance of learnt clauses.";
     _lookup.insert(&_satRestartStrategy);
     _satRestartStrategy.tag(OptionTag::SAT);
     _satRestartStrategy.setExperimental();
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","lingeling","z3"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","lingeling"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption. Finite model building uses minisat unless lingeling is selected.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -2878,6 +2980,69 @@ vstring Options::generateEncodedOptions() const
 }
 
 
+/**
+ * Return a string that is the same for two Options objects if and only if
+ * they give the same result of preprocessing on the same problem (up to
+ * options we do not know about).
+ *
+ * We take all non-default options except for those whose tag says they
+ * only influence the proof search or the output. Options that are read
+ * during preprocessing despite being tagged otherwise are listed explicitly.
+ */
+vstring Options::generatePreprocessingKey() const
+{
+  CALL("Options::generatePreprocessingKey");
+
+  BYPASSING_ALLOCATOR;
+
+  static Set<const AbstractOptionValue*> forbidden;
+  static Set<const AbstractOptionValue*> required;
+  if (forbidden.size()==0) {
+    forbidden.insert(&_timeLimitInDeciseconds);
+    forbidden.insert(&_mode);
+    forbidden.insert(&_testId);
+    forbidden.insert(&_include);
+    forbidden.insert(&_problemName);
+    forbidden.insert(&_inputFile);
+    forbidden.insert(&_randomStrategy);
+    forbidden.insert(&_decode);
+    forbidden.insert(&_ignoreMissing);
+
+    required.insert(&_FOOLParamodulation);
+    required.insert(&_termAlgebraCyclicityCheck);
+    required.insert(&_symbolPrecedence);
+  }
+
+  vostringstream res;
+  VirtualIterator<AbstractOptionValue*> options = _lookup.values();
+  while(options.hasNext()){
+    AbstractOptionValue* option = options.next();
+    if(forbidden.contains(option) || !option->is_set || option->isDefault()){
+      continue;
+    }
+    bool relevant;
+    switch(option->getTag()) {
+    case OptionTag::SATURATION:
+    case OptionTag::INFERENCES:
+    case OptionTag::LRS:
+    case OptionTag::AVATAR:
+    case OptionTag::SAT:
+    case OptionTag::INST_GEN:
+    case OptionTag::OUTPUT:
+    case OptionTag::DEVELOPMENT:
+    case OptionTag::HELP:
+      relevant = required.contains(option);
+      break;
+    default:
+      relevant = true;
+    }
+    if(relevant){
+      res << option->longName << "=" << option->getStringOfActual() << ":";
+    }
+  }
+  return res.str();
+}
+
 /**
  * True if the options are complete.
  * @since 23/07/2011 Manchester
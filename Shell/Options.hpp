@@ -139,6 +139,7 @@ public:
     void readFromEncodedOptions (vstring testId);
     void readOptionsString (vstring testId,bool assign=true);
     vstring generateEncodedOptions() const;
+    vstring generatePreprocessingKey() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -416,7 +417,9 @@ public:
     PROFILE,
     RANDOM_STRATEGY,
     SAT,
+    SERVER,
     SMTCOMP,
+    SMTLIB_INCREMENTAL,
     SPIDER,
     TCLAUSIFY,
     TPREPROCESS,
@@ -502,9 +505,10 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
+     LINGELING = 2
 #if VZ3
-     ,Z3 = 2
+     ,Z3 = 3
 #endif
   };
 
@@ -628,6 +632,7 @@ public:
     GEOMETRIC = 1,
     LUBY = 2,
     MINISAT = 3,
+    GLUCOSE = 4,
   };
 
   enum class SatVarSelector : unsigned int {
@@ -646,6 +651,7 @@ public:
   enum class SatClauseDisposer : unsigned int {
     GROWING = 0,
     MINISAT = 1,
+    LBD = 2,
   };
   
   enum class SplittingLiteralPolarityAdvice : unsigned int {
@@ -1832,16 +1838,28 @@ public:
   unsigned fmbDetectSortBoundsTimeLimit() const { return _fmbDetectSortBoundsTimeLimit.actualValue; }
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
+  bool fmbIncremental() const { return _fmbIncremental.actualValue; }
+  unsigned fmbParallel() const { return _fmbParallel.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
   vstring ltbDirectory() const { return _ltbDirectory.actualValue; }
+  unsigned ltbParallelProblems() const { return _ltbParallelProblems.actualValue; }
   Mode mode() const { return _mode.actualValue; }
+  void setMode(Mode newVal) { _mode.actualValue = newVal; }
   Schedule schedule() const { return _schedule.actualValue; }
   vstring scheduleName() const { return _schedule.getStringOfValue(_schedule.actualValue); }
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
+  vstring scheduleFile() const { return _scheduleFile.actualValue; }
+  vstring runHistory() const { return _runHistory.actualValue; }
   unsigned multicore() const { return _multicore.actualValue; }
   void setMulticore(unsigned newVal) { _multicore.actualValue = newVal; }
+  bool clauseSharing() const { return _clauseSharing.actualValue; }
+  unsigned sliceQuantum() const { return _sliceQuantum.actualValue; }
+  unsigned sliceStallLimit() const { return _sliceStallLimit.actualValue; }
+  bool pinWorkers() const { return _pinWorkers.actualValue; }
+  vstring serverSocket() const { return _serverSocket.actualValue; }
+  void setServerSocket(vstring newVal) { _serverSocket.actualValue = newVal; }
   InputSyntax inputSyntax() const { return _inputSyntax.actualValue; }
   void setInputSyntax(InputSyntax newVal) { _inputSyntax.actualValue = newVal; }
   bool normalize() const { return _normalize.actualValue; }
@@ -2042,6 +2060,8 @@ public:
   float satRestartGeometricIncrease() const { return _satRestartGeometricIncrease.actualValue; }
   int satRestartGeometricInit() const { return _satRestartGeometricInit.actualValue; }
   int satRestartLubyFactor() const { return _satRestartLubyFactor.actualValue; }
+  float satRestartGlucoseMargin() const { return _satRestartGlucoseMargin.actualValue; }
+  int satRestartGlucoseMinConflicts() const { return _satRestartGlucoseMinConflicts.actualValue; }
   float satRestartMinisatIncrease() const { return _satRestartMinisatIncrease.actualValue; }
   int satRestartMinisatInit() const { return _satRestartMinisatInit.actualValue; }
   SatRestartStrategy satRestartStrategy() const { return _satRestartStrategy.actualValue; }
@@ -2093,6 +2113,7 @@ public:
   bool bpStartWithRational() const { return _bpStartWithRational.actualValue;}
     
   bool newCNF() const { return _newCNF.actualValue; }
+  unsigned clausifyWorkers() const { return _clausifyWorkers.actualValue; }
   int getIteInliningThreshold() const { return _iteInliningThreshold.actualValue; }
   bool getIteInlineLet() const { return _inlineLet.actualValue; }
 private:
@@ -2252,6 +2273,8 @@ private:
   UnsignedOptionValue _fmbDetectSortBoundsTimeLimit;
   UnsignedOptionValue _fmbSizeWeightRatio;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
+  BoolOptionValue _fmbIncremental;
+  UnsignedOptionValue _fmbParallel;
 
   BoolOptionValue _flattenTopLevelConjunctions;
   StringOptionValue _forbiddenOptions;
@@ -2317,6 +2340,7 @@ private:
   BoolOptionValue _lrsWeightLimitOnly;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
+  UnsignedOptionValue _ltbParallelProblems;
 
   LongOptionValue _maxActive;
   IntOptionValue _maxAnswers;
@@ -2327,7 +2351,14 @@ private:
   UnsignedOptionValue _memoryLimit; // should be size_t, making an assumption
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
+  StringOptionValue _scheduleFile;
+  StringOptionValue _runHistory;
   UnsignedOptionValue _multicore;
+  BoolOptionValue _clauseSharing;
+  UnsignedOptionValue _sliceQuantum;
+  UnsignedOptionValue _sliceStallLimit;
+  BoolOptionValue _pinWorkers;
+  StringOptionValue _serverSocket;
 
   StringOptionValue _namePrefix;
   IntOptionValue _naming;
@@ -2360,6 +2391,8 @@ private:
   FloatOptionValue _satRestartGeometricIncrease;
   IntOptionValue _satRestartGeometricInit;
   IntOptionValue _satRestartLubyFactor;
+  FloatOptionValue _satRestartGlucoseMargin;
+  IntOptionValue _satRestartGlucoseMinConflicts;
   FloatOptionValue _satRestartMinisatIncrease;
   IntOptionValue _satRestartMinisatInit;
   ChoiceOptionValue<SatRestartStrategy> _satRestartStrategy;
@@ -2462,6 +2495,7 @@ private:
   InputFileOptionValue _inputFile;
 
   BoolOptionValue _newCNF;
+  UnsignedOptionValue _clausifyWorkers;
   IntOptionValue _iteInliningThreshold;
   BoolOptionValue _inlineLet;
 
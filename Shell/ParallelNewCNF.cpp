@@ -0,0 +1,438 @@
+
+/*
+ * File ParallelNewCNF.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ParallelNewCNF.cpp
+ * Implements class ParallelNewCNF.
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "NewCNF.hpp"
+#include "Skolem.hpp"
+#include "Statistics.hpp"
+#include "VarManager.hpp"
+
+#include "ParallelNewCNF.hpp"
+
+namespace Shell
+{
+
+using namespace Lib::Sys;
+
+/**
+ * Return true if the formulas of @c prb can be clausified in workers.
+ * FOOL, colors and preserved variable names introduce symbols that cannot
+ * be recreated from their arity and sorts alone.
+ */
+bool ParallelNewCNF::applicable(Problem& prb)
+{
+  CALL("ParallelNewCNF::applicable");
+
+  return !prb.hasFOOL() && !env.colorUsed && !VarManager::varNamePreserving();
+}
+
+/**
+ * Clausify @c units in parallel. On success, the clauses of units[i] are
+ * pushed to @c clauses in the order NewCNF would output them and their
+ * number is pushed to @c counts, and true is returned. On failure false
+ * is returned and neither the signature nor the output stacks are modified.
+ */
+bool ParallelNewCNF::clausify(const Stack<FormulaUnit*>& units, Stack<Clause*>& clauses, Stack<unsigned>& counts)
+{
+  CALL("ParallelNewCNF::clausify");
+
+  unsigned workers = min(_workers, (unsigned)units.size());
+  if (workers<2) {
+    return false;
+  }
+
+  _baseFunctions = env.signature->functions();
+  _basePredicates = env.signature->predicates();
+  _baseSorts = env.sorts->count();
+
+  DArray<int> fds(workers);
+  DArray<pid_t> pids(workers);
+  unsigned chunk = units.size()/workers;
+  unsigned rest = units.size()%workers;
+  unsigned from = 0;
+  for (unsigned w=0; w<workers; w++) {
+    unsigned to = from+chunk+(w<rest ? 1 : 0);
+    int p[2];
+    if (pipe(p)==-1) {
+      SYSTEM_FAIL("Call to pipe() function failed.", errno);
+    }
+    pid_t pid = Multiprocessing::instance()->fork();
+    if (!pid) {
+      close(p[0]);
+      for (unsigned prev=0; prev<w; prev++) {
+        close(fds[prev]);
+      }
+      runWorker(p[1], units, from, to);
+    }
+    close(p[1]);
+    fds[w] = p[0];
+    pids[w] = pid;
+    from = to;
+  }
+  ASS_EQ(from, units.size());
+
+  // read the pipes in chunk order; each worker only writes to its own pipe
+  // and the parent keeps no write end open, so this cannot deadlock
+  DArray<Stack<unsigned> > outputs(workers);
+  bool ok = true;
+  for (unsigned w=0; w<workers; w++) {
+    ok = readWords(fds[w], outputs[w]) && ok;
+    close(fds[w]);
+  }
+  for (unsigned w=0; w<workers; w++) {
+    int resValue;
+    Multiprocessing::instance()->waitForParticularChildTermination(pids[w], resValue);
+    ok = ok && resValue==0;
+  }
+  if (!ok) {
+    return false;
+  }
+  for (unsigned w=0; w<workers; w++) {
+    const Stack<unsigned>& words = outputs[w];
+    if (words.isEmpty() || words.top()!=END_MARKER) {
+      return false;
+    }
+  }
+
+  from = 0;
+  for (unsigned w=0; w<workers; w++) {
+    unsigned to = from+chunk+(w<rest ? 1 : 0);
+    const Stack<unsigned>& words = outputs[w];
+    unsigned pos = 0;
+    addSymbols(words, pos);
+    static Stack<Literal*> lits;
+    for (unsigned i=from; i<to; i++) {
+      FormulaUnit* unit = units[i];
+      unsigned cnt = words[pos++];
+      counts.push(cnt);
+      for (unsigned c=0; c<cnt; c++) {
+        unsigned len = words[pos++];
+        lits.reset();
+        for (unsigned j=0; j<len; j++) {
+          lits.push(decodeLiteral(words, pos));
+        }
+        clauses.push(Clause::fromStack(lits, unit->inputType(), new Inference1(Inference::CLAUSIFY, unit)));
+      }
+    }
+    ASS_EQ(words[pos], END_MARKER);
+    from = to;
+  }
+  return true;
+}
+
+/**
+ * Clausify units[from..to) and send the result through @c fd.
+ * Output words: statistics deltas, the introduced functions (flags, result
+ * sort, arity, argument sorts), the introduced predicates (flags, arity,
+ * argument sorts), then for every unit the number of its clauses and for
+ * every clause its length and literals, and finally END_MARKER.
+ * Does not return.
+ */
+void ParallelNewCNF::runWorker(int fd, const Stack<FormulaUnit*>& units, unsigned from, unsigned to)
+{
+  CALL("ParallelNewCNF::runWorker");
+
+  System::registerForSIGHUPOnParentDeath();
+
+  Stack<unsigned> clauseWords;
+  unsigned skolemFunctions = env.statistics->skolemFunctions;
+  unsigned formulaNames = env.statistics->formulaNames;
+  try {
+    NewCNF cnf(_namingThreshold);
+    Stack<Clause*> clauses(32);
+    for (unsigned i=from; i<to; i++) {
+      cnf.clausify(units[i], clauses);
+      clauseWords.push(clauses.size());
+      Stack<Clause*>::BottomFirstIterator cit(clauses);
+      while (cit.hasNext()) {
+        Clause* cl = cit.next();
+        clauseWords.push(cl->length());
+        for (unsigned j=0; j<cl->length(); j++) {
+          if (!encodeLiteral((*cl)[j], clauseWords)) {
+            exit(1);
+          }
+        }
+      }
+      clauses.reset();
+    }
+  } catch (...) {
+    exit(1);
+  }
+
+  if (env.sorts->count()!=_baseSorts) {
+    exit(1);
+  }
+  Stack<unsigned> words;
+  words.push(env.statistics->skolemFunctions-skolemFunctions);
+  words.push(env.statistics->formulaNames-formulaNames);
+  words.push(env.signature->functions()-_baseFunctions);
+  for (unsigned f=_baseFunctions; f<env.signature->functions(); f++) {
+    Signature::Symbol* sym = env.signature->getFunction(f);
+    if (!sym->skolem()) {
+      exit(1);
+    }
+    OperatorType* type = sym->fnType();
+    words.push(SYM_SKOLEM | (sym->inGoal() ? SYM_IN_GOAL : 0) |
+        (sym->inductionSkolem() ? SYM_INDUCTION_SKOLEM : 0));
+    words.push(type->result());
+    words.push(sym->arity());
+    for (unsigned i=0; i<sym->arity(); i++) {
+      words.push(type->arg(i));
+    }
+  }
+  words.push(env.signature->predicates()-_basePredicates);
+  for (unsigned p=_basePredicates; p<env.signature->predicates(); p++) {
+    Signature::Symbol* sym = env.signature->getPredicate(p);
+    if (!sym->skolem() && !sym->introduced()) {
+      exit(1);
+    }
+    OperatorType* type = sym->predType();
+    words.push((sym->skolem() ? SYM_SKOLEM : 0) | (sym->inGoal() ? SYM_IN_GOAL : 0));
+    words.push(sym->arity());
+    for (unsigned i=0; i<sym->arity(); i++) {
+      words.push(type->arg(i));
+    }
+  }
+  words.loadFromIterator(Stack<unsigned>::BottomFirstIterator(clauseWords));
+  words.push(END_MARKER);
+
+  exit(writeWords(fd, words) ? 0 : 1);
+}
+
+bool ParallelNewCNF::encodeTerm(TermList t, Stack<unsigned>& words)
+{
+  CALL("ParallelNewCNF::encodeTerm");
+
+  if (t.isOrdinaryVar()) {
+    words.push((t.var()<<1) | 1);
+    return true;
+  }
+  if (!t.isTerm() || t.term()->isSpecial()) {
+    return false;
+  }
+  Term* trm = t.term();
+  words.push(trm->functor()<<1);
+  for (TermList* arg = trm->args(); !arg->isEmpty(); arg = arg->next()) {
+    if (!encodeTerm(*arg, words)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParallelNewCNF::encodeLiteral(Literal* l, Stack<unsigned>& words)
+{
+  CALL("ParallelNewCNF::encodeLiteral");
+
+  words.push((l->functor()<<1) | (l->isPositive() ? 1 : 0));
+  if (l->isEquality()) {
+    words.push(SortHelper::getEqualityArgumentSort(l));
+  }
+  for (TermList* arg = l->args(); !arg->isEmpty(); arg = arg->next()) {
+    if (!encodeTerm(*arg, words)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParallelNewCNF::writeWords(int fd, const Stack<unsigned>& words)
+{
+  CALL("ParallelNewCNF::writeWords");
+
+  const char* buf = reinterpret_cast<const char*>(words.begin());
+  size_t left = words.size()*sizeof(unsigned);
+  while (left) {
+    ssize_t res = write(fd, buf, left);
+    if (res==-1) {
+      if (errno==EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buf += res;
+    left -= res;
+  }
+  return true;
+}
+
+/**
+ * Read words from @c fd until the end of file. Return false if the
+ * read fails or ends in the middle of a word.
+ */
+bool ParallelNewCNF::readWords(int fd, Stack<unsigned>& words)
+{
+  CALL("ParallelNewCNF::readWords");
+
+  static const size_t BUF_WORDS = 4096;
+  unsigned buf[BUF_WORDS];
+  size_t have = 0; // bytes of buf filled
+  for (;;) {
+    ssize_t res = read(fd, reinterpret_cast<char*>(buf)+have, sizeof(buf)-have);
+    if (res==-1) {
+      if (errno==EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (res==0) {
+      return have==0;
+    }
+    have += res;
+    size_t complete = have/sizeof(unsigned);
+    for (size_t i=0; i<complete; i++) {
+      words.push(buf[i]);
+    }
+    size_t partial = have%sizeof(unsigned);
+    if (partial) {
+      buf[0] = buf[complete];
+    }
+    have = partial;
+  }
+}
+
+/**
+ * Add to the signature the symbols a worker introduced and fill in
+ * _functionMap and _predicateMap.
+ */
+void ParallelNewCNF::addSymbols(const Stack<unsigned>& words, unsigned& pos)
+{
+  CALL("ParallelNewCNF::addSymbols");
+
+  static Stack<unsigned> sorts;
+
+  env.statistics->skolemFunctions += words[pos++];
+  env.statistics->formulaNames += words[pos++];
+
+  unsigned funs = words[pos++];
+  _functionMap.ensure(funs);
+  for (unsigned i=0; i<funs; i++) {
+    unsigned flags = words[pos++];
+    unsigned range = words[pos++];
+    unsigned arity = words[pos++];
+    sorts.reset();
+    for (unsigned j=0; j<arity; j++) {
+      sorts.push(words[pos++]);
+    }
+    ASS(flags & SYM_SKOLEM);
+    unsigned fun = Skolem::addSkolemFunction(arity, sorts.begin(), range);
+    Signature::Symbol* sym = env.signature->getFunction(fun);
+    if (flags & SYM_IN_GOAL) {
+      sym->markInGoal();
+    }
+    if (flags & SYM_INDUCTION_SKOLEM) {
+      sym->markInductionSkolem();
+    }
+    _functionMap[i] = fun;
+  }
+
+  unsigned preds = words[pos++];
+  _predicateMap.ensure(preds);
+  for (unsigned i=0; i<preds; i++) {
+    unsigned flags = words[pos++];
+    unsigned arity = words[pos++];
+    sorts.reset();
+    for (unsigned j=0; j<arity; j++) {
+      sorts.push(words[pos++]);
+    }
+    unsigned pred;
+    if (flags & SYM_SKOLEM) {
+      pred = Skolem::addSkolemPredicate(arity, sorts.begin());
+    } else {
+      pred = env.signature->addNamePredicate(arity);
+      env.signature->getPredicate(pred)->setType(OperatorType::getPredicateType(arity, sorts.begin()));
+    }
+    if (flags & SYM_IN_GOAL) {
+      env.signature->getPredicate(pred)->markInGoal();
+    }
+    _predicateMap[i] = pred;
+  }
+}
+
+TermList ParallelNewCNF::decodeTerm(const Stack<unsigned>& words, unsigned& pos)
+{
+  CALL("ParallelNewCNF::decodeTerm");
+
+  unsigned word = words[pos++];
+  if (word & 1) {
+    return TermList(word>>1, false);
+  }
+  unsigned fn = word>>1;
+  if (fn>=_baseFunctions) {
+    fn = _functionMap[fn-_baseFunctions];
+  }
+  unsigned arity = env.signature->functionArity(fn);
+  if (arity==0) {
+    return TermList(Term::createConstant(fn));
+  }
+  DArray<TermList> args(arity);
+  for (unsigned i=0; i<arity; i++) {
+    args[i] = decodeTerm(words, pos);
+  }
+  return TermList(Term::create(fn, arity, args.array()));
+}
+
+Literal* ParallelNewCNF::decodeLiteral(const Stack<unsigned>& words, unsigned& pos)
+{
+  CALL("ParallelNewCNF::decodeLiteral");
+
+  unsigned header = words[pos++];
+  unsigned pred = header>>1;
+  bool polarity = header & 1;
+  if (pred==0) {
+    unsigned sort = words[pos++];
+    TermList lhs = decodeTerm(words, pos);
+    TermList rhs = decodeTerm(words, pos);
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+  if (pred>=_basePredicates) {
+    pred = _predicateMap[pred-_basePredicates];
+  }
+  unsigned arity = env.signature->predicateArity(pred);
+  DArray<TermList> args(arity);
+  for (unsigned i=0; i<arity; i++) {
+    args[i] = decodeTerm(words, pos);
+  }
+  return Literal::create(pred, arity, polarity, false, args.array());
+}
+
+}
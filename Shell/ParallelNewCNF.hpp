@@ -0,0 +1,98 @@
+
+/*
+ * File ParallelNewCNF.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ParallelNewCNF.hpp
+ * Defines class ParallelNewCNF running NewCNF in forked workers.
+ */
+
+#ifndef __ParallelNewCNF__
+#define __ParallelNewCNF__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Clausifies formula units with NewCNF in forked worker processes.
+ *
+ * The units are split into consecutive chunks, one per worker. Each worker
+ * clausifies its chunk against a private copy of the signature and sends
+ * the introduced symbols and the clauses back through a pipe. Only when all
+ * workers succeeded does the parent add the symbols, chunk by chunk, so the
+ * numbering depends on the input and the number of workers but not on timing.
+ * If anything goes wrong the parent is left untouched and the caller is
+ * expected to clausify sequentially.
+ */
+class ParallelNewCNF
+{
+public:
+  CLASS_NAME(ParallelNewCNF);
+  USE_ALLOCATOR(ParallelNewCNF);
+
+  ParallelNewCNF(unsigned namingThreshold, unsigned workers)
+    : _namingThreshold(namingThreshold), _workers(workers) {}
+
+  static bool applicable(Problem& prb);
+
+  bool clausify(const Stack<FormulaUnit*>& units, Stack<Clause*>& clauses, Stack<unsigned>& counts);
+
+private:
+  enum {
+    /** the word closing a worker's output */
+    END_MARKER = 0xffffffffu,
+    SYM_SKOLEM = 1,
+    SYM_IN_GOAL = 2,
+    SYM_INDUCTION_SKOLEM = 4
+  };
+
+  void runWorker(int fd, const Stack<FormulaUnit*>& units, unsigned from, unsigned to);
+  bool encodeTerm(TermList t, Stack<unsigned>& words);
+  bool encodeLiteral(Literal* l, Stack<unsigned>& words);
+  static bool writeWords(int fd, const Stack<unsigned>& words);
+  static bool readWords(int fd, Stack<unsigned>& words);
+
+  void addSymbols(const Stack<unsigned>& words, unsigned& pos);
+  TermList decodeTerm(const Stack<unsigned>& words, unsigned& pos);
+  Literal* decodeLiteral(const Stack<unsigned>& words, unsigned& pos);
+
+  unsigned _namingThreshold;
+  unsigned _workers;
+
+  /** signature sizes at the time of the fork */
+  unsigned _baseFunctions;
+  unsigned _basePredicates;
+  unsigned _baseSorts;
+
+  /** maps symbols introduced by the worker being decoded to parent symbols */
+  DArray<unsigned> _functionMap;
+  DArray<unsigned> _predicateMap;
+};
+
+}
+
+#endif // __ParallelNewCNF__
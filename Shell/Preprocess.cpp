@@ -35,6 +35,7 @@
 #include "AnswerExtractor.hpp"
 #include "CNF.hpp"
 #include "NewCNF.hpp"
+#include "ParallelNewCNF.hpp"
 #include "DistinctGroupExpansion.hpp"
 #include "EqResWithDeletion.hpp"
 #include "EqualityProxy.hpp"
@@ -455,6 +456,7 @@ void Preprocess::preprocess1 (Problem& prb)
   UnitList::DelIterator us(units);
   while (us.hasNext()) {
     Unit* u = us.next();
+    env.timeSafePointSometime<16>();
     if (u->isClause()) {
       continue;
     }
@@ -504,6 +506,7 @@ void Preprocess::preprocess2(Problem& prb)
   UnitList::DelIterator us(prb.units());
   while (us.hasNext()) {
     Unit* u = us.next();
+    env.timeSafePointSometime<16>();
 
     if (u->isClause()) {
 	continue;
@@ -534,6 +537,7 @@ void Preprocess::naming(Problem& prb)
   Naming naming(_options.naming(),false); // For now just force eprPreservingNaming to be false, should update Naming
   while (us.hasNext()) {
     Unit* u = us.next();
+    env.timeSafePointSometime<16>();
     if (u->isClause()) {
       continue;
     }
@@ -565,11 +569,32 @@ void Preprocess::newCnf(Problem& prb)
 
   bool modified = false;
 
+  // with several workers the clauses of all formula units are computed
+  // up front; the loop below then only splices them in
+  bool parallel = false;
+  Stack<Clause*> parallelClauses;
+  Stack<unsigned> parallelCounts;
+  if (env.options->clausifyWorkers()>1 && ParallelNewCNF::applicable(prb)) {
+    Stack<FormulaUnit*> formulas;
+    UnitList::Iterator uit(prb.units());
+    while (uit.hasNext()) {
+      Unit* u = uit.next();
+      if (!u->isClause()) {
+        formulas.push(static_cast<FormulaUnit*>(u));
+      }
+    }
+    ParallelNewCNF pcnf(env.options->naming(), env.options->clausifyWorkers());
+    parallel = pcnf.clausify(formulas, parallelClauses, parallelCounts);
+  }
+  unsigned nextUnit = 0;
+  unsigned nextClause = 0;
+
   UnitList::DelIterator us(prb.units());
   NewCNF cnf(env.options->naming());
   Stack<Clause*> clauses(32);
   while (us.hasNext()) {
     Unit* u = us.next();
+    env.timeSafePointSometime<16>();
     if (env.options->showPreprocessing()) {
       env.beginOutput();
       env.out() << "[PP] clausify: " << u->toString() << std::endl;
@@ -584,7 +609,14 @@ void Preprocess::newCnf(Problem& prb)
     }
     modified = true;
     FormulaUnit* fu = static_cast<FormulaUnit*>(u);
-    cnf.clausify(fu,clauses);
+    if (parallel) {
+      unsigned cnt = parallelCounts[nextUnit++];
+      for (unsigned i=0; i<cnt; i++) {
+        clauses.push(parallelClauses[nextClause++]);
+      }
+    } else {
+      cnf.clausify(fu,clauses);
+    }
     while (! clauses.isEmpty()) {
       Clause* cl = clauses.pop();
       if (cl->isEmpty()) {
@@ -661,6 +693,7 @@ void Preprocess::preprocess3 (Problem& prb)
   UnitList::DelIterator us(prb.units());
   while (us.hasNext()) {
     Unit* u = us.next();
+    env.timeSafePointSometime<16>();
     Unit* v = preprocess3(u);
     if (u!=v) {
       us.replace(v);
@@ -689,6 +722,7 @@ void Preprocess::clausify(Problem& prb)
   Stack<Clause*> clauses(32);
   while (us.hasNext()) {
     Unit* u = us.next();
+    env.timeSafePointSometime<16>();
     if (env.options->showPreprocessing()) {
       env.beginOutput();
       env.out() << "[PP] clausify: " << u->toString() << std::endl;
@@ -266,251 +266,216 @@ void SineBase::initGeneralityFunction(UnitList* units)
   }
 }
 
-SineSelector::SineSelector(const Options& opt)
-: _onIncluded(opt.sineSelection()==Options::SineSelection::INCLUDED),
-  _genThreshold(opt.sineGeneralityThreshold()),
-  _tolerance(opt.sineTolerance()),
-  _depthLimit(opt.sineDepth())
-{
-  CALL("SineSelector::SineSelector/0");
-
-  if(opt.sineSelection()==Options::SineSelection::PRIORITY){
-    env.clausePriorities = new DHMap<const Unit*,unsigned>();
-  }
-
-  init();
-}
-
-SineSelector::SineSelector(bool onIncluded, float tolerance, unsigned depthLimit, unsigned genThreshold)
-: _onIncluded(onIncluded),
-  _genThreshold(genThreshold),
-  _tolerance(tolerance),
-  _depthLimit(depthLimit)
-{
-  CALL("SineSelector::SineSelector/4");
-
-  init();
-}
+//////////////////////////////////////
+// SineIndex
+//////////////////////////////////////
 
-void SineSelector::init()
+SineIndex::SineIndex(UnitList* units)
 {
-  CALL("SineSelector::init");
-  ASS(_tolerance>=1.0f || _tolerance==-1);
-
-  _strict=_tolerance==1.0f;
-}
-
-/**
- * Connect unit @b u with symbols it defines
- */
-void SineSelector::updateDefRelation(Unit* u)
-{
-  CALL("SineSelector::updateDefRelation");
-
-  SymIdIterator sit=_symExtr.extractSymIds(u);
-
-  if (!sit.hasNext()) {
-    if(env.clausePriorities){
-      env.clausePriorities->insert(u,1);
-    }
-    _unitsWithoutSymbols.push(u);
-    return;
-  }
-
-  static Stack<SymId> equalGenerality;
-  equalGenerality.reset();
-
-  SymId leastGenSym=sit.next();
-  unsigned leastGenVal=_gen[leastGenSym];
+  CALL("SineIndex::SineIndex");
 
-  //it a symbol fits under _genThreshold, add it immediately [into the relation]
-  if (leastGenVal<=_genThreshold) {
-    UnitList::push(u,_def[leastGenSym]);
-  }
+  TimeCounter tc(TC_SINE_SELECTION);
 
-  while (sit.hasNext()) {
-    SymId sym=sit.next();
-    unsigned val=_gen[sym];
-    ASS_G(val,0);
+  initGeneralityFunction(units);
+  _symIdBound=_symExtr.getSymIdBound();
 
-    //it a symbol fits under _genThreshold, add it immediately [into the relation]
-    if (val<=_genThreshold) {
-      UnitList::push(u,_def[sym]);
-    }
+  unsigned unitCnt=UnitList::length(units);
+  _units.init(unitCnt,0);
+  _unitNumbers.init(unitCnt,0);
+  _leastGen.init(unitCnt,0);
+  _unitSymStart.init(unitCnt+1,0);
 
-    if (val<leastGenVal) {
-      leastGenSym=sym;
-      leastGenVal=val;
-      equalGenerality.reset();
-    } else if (val==leastGenVal) {
-      equalGenerality.push(sym);
-    }
-  }
+  Stack<SymId> syms;
 
+  unsigned idx=0;
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    _units[idx]=u;
+    _unitNumbers[idx]=u->number();
+    _unitSymStart[idx]=syms.size();
 
-  if (_strict) {
-    //only if the least general symbol is over _genThreshold; otherwise it is already added
-    if (leastGenVal>_genThreshold) {
-      UnitList::push(u,_def[leastGenSym]);
-      while (equalGenerality.isNonEmpty()) {
-        UnitList::push(u,_def[equalGenerality.pop()]);
+    SymIdIterator sit=_symExtr.extractSymIds(u);
+    while (sit.hasNext()) {
+      SymId sym=sit.next();
+      unsigned val=_gen[sym];
+      ASS_G(val,0);
+      if (!_leastGen[idx] || val<_leastGen[idx]) {
+        _leastGen[idx]=val;
       }
+      syms.push(sym);
     }
+    idx++;
   }
-  else {
-    unsigned generalityLimit=static_cast<int>(leastGenVal*_tolerance);
-    if (_tolerance==-1.0f) {
-      generalityLimit = UINT_MAX;
-    }
+  _unitSymStart[unitCnt]=syms.size();
+  _unitSyms.initFromArray(syms.size(),syms);
+
+  //each unit contributes to gen(s) exactly once for each of its symbols,
+  //so the generality function gives the row lengths
+  _symUnitStart.init(_symIdBound+1,0);
+  for (SymId s=0;s<_symIdBound;s++) {
+    _symUnitStart[s+1]=_symUnitStart[s]+_gen[s];
+  }
+  _symUnits.init(syms.size(),0);
 
-    //if the generalityLimit is under _genThreshold, all suitable symbols are already added
-    if (generalityLimit>_genThreshold) {
-      sit=_symExtr.extractSymIds(u);
-      while (sit.hasNext()) {
-	SymId sym=sit.next();
-	unsigned val=_gen[sym];
-	//only if the symbol is over _genThreshold; otherwise it is already added
-	if (val>_genThreshold && val<=generalityLimit) {
-	  UnitList::push(u,_def[sym]);
-	}
-      }
+  DArray<unsigned> fill;
+  fill.initFromArray(_symIdBound,_symUnitStart);
+  for (unsigned i=unitCnt;i>0;i--) {
+    for (unsigned j=_unitSymStart[i-1];j<_unitSymStart[i];j++) {
+      _symUnits[fill[_unitSyms[j]]++]=i-1;
     }
   }
-
 }
 
-void SineSelector::perform(Problem& prb)
+/**
+ * Return true iff the index was built for exactly the units of @b units,
+ * in the same order
+ */
+bool SineIndex::isIndexOf(UnitList* units)
 {
-  CALL("SineSelector::perform");
+  CALL("SineIndex::isIndexOf");
 
-  if (perform(prb.units())) {
-    prb.reportIncompleteTransformation();
+  unsigned idx=0;
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    if (idx==_units.size() || _units[idx]!=u || _unitNumbers[idx]!=u->number()) {
+      return false;
+    }
+    idx++;
   }
-  prb.invalidateByRemoval();
+  return idx==_units.size();
 }
 
-bool SineSelector::perform(UnitList*& units)
+/**
+ * Perform the SInE selection on @b units, which must be the indexed list
+ *
+ * Return true iff some units were removed.
+ */
+bool SineIndex::select(UnitList*& units, bool onIncluded, float tolerance, unsigned depthLimit, unsigned genThreshold)
 {
-  CALL("SineSelector::perform");
+  CALL("SineIndex::select");
+  ASS(isIndexOf(units));
+  ASS(tolerance>=1.0f || tolerance==-1);
 
   TimeCounter tc(TC_SINE_SELECTION);
 
-  initGeneralityFunction(units);
+  unsigned unitCnt=_units.size();
 
-  SymId symIdBound=_symExtr.getSymIdBound();
+  DArray<bool> selected;
+  selected.init(unitCnt,false);
+  DArray<bool> symProcessed;
+  symProcessed.init(_symIdBound,false);
+  //an axiom defines all its symbols whose generality is at most this value
+  DArray<unsigned> genLimit;
+  genLimit.init(unitCnt,0);
 
-  Set<Unit*> selected;
+  Stack<Unit*> unitsWithoutSymbols;
   Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
-  Deque<Unit*> newlySelected;
+  Deque<unsigned> newlySelected;
 
-  //build the D-relation and select the non-axiom formulas
-  _def.init(symIdBound,0);
-  unsigned numberUnitsLeftOut = 0;
-  UnitList::Iterator uit2(units);
-  while (uit2.hasNext()) {
-    numberUnitsLeftOut++;
-    Unit* u=uit2.next();
-    bool performSelection= _onIncluded ? u->included() : ((u->inputType()==Unit::AXIOM)
+  //compute the generality limits and select the non-axiom formulas
+  for (unsigned i=0;i<unitCnt;i++) {
+    Unit* u=_units[i];
+    bool performSelection= onIncluded ? u->included() : ((u->inputType()==Unit::AXIOM)
                             || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==Unit::ASSUMPTION));
     if (performSelection) {
-      updateDefRelation(u);
+      if (_unitSymStart[i]==_unitSymStart[i+1]) {
+        if(env.clausePriorities){
+          env.clausePriorities->insert(u,1);
+        }
+        unitsWithoutSymbols.push(u);
+        continue;
+      }
+      unsigned limit=static_cast<int>(_leastGen[i]*tolerance);
+      if (tolerance==-1.0f) {
+        limit=UINT_MAX;
+      }
+      genLimit[i]=max(limit,genThreshold);
     }
     else {
-      selected.insert(u);
+      selected[i]=true;
       selectedStack.push(u);
-      newlySelected.push_back(u);
+      newlySelected.push_back(i);
 
       if(env.clausePriorities && !env.clausePriorities->find(u)){
         env.clausePriorities->insert(u,1);
-        //cout << "set priority for " << u->toString() << " as " << (1) << endl;
       }
     }
   }
 
+  static const unsigned LEVEL_MARK=UINT_MAX;
+
   unsigned depth=0;
-  newlySelected.push_back(0);
+  newlySelected.push_back(LEVEL_MARK);
 
   //select required axiom formulas
   while (newlySelected.isNonEmpty()) {
-    Unit* u=newlySelected.pop_front();
+    unsigned ui=newlySelected.pop_front();
 
-    if (!u) {
+    if (ui==LEVEL_MARK) {
       //next selected formulas will be one step further from the original formulas
       depth++;
-      
-      if (_depthLimit && depth==_depthLimit) {
+
+      if (depthLimit && depth==depthLimit) {
 	break;
       }
-      ASS(!_depthLimit || depth<_depthLimit);
+      ASS(!depthLimit || depth<depthLimit);
       env.maxClausePriority++;
 
       if (newlySelected.isNonEmpty()) {
 	//we must push another mark if we're not done yet
-	newlySelected.push_back(0);
+	newlySelected.push_back(LEVEL_MARK);
       }
       continue;
     }
 
-    SymIdIterator sit=_symExtr.extractSymIds(u);
-    while (sit.hasNext()) {
-      SymId sym=sit.next();
-      UnitList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-	Unit* du=defUnits.next();
-	if (selected.contains(du)) {
-	  continue;
-	}
-	selected.insert(du);
-	selectedStack.push(du);
-	newlySelected.push_back(du);
+    for (unsigned j=_unitSymStart[ui];j<_unitSymStart[ui+1];j++) {
+      SymId sym=_unitSyms[j];
+      if (symProcessed[sym]) {
+        continue;
+      }
+      //all units defining sym get selected now
+      symProcessed[sym]=true;
+
+      unsigned val=_gen[sym];
+      for (unsigned k=_symUnitStart[sym];k<_symUnitStart[sym+1];k++) {
+        unsigned di=_symUnits[k];
+        if (selected[di] || val>genLimit[di]) {
+          continue;
+        }
+        Unit* du=_units[di];
+        selected[di]=true;
+        selectedStack.push(du);
+        newlySelected.push_back(di);
 
         // If in LTB mode we may already have added du with a priority
         if(env.clausePriorities && !env.clausePriorities->find(du)){
           env.clausePriorities->insert(du,env.maxClausePriority);
-          //cout << "set priority for " << du->toString() << " as " << env.maxClausePriority << endl;
         }
-
       }
-      //all defining units for the symbol sym were selected,
-      //so we can remove them from the relation
-      UnitList::destroy(_def[sym]);
-      _def[sym]=0;
     }
   }
 
   env.statistics->sineIterations=depth;
-  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + selectedStack.size();
+  env.statistics->selectedBySine=unitsWithoutSymbols.size() + selectedStack.size();
 
-  numberUnitsLeftOut -= env.statistics->selectedBySine;
+  unsigned numberUnitsLeftOut = unitCnt - env.statistics->selectedBySine;
 
   UnitList::destroy(units);
   units=0;
-  UnitList::pushFromIterator(Stack<Unit*>::Iterator(_unitsWithoutSymbols), units);
+  UnitList::pushFromIterator(Stack<Unit*>::Iterator(unitsWithoutSymbols), units);
   while (selectedStack.isNonEmpty()) {
     UnitList::push(selectedStack.pop(), units);
   }
 
-
 #if VDEBUG
-if(env.clausePriorities){
-  UnitList::Iterator selIt(units);
-  bool allSelectedProcessed = true;
-  //bool maxSeen = false;
-  while (selIt.hasNext()) {
-    Unit* u = selIt.next();
-    if(!env.clausePriorities->find(u)){
-      //cout << "Missing " << u->toString() << endl;
-      allSelectedProcessed=false;
+  if(env.clausePriorities){
+    UnitList::Iterator selIt(units);
+    while (selIt.hasNext()) {
+      ASS(env.clausePriorities->find(selIt.next()));
     }
-    else{
-      //if(env.maxClausePriority == env.clausePriorities->get(u)){
-      //  maxSeen=true;
-      //}
-    } 
   }
-  ASS(allSelectedProcessed);
-  //ASS(maxSeen);
-}
 #endif
 
 #if SINE_PRINT_SELECTED
@@ -523,6 +488,81 @@ if(env.clausePriorities){
   return (numberUnitsLeftOut > 0);
 }
 
+//////////////////////////////////////
+// SineSelector
+//////////////////////////////////////
+
+SineIndex* SineSelector::s_index = 0;
+
+SineSelector::SineSelector(const Options& opt)
+: _onIncluded(opt.sineSelection()==Options::SineSelection::INCLUDED),
+  _genThreshold(opt.sineGeneralityThreshold()),
+  _tolerance(opt.sineTolerance()),
+  _depthLimit(opt.sineDepth())
+{
+  CALL("SineSelector::SineSelector/0");
+
+  if(opt.sineSelection()==Options::SineSelection::PRIORITY){
+    env.clausePriorities = new DHMap<const Unit*,unsigned>();
+  }
+
+  init();
+}
+
+SineSelector::SineSelector(bool onIncluded, float tolerance, unsigned depthLimit, unsigned genThreshold)
+: _onIncluded(onIncluded),
+  _genThreshold(genThreshold),
+  _tolerance(tolerance),
+  _depthLimit(depthLimit)
+{
+  CALL("SineSelector::SineSelector/4");
+
+  init();
+}
+
+void SineSelector::init()
+{
+  CALL("SineSelector::init");
+  ASS(_tolerance>=1.0f || _tolerance==-1);
+}
+
+/**
+ * Build the SInE index of @b units and keep it for subsequent selections
+ *
+ * The portfolio mode calls this before forking the strategy processes,
+ * so that each slice selecting on the unchanged problem only does the
+ * final traversal.
+ */
+void SineSelector::buildIndex(UnitList* units)
+{
+  CALL("SineSelector::buildIndex");
+
+  if (s_index) {
+    delete s_index;
+  }
+  s_index=new SineIndex(units);
+}
+
+void SineSelector::perform(Problem& prb)
+{
+  CALL("SineSelector::perform");
+
+  if (perform(prb.units())) {
+    prb.reportIncompleteTransformation();
+  }
+  prb.invalidateByRemoval();
+}
+
+bool SineSelector::perform(UnitList*& units)
+{
+  CALL("SineSelector::perform");
+
+  if (!s_index || !s_index->isIndexOf(units)) {
+    buildIndex(units);
+  }
+  return s_index->select(units, _onIncluded, _tolerance, _depthLimit, _genThreshold);
+}
+
 //////////////////////////////////////
 // SineTheorySelector
 //////////////////////////////////////
@@ -67,11 +67,59 @@ protected:
   SineSymbolExtractor _symExtr;
 };
 
+/**
+ * Symbol occurrences and the unit-symbol incidence of a problem,
+ * stored in compressed-row form
+ *
+ * The D-relation is not materialised: an axiom @b u defines a symbol
+ * @b s iff gen(s) is at most the generality limit of @b u, which is
+ * computed from the least general symbol of @b u at selection time.
+ * Therefore the same index serves a selection with any tolerance,
+ * depth limit and generality threshold.
+ */
+class SineIndex
+  : public SineBase
+{
+public:
+  CLASS_NAME(SineIndex);
+  USE_ALLOCATOR(SineIndex);
+
+  SineIndex(UnitList* units);
+
+  bool isIndexOf(UnitList* units);
+  bool select(UnitList*& units, bool onIncluded, float tolerance, unsigned depthLimit, unsigned genThreshold);
+private:
+  SymId _symIdBound;
+
+  /** The indexed units in the order of the original list */
+  DArray<Unit*> _units;
+  /** Numbers of the indexed units, to recognise reused addresses */
+  DArray<unsigned> _unitNumbers;
+  /** Generality of the least general symbol of each unit (0 for units without symbols) */
+  DArray<unsigned> _leastGen;
+
+  /** Symbols of the i-th unit are _unitSyms[_unitSymStart[i]] .. _unitSyms[_unitSymStart[i+1]-1] */
+  DArray<unsigned> _unitSymStart;
+  DArray<SymId> _unitSyms;
+
+  /**
+   * Indexes of units containing symbol s are
+   * _symUnits[_symUnitStart[s]] .. _symUnits[_symUnitStart[s+1]-1],
+   * in the reverse order of the original list
+   */
+  DArray<unsigned> _symUnitStart;
+  DArray<unsigned> _symUnits;
+};
+
 /**
  * Class that performs the SInE axiom selection on a single problem
+ *
+ * The selection is done over a @b SineIndex which is kept for the
+ * lifetime of the process, so that repeated selections on the same
+ * unit list (and selections in processes forked after @b buildIndex()
+ * was called) do not recompute it.
  */
 class SineSelector
-  : public SineBase
 {
 public:
   SineSelector(const Options& opt);
@@ -79,26 +127,17 @@ public:
 
   bool perform(UnitList*& units); // returns true iff removed something
   void perform(Problem& prb);
+
+  static void buildIndex(UnitList* units);
 private:
   void init();
 
-  void updateDefRelation(Unit* u);
-
   bool _onIncluded;
-  bool _strict;
   unsigned _genThreshold;
   float _tolerance;
   unsigned _depthLimit;
 
-  /** Stored the D-relation */
-  DArray<UnitList*> _def;
-
-  /**
-   * Stored formulas that don't contain any symbols
-   *
-   * These formulas are always selected.
-   */
-  Stack<Unit*> _unitsWithoutSymbols;
+  static SineIndex* s_index;
 };
 
 
@@ -0,0 +1,188 @@
+
+/*
+ * File SliceProgress.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SliceProgress.cpp
+ * Implements class SliceProgress.
+ */
+
+#include <time.h>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/TimeCounter.hpp"
+
+#include "Statistics.hpp"
+
+#include "SliceProgress.hpp"
+
+namespace Shell
+{
+
+SliceProgress* SliceProgress::s_instance = 0;
+
+SliceProgress::SliceProgress(unsigned slots)
+: _memory(slots*sizeof(Record)), _slots(slots), _ownSlot(NO_SLOT)
+{
+  CALL("SliceProgress::SliceProgress");
+
+  _records = static_cast<Record*>(_memory.address());
+}
+
+/**
+ * Create the progress board with @b slots records. To be called in
+ * the parent process before the slices are forked.
+ */
+void SliceProgress::create(unsigned slots)
+{
+  CALL("SliceProgress::create");
+  ASS(!s_instance);
+
+  s_instance = new SliceProgress(slots);
+}
+
+/**
+ * Prepare record @b slot for a new slice. To be called by the parent
+ * right before the slice is forked.
+ */
+void SliceProgress::clear(unsigned slot)
+{
+  CALL("SliceProgress::clear");
+  ASS_L(slot,_slots);
+
+  Record& r = _records[slot];
+  __atomic_store_n(&r.pid, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.activations, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.active, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.passive, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.memory, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.lastWeight, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.phase, static_cast<unsigned>(Statistics::INITIALIZATION), __ATOMIC_RELAXED);
+  __atomic_store_n(&r.timeCounter, static_cast<unsigned>(TC_OTHER), __ATOMIC_RELAXED);
+  __atomic_store_n(&r.heartbeat, now(), __ATOMIC_RELAXED);
+}
+
+/**
+ * Make the current process the one updating record @b slot.
+ * To be called by the slice right after it is forked.
+ */
+void SliceProgress::attach(unsigned slot)
+{
+  CALL("SliceProgress::attach");
+  ASS_L(slot,_slots);
+
+  _ownSlot = slot;
+  __atomic_store_n(&_records[slot].heartbeat, now(), __ATOMIC_RELAXED);
+  __atomic_store_n(&_records[slot].pid, getpid(), __ATOMIC_RELEASE);
+}
+
+/**
+ * Stamp record @b slot with the current time without any progress.
+ * To be called by the parent when it resumes a suspended slice, so that
+ * the time it spent suspended does not count as lack of progress.
+ */
+void SliceProgress::touch(unsigned slot)
+{
+  CALL("SliceProgress::touch");
+  ASS_L(slot,_slots);
+
+  __atomic_store_n(&_records[slot].heartbeat, now(), __ATOMIC_RELAXED);
+}
+
+/**
+ * Record the current progress of the proof search, if the current
+ * process is attached to a record
+ */
+void SliceProgress::update(unsigned activations, unsigned active, unsigned passive, size_t memory, unsigned lastWeight)
+{
+  if (_ownSlot==NO_SLOT) {
+    return;
+  }
+  Record& r = _records[_ownSlot];
+  __atomic_store_n(&r.activations, activations, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.active, active, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.passive, passive, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.memory, memory, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.lastWeight, lastWeight, __ATOMIC_RELAXED);
+  __atomic_store_n(&r.phase, static_cast<unsigned>(env.statistics->phase), __ATOMIC_RELAXED);
+  __atomic_store_n(&r.heartbeat, now(), __ATOMIC_RELAXED);
+}
+
+/**
+ * Assign to @b res the progress of the slice running in process @b pid
+ * and return true, or return false if no record belongs to the process
+ */
+bool SliceProgress::read(pid_t pid, Record& res) const
+{
+  CALL("SliceProgress::read");
+
+  for (unsigned i=0; i<_slots; i++) {
+    Record& r = _records[i];
+    if (__atomic_load_n(&r.pid, __ATOMIC_ACQUIRE)!=pid) {
+      continue;
+    }
+    res.pid = pid;
+    res.activations = __atomic_load_n(&r.activations, __ATOMIC_RELAXED);
+    res.active = __atomic_load_n(&r.active, __ATOMIC_RELAXED);
+    res.passive = __atomic_load_n(&r.passive, __ATOMIC_RELAXED);
+    res.memory = __atomic_load_n(&r.memory, __ATOMIC_RELAXED);
+    res.lastWeight = __atomic_load_n(&r.lastWeight, __ATOMIC_RELAXED);
+    res.phase = __atomic_load_n(&r.phase, __ATOMIC_RELAXED);
+    res.timeCounter = __atomic_load_n(&r.timeCounter, __ATOMIC_RELAXED);
+    res.heartbeat = __atomic_load_n(&r.heartbeat, __ATOMIC_RELAXED);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Milliseconds of a monotonic clock, the same in all the processes.
+ * The value wraps around, so only differences make sense.
+ */
+unsigned SliceProgress::now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<unsigned>(ts.tv_sec*1000 + ts.tv_nsec/1000000);
+}
+
+/**
+ * Output @b rec in a single line, without the line end
+ */
+void SliceProgress::output(ostream& out, const Record& rec)
+{
+  CALL("SliceProgress::output");
+
+  out << "pid " << rec.pid
+      << ", phase " << Statistics::phaseToString(static_cast<Statistics::ExecutionPhase>(rec.phase));
+  if (rec.timeCounter!=TC_OTHER) {
+    out << " (";
+    TimeCounter::outputUnitName(static_cast<TimeCounterUnit>(rec.timeCounter), out);
+    out << ")";
+  }
+  out << ", activations " << rec.activations
+      << ", active " << rec.active
+      << ", passive " << rec.passive
+      << ", last weight " << rec.lastWeight
+      << ", memory " << rec.memory/1048576 << " MB"
+      << ", last update " << (now()-rec.heartbeat) << " ms ago";
+}
+
+}
@@ -0,0 +1,126 @@
+
+/*
+ * File SliceProgress.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SliceProgress.hpp
+ * Defines class SliceProgress.
+ */
+
+#ifndef __SliceProgress__
+#define __SliceProgress__
+
+#include <ostream>
+#include <unistd.h>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Sys/SharedMemory.hpp"
+
+namespace Shell {
+
+using namespace std;
+using namespace Lib;
+
+/**
+ * Progress of the proof search of forked slices, as seen by their parent.
+ *
+ * The records live in memory shared with the children forked after the
+ * object was created. Before forking a slice, the parent clears a free
+ * record, the child attaches to it and keeps updating it during the
+ * proof search. Each field is written atomically, but a record as a whole
+ * may be read while being updated, so the readers only get a snapshot
+ * of the separate numbers.
+ *
+ * Each update also stamps the record with the time of a monotonic clock
+ * common to all the processes, so the parent can tell a slice that stopped
+ * making progress from a slow one.
+ */
+class SliceProgress
+{
+public:
+  CLASS_NAME(SliceProgress);
+  USE_ALLOCATOR(SliceProgress);
+
+  struct Record
+  {
+    /** the process updating the record, 0 if there is none yet */
+    pid_t pid;
+    /** number of clause activations */
+    unsigned activations;
+    /** current size of the active container */
+    unsigned active;
+    /** current size of the passive container */
+    unsigned passive;
+    /** memory used, in bytes */
+    size_t memory;
+    /** weight of the last selected clause */
+    unsigned lastWeight;
+    /** the Statistics::ExecutionPhase of the slice */
+    unsigned phase;
+    /**
+     * the innermost TimeCounterUnit being measured, only known
+     * when time statistics are collected
+     */
+    unsigned timeCounter;
+    /** time of the last update, see now() */
+    unsigned heartbeat;
+  };
+
+  static void create(unsigned slots);
+  /** Return the progress board, or zero if it was not created */
+  static SliceProgress* instance() { return s_instance; }
+
+  unsigned slots() const { return _slots; }
+
+  void clear(unsigned slot);
+  void attach(unsigned slot);
+  /** True if the current process updates one of the records */
+  bool attached() const { return _ownSlot!=NO_SLOT; }
+
+  void update(unsigned activations, unsigned active, unsigned passive, size_t memory, unsigned lastWeight);
+  /** Record the TimeCounterUnit being measured, if attached to a record */
+  void setTimeCounter(unsigned tcu)
+  {
+    if (_ownSlot!=NO_SLOT) {
+      __atomic_store_n(&_records[_ownSlot].timeCounter, tcu, __ATOMIC_RELAXED);
+    }
+  }
+  void touch(unsigned slot);
+  bool read(pid_t pid, Record& res) const;
+
+  static unsigned now();
+  static void output(ostream& out, const Record& rec);
+
+private:
+  SliceProgress(unsigned slots);
+
+  static const unsigned NO_SLOT = static_cast<unsigned>(-1);
+
+  static SliceProgress* s_instance;
+
+  Sys::SharedMemory _memory;
+  Record* _records;
+  unsigned _slots;
+  /** the record of the current process, or NO_SLOT */
+  unsigned _ownSlot;
+};
+
+}
+
+#endif // __SliceProgress__
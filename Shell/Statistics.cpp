@@ -124,6 +124,8 @@ Statistics::Statistics()
     finalPassiveClauses(0),
     finalActiveClauses(0),
     finalExtensionalityClauses(0),
+    sharedClausesPublished(0),
+    sharedClausesImported(0),
     splitClauses(0),
     splitComponents(0),
     uniqueComponents(0),
@@ -252,7 +254,8 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck+
+      sharedClausesPublished+sharedClausesImported);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Active clauses", activeClauses);
@@ -265,6 +268,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Shared clauses published", sharedClausesPublished);
+  COND_OUT("Shared clauses imported", sharedClausesImported);
   SEPARATOR;
 
 
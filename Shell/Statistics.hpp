@@ -213,6 +213,10 @@ public:
   unsigned finalActiveClauses;
   /** extensionality clauses at the end of the saturation algorithm run */
   unsigned finalExtensionalityClauses;
+  /** clauses made available to the other strategies of a portfolio */
+  unsigned sharedClausesPublished;
+  /** clauses received from the other strategies of a portfolio */
+  unsigned sharedClausesImported;
 
   unsigned splitClauses;
   unsigned splitComponents;
@@ -411,7 +415,6 @@ public:
 
   ExecutionPhase phase;
 
-private:
   static const char* phaseToString(ExecutionPhase p);
 }; // class Statistics
 
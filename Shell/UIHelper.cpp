@@ -53,6 +53,7 @@
 #include "Options.hpp"
 #include "SimplifyProver.hpp"
 #include "Statistics.hpp"
+#include "BufferedPrinter.hpp"
 #include "TPTPPrinter.hpp"
 #include "UIHelper.hpp"
 // #include "SMTPrinter.hpp"
@@ -183,9 +184,12 @@ void UIHelper::outputSaturatedSet(ostream& out, UnitIterator uit)
   addCommentSignForSZS(out);
   out << "# SZS output start Saturation." << endl;
 
-  while (uit.hasNext()) {
-    Unit* cl = uit.next();
-    out << TPTPPrinter::toString(cl) << endl;
+  {
+    BufferedPrinter printer(out);
+    while (uit.hasNext()) {
+      printer.printTPTPUnit(uit.next());
+      printer << '\n';
+    }
   }
 
   addCommentSignForSZS(out);
@@ -303,6 +307,59 @@ Problem* UIHelper::getInputProblem(const Options& opts)
   return res;
 }
 
+/**
+ * Parse an incremental smtlib2 benchmark and push to @b res one problem
+ * object per its "check-sat" entry (in the order of appearance),
+ * each consisting of the formulas asserted at that point.
+ *
+ * The problems share their units, so at most one of them may be preprocessed
+ * in the current process. (The intended use is to solve each in a forked child.)
+ */
+void UIHelper::getIncrementalInputProblems(const Options& opts, Stack<Problem*>& res)
+{
+  CALL("UIHelper::getIncrementalInputProblems");
+  ASS_EQ(opts.inputSyntax(),Options::InputSyntax::SMTLIB2);
+  ASS_EQ(opts.mode(),Options::Mode::SMTLIB_INCREMENTAL);
+
+  TimeCounter tc1(TC_PARSING);
+  env.statistics->phase = Statistics::PARSING;
+
+  vstring inputFile = opts.inputFile();
+
+  istream* input;
+  if (inputFile=="") {
+    input=&cin;
+  } else {
+    BYPASSING_ALLOCATOR;
+
+    input=new ifstream(inputFile.c_str());
+    if (input->fail()) {
+      USER_ERROR("Cannot open problem file: "+inputFile);
+    }
+  }
+
+  Parse::SMTLIB2 parser(opts);
+  parser.parse(*input);
+  Unit::onParsingEnd();
+  s_haveConjecture=false;
+
+  if (inputFile!="") {
+    BYPASSING_ALLOCATOR;
+
+    delete static_cast<ifstream*>(input);
+    input=0;
+  }
+
+  Stack<UnitList*>::BottomFirstIterator qit(parser.getCheckSatQueries());
+  while (qit.hasNext()) {
+    Problem* prb = new Problem(qit.next());
+    prb->setSMTLIBLogic(parser.getLogic());
+    res.push(prb);
+  }
+
+  env.statistics->phase=Statistics::UNKNOWN_PHASE;
+}
+
 /*
 static void printInterpolationProofTask(ostream& out, Formula* intp, Color avoid_color, bool negate)
 {
@@ -43,6 +43,7 @@ bool outputAllowed(bool debug=false);
 class UIHelper {
 public:
   static Problem* getInputProblem(const Options& opts);
+  static void getIncrementalInputProblems(const Options& opts, Stack<Problem*>& res);
   static void outputResult(ostream& out);
 
   /**
@@ -0,0 +1,146 @@
+
+/*
+ * File tClauseVariantIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file tClauseVariantIndex.cpp
+ * Tests that the hashing clause variant index agrees with the one
+ * based on substitution trees.
+ */
+
+#include "Lib/DHSet.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/Unit.hpp"
+
+#include "Indexing/ClauseVariantIndex.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseVariantIndex
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+void collectVariants(ClauseIterator it, DHSet<Clause*>& res)
+{
+  CALL("collectVariants");
+
+  res.reset();
+  while(it.hasNext()) {
+    res.insert(it.next());
+  }
+}
+
+/**
+ * Insert the clauses of @c spec into both indexes, check that they return
+ * the same variants for each of them and return the number of variants
+ * of the first clause.
+ */
+unsigned checkAgreement(const char* spec)
+{
+  CALL("checkAgreement");
+
+  vistringstream inp(spec);
+  UnitList* units = Parse::TPTP::parse(inp);
+
+  HashingClauseVariantIndex hashing;
+  SubstitutionTreeClauseVariantIndex stree;
+  UnitList::Iterator uit(units);
+  while(uit.hasNext()) {
+    Clause* cl = static_cast<Clause*>(uit.next());
+    hashing.insert(cl);
+    stree.insert(cl);
+  }
+
+  unsigned firstCnt = 0;
+  DHSet<Clause*> hashingRes;
+  DHSet<Clause*> streeRes;
+  UnitList::Iterator qit(units);
+  while(qit.hasNext()) {
+    Clause* cl = static_cast<Clause*>(qit.next());
+    collectVariants(hashing.retrieveVariants(cl->literals(), cl->length()), hashingRes);
+    collectVariants(stree.retrieveVariants(cl->literals(), cl->length()), streeRes);
+    ASS_EQ(hashingRes.size(), streeRes.size());
+    DHSet<Clause*>::Iterator rit(streeRes);
+    while(rit.hasNext()) {
+      ASS(hashingRes.contains(rit.next()));
+    }
+    ASS(hashingRes.contains(cl));
+    if(!firstCnt) {
+      firstCnt = hashingRes.size();
+    }
+  }
+  return firstCnt;
+}
+
+TEST_FUN(variantsStrictOrder)
+{
+  //the variables are numbered by their first occurrence
+  unsigned cnt = checkAgreement(
+      "cnf(c1,axiom, p(X,Y) | q(Y))."
+      "cnf(c2,axiom, p(A,B) | q(B))."
+      "cnf(c3,axiom, q(B) | p(A,B))."
+      "cnf(c4,axiom, p(X,Y) | q(X))."
+      "cnf(c5,axiom, p(X,X) | q(X))."
+      "cnf(c6,axiom, p(X,Y) | q(Z))."
+      "cnf(c7,axiom, p(X,Y) | ~q(Y)).");
+  ASS_EQ(cnt, 3);
+}
+
+TEST_FUN(variantsNonStrictOrder)
+{
+  //literals equal up to variables, only the variables are counted
+  unsigned cnt = checkAgreement(
+      "cnf(c1,axiom, p(X,Y) | p(Y,X))."
+      "cnf(c2,axiom, p(B,A) | p(A,B))."
+      "cnf(c3,axiom, p(X,Y) | p(Y,Z))."
+      "cnf(c4,axiom, p(X,Y) | p(X,Y) | r(X))."
+      "cnf(c5,axiom, p(X,Y) | p(Z,W)).");
+  ASS_EQ(cnt, 2);
+}
+
+TEST_FUN(variantsEquality)
+{
+  unsigned cnt = checkAgreement(
+      "cnf(c1,axiom, X = f(Y) | q(Y))."
+      "cnf(c2,axiom, f(B) = A | q(B))."
+      "cnf(c3,axiom, X = f(Y) | q(X))."
+      "cnf(c4,axiom, X = Y | q(X))."
+      "cnf(c5,axiom, Y = X | q(X))."
+      "cnf(c6,axiom, f(X) = f(Y) | q(X))."
+      "cnf(c7,axiom, f(Y) = f(X) | q(X)).");
+  ASS_EQ(cnt, 2);
+}
+
+TEST_FUN(variantsGround)
+{
+  unsigned cnt = checkAgreement(
+      "cnf(c1,axiom, r(a))."
+      "cnf(c2,axiom, r(a))."
+      "cnf(c3,axiom, r(b))."
+      "cnf(c4,axiom, ~r(X) | r(f(X)))."
+      "cnf(c5,axiom, ~r(Y) | r(f(Y))).");
+  ASS_EQ(cnt, 2);
+}
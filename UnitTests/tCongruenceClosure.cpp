@@ -0,0 +1,173 @@
+
+/*
+ * File tCongruenceClosure.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+/**
+ * @file tCongruenceClosure.cpp
+ * Tests of adding literals to SimpleCongruenceClosure incrementally
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "DP/SimpleCongruenceClosure.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID congruenceClosure
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace DP;
+
+namespace {
+
+TermList constant(const char* name)
+{
+  return TermList(Term::createConstant(env.signature->addFunction(name,0)));
+}
+
+Literal* eq(bool polarity, TermList lhs, TermList rhs)
+{
+  return Literal::createEquality(polarity, lhs, rhs, Sorts::SRT_DEFAULT);
+}
+
+/**
+ * Check that @c incremental, which has been given the literals of
+ * @c batches up to @c upTo one batch at a time, agrees with a closure
+ * computed from scratch on the same literals, both on the status and,
+ * if satisfiable, on which of the @c terms are congruent.
+ */
+void checkAgainstScratch(SimpleCongruenceClosure& incremental, DecisionProcedure::Status status,
+    const Stack<LiteralStack>& batches, unsigned upTo, const Stack<TermList>& terms)
+{
+  SimpleCongruenceClosure scratch(0);
+  LiteralStack all;
+  for (unsigned i=0; i<=upTo; i++) {
+    all.loadFromIterator(LiteralStack::BottomFirstIterator(const_cast<LiteralStack&>(batches[i])));
+  }
+  scratch.addLiterals(pvi(LiteralStack::Iterator(all)), false);
+  ASS_EQ(scratch.getStatus(false), status);
+  if (status==DecisionProcedure::UNSATISFIABLE) {
+    return;
+  }
+  for (unsigned i=0; i<terms.size(); i++) {
+    for (unsigned j=i+1; j<terms.size(); j++) {
+      bool incrementalSame = incremental.getClassID(terms[i])==incremental.getClassID(terms[j]);
+      bool scratchSame = scratch.getClassID(terms[i])==scratch.getClassID(terms[j]);
+      ASS_EQ(incrementalSame, scratchSame);
+    }
+  }
+}
+
+/**
+ * Feed the batches one by one into @c cc, comparing with a closure
+ * built from scratch after each. Return the status after the last one.
+ */
+DecisionProcedure::Status runBatches(SimpleCongruenceClosure& cc,
+    const Stack<LiteralStack>& batches, const Stack<TermList>& terms)
+{
+  DecisionProcedure::Status status = DecisionProcedure::SATISFIABLE;
+  for (unsigned i=0; i<batches.size(); i++) {
+    cc.addLiterals(pvi(LiteralStack::Iterator(const_cast<LiteralStack&>(batches[i]))), false);
+    status = cc.getStatus(false);
+    checkAgainstScratch(cc, status, batches, i, terms);
+    if (status==DecisionProcedure::UNSATISFIABLE) {
+      break;
+    }
+  }
+  return status;
+}
+
+}
+
+TEST_FUN(incrementalBatches)
+{
+  TermList a = constant("cc_a");
+  TermList b = constant("cc_b");
+  TermList c = constant("cc_c");
+  TermList d = constant("cc_d");
+  unsigned f = env.signature->addFunction("cc_f",1);
+  unsigned g = env.signature->addFunction("cc_g",2);
+  unsigned p = env.signature->addPredicate("cc_p",1);
+  TermList fa(Term::create1(f, a));
+  TermList fb(Term::create1(f, b));
+  TermList gab(Term::create2(g, a, b));
+  TermList gba(Term::create2(g, b, a));
+  TermList ffa(Term::create1(f, fa));
+  TermList ffb(Term::create1(f, fb));
+
+  Stack<TermList> terms;
+  terms.push(a); terms.push(b); terms.push(c); terms.push(d);
+  terms.push(fa); terms.push(fb); terms.push(gab); terms.push(gba);
+  terms.push(ffa); terms.push(ffb);
+
+  Stack<LiteralStack> batches;
+  // the pairs f(b), g(b,a), f(f(b)) are created before a=b merges them
+  // with the pairs of a, so later batches need the congruence on them
+  batches.push(LiteralStack());
+  batches.top().push(eq(true, fa, c));
+  batches.top().push(eq(true, gab, d));
+  batches.top().push(eq(false, fb, d));
+  batches.top().push(eq(false, gba, ffb));
+  batches.top().push(eq(false, ffa, a));
+  batches.push(LiteralStack());
+  batches.top().push(eq(true, a, b));
+  batches.push(LiteralStack());
+  batches.top().push(eq(true, ffa, c));
+  batches.top().push(Literal::create1(p, true, fb));
+  batches.push(LiteralStack());
+  batches.top().push(eq(true, c, d));
+
+  SimpleCongruenceClosure cc(0);
+  ASS_EQ(runBatches(cc, batches, terms), DecisionProcedure::UNSATISFIABLE);
+
+  // the pairs are known to the closure from the first run, check that
+  // reset forgets the congruence of the previous literals
+  cc.reset();
+  ASS_EQ(runBatches(cc, batches, terms), DecisionProcedure::UNSATISFIABLE);
+}
+
+TEST_FUN(incrementalPredicates)
+{
+  TermList a = constant("cc_a");
+  TermList b = constant("cc_b");
+  TermList c = constant("cc_c");
+  unsigned f = env.signature->addFunction("cc_f",1);
+  unsigned q = env.signature->addPredicate("cc_q",2);
+  TermList fa(Term::create1(f, a));
+  TermList fc(Term::create1(f, c));
+
+  Stack<TermList> terms;
+  terms.push(a); terms.push(b); terms.push(c); terms.push(fa); terms.push(fc);
+
+  Stack<LiteralStack> batches;
+  batches.push(LiteralStack());
+  batches.top().push(Literal::create2(q, true, fa, b));
+  batches.top().push(Literal::create2(q, false, fc, b));
+  batches.push(LiteralStack());
+  batches.top().push(eq(true, a, b));
+  batches.push(LiteralStack());
+  batches.top().push(eq(true, b, c));
+
+  SimpleCongruenceClosure cc(0);
+  ASS_EQ(runBatches(cc, batches, terms), DecisionProcedure::UNSATISFIABLE);
+}
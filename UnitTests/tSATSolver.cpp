@@ -22,11 +22,14 @@
 #include "Lib/Environment.hpp"
 
 #include "SAT/SATClause.hpp"
+#include "SAT/SATClauseArena.hpp"
 #include "SAT/SATLiteral.hpp"
 #include "SAT/SATInference.hpp"
 #include "SAT/SATSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
+#include "SAT/RestartStrategy.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Test/UnitTesting.hpp"
@@ -80,6 +83,20 @@ SATClause* getClause(const char* spec)
   }
   return SATClause::fromStack(lits);
 }
+
+/**
+ * Same as getClause, but put the literals into @c lits
+ */
+void getClauseLiterals(const char* spec, SATLiteralStack& lits)
+{
+  CALL("getClauseLiterals");
+
+  lits.reset();
+  while(*spec) {
+    lits.push(getLit(*spec));
+    spec++;
+  }
+}
 void ensurePrepared(SATSolver& s)
 {
   s.ensureVarCount(27);
@@ -315,3 +332,158 @@ TEST_FUN(testSolvingUnderAssumptions)
     testAssumptions(sZ3);
   }*/
 }
+
+TEST_FUN(testLingelingClauseLiterals)
+{
+  LingelingInterfacing s(*env.options);
+  ensurePrepared(s);
+
+  SATLiteralStack lits;
+  getClauseLiterals("ab", lits);
+  s.addClauseLiterals(lits);
+  getClauseLiterals("aB", lits);
+  s.addClauseLiterals(lits);
+  getClauseLiterals("Ab", lits);
+  s.addClauseLiterals(lits);
+  ASS_EQ(s.solve(),SATSolver::SATISFIABLE);
+  ASS(s.falseInAssignment(getLit('A')));
+  ASS(s.falseInAssignment(getLit('B')));
+
+  //mixing with clauses given as SATClause objects
+  s.addClause(getClause("AC"));
+  ASS_EQ(s.solve(),SATSolver::SATISFIABLE);
+  ASS(s.trueInAssignment(getLit('C')));
+
+  getClauseLiterals("AB", lits);
+  s.addClauseLiterals(lits);
+  ASS_EQ(s.solve(),SATSolver::UNSATISFIABLE);
+}
+
+TEST_FUN(testComputeLbd)
+{
+  TWLSolver s(*env.options);
+  ensurePrepared(s);
+  s.addClause(getClause("ab"));
+  s.addAssumption(getLit('A'));
+
+  //the assumption and what it propagates are on the first level
+  ASS_EQ(s.computeLbd(getClause("cd")),0);
+  ASS_EQ(s.computeLbd(getClause("ac")),1);
+  ASS_EQ(s.computeLbd(getClause("aAbc")),1);
+
+  //without further clauses, each of the variables c..z is decided on its own level
+  ASS_EQ(s.solve(),SATSolver::SATISFIABLE);
+  ASS_EQ(s.computeLbd(getClause("ab")),1);
+  ASS_EQ(s.computeLbd(getClause("abc")),2);
+  ASS_EQ(s.computeLbd(getClause("cdCD")),2);
+  ASS_EQ(s.computeLbd(getClause("abcdefghijklmnopqrstuvwxyz")),25);
+}
+
+TEST_FUN(testGlucoseRestarts)
+{
+  GlucoseRestartStrategy rs(5, 1.25f);
+  rs.reset();
+  rs.getNextConflictCount();
+
+  //no restarts while the learnt clauses are as good as the average
+  for(unsigned i=0;i<100;i++) {
+    ASS(!rs.onConflict(2));
+  }
+  //worse clauses quickly trigger a restart
+  bool restart = false;
+  for(unsigned i=0;i<10 && !restart;i++) {
+    restart = rs.onConflict(20);
+  }
+  ASS(restart);
+
+  //but only after the minimal number of conflicts since the last one
+  rs.getNextConflictCount();
+  for(unsigned i=0;i<4;i++) {
+    ASS(!rs.onConflict(20));
+  }
+  ASS(rs.onConflict(20));
+}
+
+/**
+ * Add clauses saying that @c holes+1 pigeons sit in @c holes holes,
+ * at most one in each
+ */
+void addPigeonhole(SATSolver& s, unsigned holes)
+{
+  CALL("addPigeonhole");
+
+  unsigned pigeons = holes+1;
+  s.ensureVarCount(pigeons*holes+1);
+  SATLiteralStack lits;
+  for(unsigned p=0;p<pigeons;p++) {
+    lits.reset();
+    for(unsigned h=0;h<holes;h++) {
+      lits.push(SATLiteral(p*holes+h+1, true));
+    }
+    s.addClause(SATClause::fromStack(lits));
+  }
+  for(unsigned h=0;h<holes;h++) {
+    for(unsigned p=0;p<pigeons;p++) {
+      for(unsigned q=p+1;q<pigeons;q++) {
+        lits.reset();
+        lits.push(SATLiteral(p*holes+h+1, false));
+        lits.push(SATLiteral(q*holes+h+1, false));
+        s.addClause(SATClause::fromStack(lits));
+      }
+    }
+  }
+}
+
+TEST_FUN(testLbdClauseDisposer)
+{
+  //enough conflicts for several rounds of clause disposal and restarts
+  env.options->set("sat_clause_disposer","lbd");
+  env.options->set("sat_restart_strategy","glucose");
+  TWLSolver s(*env.options,true);
+  env.options->set("sat_clause_disposer","minisat");
+  env.options->set("sat_restart_strategy","luby");
+
+  addPigeonhole(s, 6);
+  ASS_EQ(s.solve(),SATSolver::UNSATISFIABLE);
+  ASS(s.getRefutation());
+}
+
+TEST_FUN(testArenaReusesSpaceAroundPremises)
+{
+  SATClauseArena arena(1024);
+  SATClauseStack live;
+  DHMap<SATClause*,SATClause*> relocated;
+  SATClauseStack derived;
+
+  //every chunk gets some proof premises, which cannot be moved
+  SATLiteralStack lits;
+  getClauseLiterals("abc", lits);
+  for(unsigned i=0;i<200;i++) {
+    SATClause* cl = arena.allocate(3);
+    for(unsigned j=0;j<3;j++) {
+      (*cl)[j] = lits[j];
+    }
+    if(i%10==0) {
+      SATClause* conclusion = getClause("ab");
+      conclusion->setInference(new PropInference(cl));
+      derived.push(conclusion);
+    }
+    else {
+      cl->destroy();
+    }
+  }
+  arena.compact(live, relocated);
+  ASS(relocated.isEmpty());
+  size_t size = arena.size();
+  ASS_G(size, 0);
+
+  //the space of the dead clauses next to the premises is reused
+  for(unsigned i=0;i<150;i++) {
+    live.push(arena.allocate(3));
+  }
+  ASS_EQ(arena.size(), size);
+
+  //clauses of other lengths need fresh space
+  arena.allocate(5);
+  ASS_G(arena.size(), size);
+}
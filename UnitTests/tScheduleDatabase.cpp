@@ -0,0 +1,148 @@
+
+/*
+ * File tScheduleDatabase.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file tScheduleDatabase.cpp
+ * Tests of reading schedules from a schedule file
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Unit.hpp"
+
+#include "Shell/Property.hpp"
+
+#include "Parse/TPTP.hpp"
+
+#include "CASC/ScheduleDatabase.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID scheduleDatabase
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+using namespace CASC;
+
+Property* getProperty()
+{
+  CALL("getProperty");
+
+  vistringstream inp("cnf(a,axiom,p(X)). cnf(b,negated_conjecture,~p(a)).");
+  UnitList* units = Parse::TPTP::parse(inp);
+  return Property::scan(units);
+}
+
+TEST_FUN(scheduleDatabaseFirstMatch)
+{
+  Property* prop = getProperty();
+  vstring cat = Property::categoryToString(prop->category());
+  vstring other = prop->category()==Property::UEQ ? "NEQ" : "UEQ";
+
+  vistringstream file(
+      "# rules are tried in the order of the file\n"
+      "schedule test\n"
+      "quick category="+other+"\n"
+      "strat_other_category\n"
+      "quick props&0\n"
+      "strat_no_bits\n"
+      "quick atoms>=100\n"
+      "strat_big\n"
+      "quick category="+other+","+cat+" atoms<100 clauses=2 props!=12345\n"
+      "strat_small_a\n"
+      "\tstrat_small_b  # comment\n"
+      "quick\n"
+      "strat_default\n"
+      "fallback formulas>0\n"
+      "strat_formulas\n"
+      "fallback\n"
+      "strat_fallback\n");
+  ScheduleDatabase db;
+  db.load(file, "test");
+
+  Schedule quick;
+  Schedule fallback;
+  ASS(db.getSchedule("test", *prop, quick, fallback));
+  ASS_EQ(quick.size(), 2);
+  ASS_EQ(quick[0], "strat_small_a");
+  ASS_EQ(quick[1], "strat_small_b");
+  ASS_EQ(fallback.size(), 1);
+  ASS_EQ(fallback[0], "strat_fallback");
+
+  Schedule none;
+  ASS(!db.getSchedule("other", *prop, none, none));
+  ASS(none.isEmpty());
+
+  delete prop;
+}
+
+TEST_FUN(scheduleDatabaseReplace)
+{
+  Property* prop = getProperty();
+
+  vistringstream file(
+      "schedule test\n"
+      "quick\n"
+      "strat_old\n"
+      "schedule test\n"
+      "quick atoms>1000\n"
+      "strat_big\n");
+  ScheduleDatabase db;
+  db.load(file, "test");
+
+  //the later schedule replaces the earlier one and has no rule for the problem
+  Schedule quick;
+  Schedule fallback;
+  ASS(db.getSchedule("test", *prop, quick, fallback));
+  ASS(quick.isEmpty());
+  ASS(fallback.isEmpty());
+
+  delete prop;
+}
+
+bool loadFails(const char* text)
+{
+  CALL("loadFails");
+
+  vistringstream file(text);
+  ScheduleDatabase db;
+  try {
+    db.load(file, "test");
+  }
+  catch (UserErrorException&) {
+    return true;
+  }
+  return false;
+}
+
+TEST_FUN(scheduleDatabaseErrors)
+{
+  ASS(loadFails("quick\nstrat\n"));
+  ASS(loadFails("schedule test\nstrat\n"));
+  ASS(loadFails("schedule test\nquick atoms~3\n"));
+  ASS(loadFails("schedule test\nquick atoms<x\n"));
+  ASS(loadFails("schedule test\nquick category<NEQ\n"));
+  ASS(loadFails("schedule test\nquick category=XYZ\n"));
+  ASS(loadFails("schedule test\nquick atoms&3\n"));
+  ASS(loadFails("schedule test\nquick category=NEQ category=UEQ\n"));
+  ASS(!loadFails("schedule test\nquick logic=UF,QF_UF props&3\nstrat\n"));
+}
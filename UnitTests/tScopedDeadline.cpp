@@ -0,0 +1,101 @@
+
+/*
+ * File tScopedDeadline.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file tScopedDeadline.cpp
+ * Tests of nesting of the per-task deadlines
+ */
+
+#include <climits>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID scopedDeadline
+UT_CREATE;
+
+using namespace Lib;
+using namespace Shell;
+
+TEST_FUN(deadlineNone)
+{
+  ASS(!ScopedDeadline::passed());
+  ASS_EQ(ScopedDeadline::remainingMilliseconds(), INT_MAX);
+}
+
+TEST_FUN(deadlineOuterEarlier)
+{
+  ScopedDeadline outer(100000);
+  {
+    ScopedDeadline inner(1000000);
+    // the earlier outer deadline applies
+    ASS_LE(ScopedDeadline::remainingMilliseconds(), 100000);
+    ASS(!ScopedDeadline::passed());
+  }
+  ASS_LE(ScopedDeadline::remainingMilliseconds(), 100000);
+  ASS_G(ScopedDeadline::remainingMilliseconds(), 0);
+}
+
+TEST_FUN(deadlineInnerEarlier)
+{
+  ScopedDeadline outer(100000);
+  {
+    ScopedDeadline inner(0);
+    ASS(ScopedDeadline::passed());
+    {
+      // cannot be extended from inside
+      ScopedDeadline innermost(100000);
+      ASS(ScopedDeadline::passed());
+    }
+    ASS(ScopedDeadline::passed());
+  }
+  // the outer deadline applies again
+  ASS(!ScopedDeadline::passed());
+  ASS_G(ScopedDeadline::remainingMilliseconds(), 0);
+}
+
+TEST_FUN(deadlineSafePoint)
+{
+  Statistics::TerminationReason reason = env.statistics->terminationReason;
+
+  // no deadline, the global time limit is far away
+  env.timeSafePoint();
+  ASS(!env.timeLimitReached());
+
+  bool thrown = false;
+  {
+    ScopedDeadline deadline(0);
+    ASS(env.timeLimitReached());
+    try {
+      env.timeSafePoint();
+    }
+    catch(TimeLimitExceededException&) {
+      thrown = true;
+    }
+  }
+  ASS(thrown);
+  ASS_EQ(env.statistics->terminationReason, Statistics::TIME_LIMIT);
+  ASS(!env.timeLimitReached());
+
+  env.statistics->terminationReason = reason;
+}
@@ -0,0 +1,103 @@
+
+/*
+ * File tSignatureRollback.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file tSignatureRollback.cpp
+ * Tests of returning the signature to a checkpoint
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Theory.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID signatureRollback
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+
+TEST_FUN(rollbackRemovesSymbols)
+{
+  unsigned f = env.signature->addFunction("rb_f",1);
+  TermList a(Term::createConstant(env.signature->addFunction("rb_a",0)));
+  Term* fa = Term::create1(f, a);
+
+  Signature::Checkpoint cp;
+  env.signature->checkpoint(cp);
+  unsigned sorts = env.sorts->count();
+  bool hasSort = env.sorts->hasSort();
+
+  unsigned sk = env.signature->addSkolemFunction(1);
+  vstring skName = env.signature->functionName(sk);
+  unsigned name = env.signature->addNamePredicate(1);
+  unsigned sort = env.sorts->addSort("rb_s", false);
+  env.signature->getFunction(f)->markSkip();
+  Term* ska = Term::create1(sk, a);
+  Literal::create1(name, true, TermList(ska));
+
+  env.sharing->removeSymbolsFrom(cp.functions(), cp.predicates());
+  env.signature->rollback(cp);
+  env.sorts->rollback(sorts, hasSort);
+
+  ASS_EQ(env.signature->functions(), cp.functions());
+  ASS_EQ(env.signature->predicates(), cp.predicates());
+  ASS(!env.signature->functionExists(skName, 1));
+  ASS(!env.signature->getFunction(f)->skip());
+  ASS_EQ(env.sorts->count(), sorts);
+
+  // the terms over the older symbols are still shared
+  ASS_EQ(Term::create1(f, a), fa);
+
+  // the numbers and names are given out again
+  unsigned sk2 = env.signature->addFreshFunction(2, "sK");
+  ASS_EQ(sk2, sk);
+  ASS_EQ(env.signature->functionName(sk2), skName);
+  ASS_NEQ(Term::create2(sk2, a, a), ska);
+  ASS_EQ(env.sorts->addSort("rb_s", false), sort);
+}
+
+TEST_FUN(rollbackRemovesTupleAlgebras)
+{
+  Signature::Checkpoint cp;
+  env.signature->checkpoint(cp);
+  unsigned sorts = env.sorts->count();
+  bool hasSort = env.sorts->hasSort();
+
+  unsigned args[] = {Sorts::SRT_DEFAULT, Sorts::SRT_INTEGER};
+  unsigned tuple = Theory::tuples()->getFunctor(2, args);
+  unsigned tupleSort = env.signature->getFunction(tuple)->fnType()->result();
+  ASS(env.signature->isTermAlgebraSort(tupleSort));
+
+  env.sharing->removeSymbolsFrom(cp.functions(), cp.predicates());
+  env.signature->rollback(cp);
+  env.sorts->rollback(sorts, hasSort);
+
+  ASS(!env.signature->isTermAlgebraSort(tupleSort));
+
+  // the algebra is defined again over the new symbols
+  unsigned tuple2 = Theory::tuples()->getFunctor(2, args);
+  ASS_L(tuple2, env.signature->functions());
+  ASS(env.signature->getFunction(tuple2)->termAlgebraCons());
+}
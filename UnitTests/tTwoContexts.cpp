@@ -0,0 +1,129 @@
+
+/*
+ * File tTwoContexts.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file tTwoContexts.cpp
+ * Unit test checking that two Api contexts can be used from two threads
+ * and keep their problems apart
+ */
+
+#include <thread>
+
+#include "Lib/Environment.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Theory.hpp"
+
+#include "Api/Context.hpp"
+#include "Api/FormulaBuilder.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID two_contexts
+UT_CREATE;
+
+using namespace Lib;
+using namespace Api;
+
+/**
+ * In @b ctx, build the axiom p<suffix>(c<suffix>) named "ax" and set @b ok
+ * if the context knows its own predicate, does not know the one
+ * of the other context and the name of the axiom was not changed
+ */
+void buildInContext(Context* ctx, const char* suffix0, const char* otherSuffix0, bool* ok)
+{
+  Context::Scope scope(*ctx);
+
+  //the strings use the allocator, so they may only be created inside the scope
+  vstring suffix(suffix0);
+  vstring otherSuffix(otherSuffix0);
+
+  for(unsigned i=0; i<100; i++) {
+    FormulaBuilder api;
+    Function c = api.function("c"+suffix, 0);
+    Predicate p = api.predicate("p"+suffix, 1);
+    AnnotatedFormula af = api.annotatedFormula(api.formula(p, api.term(c)), FormulaBuilder::AXIOM, "ax");
+    if(i==0) {
+      *ok = af.name()=="ax";
+    }
+  }
+  *ok = *ok && env.signature->predicateExists("p"+suffix, 1)
+      && !env.signature->predicateExists("p"+otherSuffix, 1);
+}
+
+TEST_FUN(two_contexts_threads)
+{
+  Context ctx1;
+  Context ctx2;
+  bool ok1 = false;
+  bool ok2 = false;
+
+  std::thread t1(buildInContext, &ctx1, "1", "2", &ok1);
+  std::thread t2(buildInContext, &ctx2, "2", "1", &ok2);
+  t1.join();
+  t2.join();
+
+  ASS(ok1);
+  ASS(ok2);
+  //neither context changed the process environment
+  ASS(!env.signature->predicateExists("p1", 1));
+  ASS(!env.signature->predicateExists("p2", 1));
+}
+
+TEST_FUN(two_contexts_foreign_builder)
+{
+  Context ctx1;
+  Context ctx2;
+  bool thrown = false;
+
+  {
+    Context::Scope scope1(ctx1);
+    FormulaBuilder api;
+    {
+      Context::Scope scope2(ctx2);
+      try {
+        api.predicate("q", 0);
+      }
+      catch(ApiException&) {
+        thrown = true;
+      }
+    }
+  }
+  ASS(thrown);
+}
+
+TEST_FUN(two_contexts_theory)
+{
+  Kernel::Theory* outer = Kernel::theory;
+  Context c1;
+  Context c2;
+  Kernel::Theory* t1;
+  {
+    Context::Scope s1(c1);
+    t1 = Kernel::theory;
+    ASS_NEQ(t1, outer);
+    {
+      Context::Scope s2(c2);
+      ASS_NEQ(Kernel::theory, t1);
+      ASS_NEQ(Kernel::theory, outer);
+    }
+    ASS_EQ(Kernel::theory, t1);
+  }
+  ASS_EQ(Kernel::theory, outer);
+}
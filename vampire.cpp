@@ -24,6 +24,13 @@
 #include <ostream>
 #include <fstream>
 #include <csignal>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #if VZ3
 #include "z3++.h"
@@ -31,6 +38,7 @@
 
 #include "Debug/Tracer.hpp"
 
+#include "Lib/DHSet.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
@@ -44,9 +52,11 @@
 #include "Lib/List.hpp"
 #include "Lib/Vector.hpp"
 #include "Lib/System.hpp"
+#include "Lib/StringUtils.hpp"
 #include "Lib/Metaiterators.hpp"
 
 #include "Lib/RCPtr.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
 
 
 #include "Kernel/Clause.hpp"
@@ -79,6 +89,7 @@
 #include "Shell/Preprocess.hpp"
 #include "Shell/Refutation.hpp"
 #include "Shell/TheoryFinder.hpp"
+#include "Shell/BufferedPrinter.hpp"
 #include "Shell/TPTPPrinter.hpp"
 #include "Parse/TPTP.hpp"
 #include "Shell/FOOLElimination.hpp"
@@ -90,7 +101,9 @@
 
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/SATClauseExchange.hpp"
 #include "SAT/Preprocess.hpp"
 
 #include "FMB/ModelCheck.hpp"
@@ -114,6 +127,7 @@ using namespace SAT;
 using namespace Saturation;
 using namespace Inferences;
 using namespace InstGen;
+using namespace Lib::Sys;
 
 Problem* globProblem = 0;
 UnitList* globUnitList=0;
@@ -512,9 +526,12 @@ void outputMode()
   UIHelper::outputSymbolDeclarations(env.out());
   UnitList::Iterator units(prb->units());
 
-  while (units.hasNext()) {
-    Unit* u = units.next();
-    env.out() << TPTPPrinter::toString(u) << "\n";
+  {
+    BufferedPrinter printer(env.out());
+    while (units.hasNext()) {
+      printer.printTPTPUnit(units.next());
+      printer << '\n';
+    }
   }
   env.endOutput();
 
@@ -540,23 +557,175 @@ static SATClauseIterator preprocessClauses(SATClauseList* clauses) {
 }
 
 
-void satSolverMode()
+static SATSolver* createSatSolver()
 {
-  CALL("satSolverMode()");
-  TimeCounter tc(TC_SAT_SOLVER);
-  SATSolverSCP solver;
-  
+  CALL("createSatSolver");
+
   switch(env.options->satSolver()) {
     case Options::SatSolver::VAMPIRE:  
-      solver = new TWLSolver(*env.options);
-      break;
+      return new TWLSolver(*env.options);
     case Options::SatSolver::MINISAT:
-      solver = new MinisatInterfacingNewSimp(*env.options);
-      break;      
+      return new MinisatInterfacingNewSimp(*env.options);
+    case Options::SatSolver::LINGELING:
+      return new LingelingInterfacing(*env.options);
     default:
       ASSERTION_VIOLATION(env.options->satSolver());
   }
-    
+}
+
+/**
+ * Configurations of the workers of the parallel SAT mode, except for the first
+ * worker which runs with the options given by the user. Each row gives the solver
+ * and, for the native one, the restart strategy, variable selector and clause disposer.
+ */
+static const char* const SAT_PORTFOLIO[][4] = {
+  {"vampire",   "glucose",   "active",          "lbd"},
+  {"minisat",   0,           0,                 0},
+  {"vampire",   "luby",      "recently_learnt", "minisat"},
+  {"lingeling", 0,           0,                 0},
+  {"vampire",   "geometric", "active",          "growing"},
+  {"vampire",   "minisat",   "niceness",        "lbd"},
+};
+
+/** Exit codes of the SAT workers, as used by the SAT competition */
+static const int SAT_WORKER_SATISFIABLE = 10;
+static const int SAT_WORKER_UNSATISFIABLE = 20;
+
+/**
+ * Solve @c clauses in the @c worker-th forked worker of the parallel SAT mode and exit
+ * with SAT_WORKER_SATISFIABLE, SAT_WORKER_UNSATISFIABLE, or 0 if the result is unknown.
+ *
+ * The native solvers share their short learnt clauses through @c exchange.
+ */
+static void runSatWorker(unsigned worker, unsigned varCnt, SATClauseStack& clauses, SATClauseExchange& exchange)
+{
+  CALL("runSatWorker");
+
+  System::registerForSIGHUPOnParentDeath();
+
+  int resultCode = 0;
+  try {
+    int seed = env.options->randomSeed()+worker;
+    if(worker>0) {
+      const char* const* config = SAT_PORTFOLIO[(worker-1)%(sizeof(SAT_PORTFOLIO)/sizeof(SAT_PORTFOLIO[0]))];
+      env.options->set("sat_solver", config[0]);
+      if(config[1]) {
+        env.options->set("sat_restart_strategy", config[1]);
+        env.options->set("sat_var_selector", config[2]);
+        env.options->set("sat_clause_disposer", config[3]);
+      }
+      // the seed also goes to the lingeling backend through the options
+      env.options->set("random_seed", Int::toString(seed));
+      Random::setSeed(seed);
+    }
+
+    SATSolverSCP solver(createSatSolver());
+    if(env.options->satSolver()==Options::SatSolver::VAMPIRE) {
+      exchange.setWorker(worker);
+      static_cast<TWLSolver*>(solver.ptr())->setClauseExchange(&exchange);
+    }
+    else if(worker>0 && env.options->satSolver()==Options::SatSolver::MINISAT) {
+      static_cast<MinisatInterfacingNewSimp*>(solver.ptr())->setRandomSeed(seed);
+    }
+    solver->ensureVarCount(varCnt);
+    solver->addClausesIter(pvi( SATClauseStack::Iterator(clauses) ));
+    if(worker>0) {
+      // make the workers start from different assignments
+      solver->randomizeForNextAssignment(varCnt);
+    }
+
+    switch(solver->solve()) {
+    case SATSolver::SATISFIABLE:
+      resultCode = SAT_WORKER_SATISFIABLE;
+      break;
+    case SATSolver::UNSATISFIABLE:
+      resultCode = SAT_WORKER_UNSATISFIABLE;
+      break;
+    default:
+      break;
+    }
+  }
+  catch(TimeLimitExceededException&) {
+    // the other workers are over the limit too, the parent will notice
+  }
+  catch(MemoryLimitExceededException&) {
+    // the other workers can still succeed
+  }
+  System::terminateImmediately(resultCode);
+}
+
+/**
+ * Run differently configured SAT solvers on @c clauses in @c workerCnt forked
+ * workers and return the result of the first one that finishes with an answer.
+ */
+static SATSolver::Status runSatPortfolio(unsigned workerCnt, unsigned varCnt, SATClauseStack& clauses)
+{
+  CALL("runSatPortfolio");
+
+  Multiprocessing* mp = Multiprocessing::instance();
+  // must exist before the workers are forked, so that they share its memory
+  SATClauseExchange exchange;
+  DHSet<pid_t> workers;
+
+  for(unsigned i=0; i<workerCnt; i++) {
+    pid_t pid = mp->fork();
+    if(!pid) {
+      runSatWorker(i, varCnt, clauses, exchange);
+      ASSERTION_VIOLATION; // runSatWorker does not return
+    }
+    workers.insert(pid);
+  }
+
+  SATSolver::Status res = SATSolver::UNKNOWN;
+  while(!workers.isEmpty()) {
+    int resValue;
+    pid_t finished;
+    if(env.options->timeLimitInDeciseconds()==0) {
+      finished = mp->waitForChildTermination(resValue);
+    }
+    else {
+      int remaining = env.remainingTime();
+      if(remaining<=0) {
+        break;
+      }
+      finished = mp->waitForChildTerminationOrTime(remaining, resValue);
+      if(!finished) {
+        break;
+      }
+    }
+    if(!workers.remove(finished)) {
+      continue;
+    }
+    if(resValue==SAT_WORKER_SATISFIABLE) {
+      res = SATSolver::SATISFIABLE;
+      break;
+    }
+    if(resValue==SAT_WORKER_UNSATISFIABLE) {
+      res = SATSolver::UNSATISFIABLE;
+      break;
+    }
+  }
+
+  DHSet<pid_t>::Iterator wit(workers);
+  while(wit.hasNext()) {
+    pid_t pid = wit.next();
+    int resValue;
+    mp->killNoCheck(pid, SIGKILL);
+    mp->waitForParticularChildTermination(pid, resValue);
+  }
+  return res;
+}
+
+void satSolverMode()
+{
+  CALL("satSolverMode()");
+  TimeCounter tc(TC_SAT_SOLVER);
+
+  unsigned workerCnt = env.options->multicore();
+  if(workerCnt==0) {
+    workerCnt = std::max(1u, System::getNumberOfCores());
+  }
+
   //get the clauses; 
   SATClauseList* clauses;
   unsigned varCnt=0;
@@ -564,11 +733,19 @@ void satSolverMode()
   SATSolver::Status res; 
   
   clauses = getInputClauses(env.options->inputFile().c_str(), varCnt);
-  
-  solver->ensureVarCount(varCnt);
-  solver->addClausesIter(preprocessClauses(clauses));
 
-  res = solver->solve();
+  if(workerCnt>1) {
+    SATClauseStack clauseStack;
+    clauseStack.loadFromIterator(preprocessClauses(clauses));
+    res = runSatPortfolio(workerCnt, varCnt, clauseStack);
+  }
+  else {
+    SATSolverSCP solver(createSatSolver());
+    solver->ensureVarCount(varCnt);
+    solver->addClausesIter(preprocessClauses(clauses));
+
+    res = solver->solve();
+  }
 
   env.statistics->phase = Statistics::FINALIZATION;
 
@@ -615,6 +792,171 @@ void vampireMode()
   }
 } // vampireMode
 
+/** Exit status of an smtlib_incremental query child that found the query unsatisfiable */
+static const int SMTLIB_INCREMENTAL_UNSAT = 0;
+/** Exit status of an smtlib_incremental query child that found the query satisfiable */
+static const int SMTLIB_INCREMENTAL_SAT = 2;
+
+/**
+ * Solve a single query of an incremental smtlib2 benchmark and terminate
+ * with SMTLIB_INCREMENTAL_UNSAT or SMTLIB_INCREMENTAL_SAT if it was answered
+ * and with 1 otherwise.
+ */
+static void smtlibIncrementalQuery(Problem& prb) NO_RETURN;
+static void smtlibIncrementalQuery(Problem& prb)
+{
+  CALL("smtlibIncrementalQuery()");
+
+  System::registerForSIGHUPOnParentDeath();
+
+  // the time limit is for each query separately
+  env.timer->reset();
+  env.timer->start();
+  TimeCounter::reinitialize();
+  Timer::setTimeLimitEnforcement(true);
+
+  {
+    TimeCounter tc(TC_PREPROCESSING);
+
+    Shell::Preprocess prepro(*env.options);
+    prepro.preprocess(prb);
+  }
+
+  ProvingHelper::runVampireSaturation(prb, *env.options);
+
+  int resultValue = 1;
+  if (env.statistics->terminationReason == Statistics::REFUTATION) {
+    resultValue = SMTLIB_INCREMENTAL_UNSAT;
+  } else if (env.statistics->terminationReason == Statistics::SATISFIABLE) {
+    resultValue = SMTLIB_INCREMENTAL_SAT;
+  }
+
+  env.beginOutput();
+  UIHelper::outputResult(env.out());
+  env.endOutput();
+
+  STOP_CHECKING_FOR_ALLOCATOR_BYPASSES;
+
+  exit(resultValue);
+}
+
+/**
+ * True if the assertions of the query @b sub are among those of the query @b super.
+ *
+ * The parser pushes new assertions on the front of the list of the current
+ * assertion level and pop returns to the list saved by the matching push,
+ * so the queries share the assertions they have in common and @b sub
+ * is included in @b super iff it is a tail of it.
+ */
+static bool smtlibIncrementalIncluded(UnitList* sub, UnitList* super)
+{
+  CALL("smtlibIncrementalIncluded");
+
+  for (UnitList* l = super; l; l = l->tail()) {
+    if (l == sub) {
+      return true;
+    }
+  }
+  return sub == 0;
+}
+
+/**
+ * Print the answer to a query that follows from the answer
+ * to the earlier check-sat number @b from (counting from 1)
+ */
+static void smtlibIncrementalOutputImplied(bool unsat, unsigned from)
+{
+  CALL("smtlibIncrementalOutputImplied");
+
+  env.beginOutput();
+  if (env.options->outputMode() == Options::Output::SMTCOMP) {
+    env.out() << (unsat ? "unsat" : "sat") << endl;
+  } else {
+    env.out() << "% " << (unsat ? "Unsatisfiable" : "Satisfiable")
+              << ", implied by the answer to check-sat " << from << endl;
+  }
+  env.endOutput();
+}
+
+/**
+ * Answer the check-sat entries of an incremental smtlib2 benchmark.
+ *
+ * The benchmark (with all its push/pop levels) is parsed just once and each
+ * query is then preprocessed and solved in a child forked from the parsed state,
+ * so that the startup and parsing costs are shared by all the queries,
+ * while the preprocessing of one cannot influence the others.
+ * The answers are printed in the order of the check-sat entries.
+ *
+ * The answers are kept across check-sat: a query with all the assertions
+ * of an unsatisfiable one (e.g. after further asserts or a push) is
+ * unsatisfiable and a query with only assertions of a satisfiable one
+ * (e.g. after a pop) is satisfiable, so neither is solved again.
+ * The clauses derived by saturation are not kept, a query that is not
+ * implied in this way is saturated from scratch.
+ */
+void smtlibIncrementalMode()
+{
+  CALL("smtlibIncrementalMode()");
+
+  Stack<Problem*> queries;
+  UIHelper::getIncrementalInputProblems(*env.options, queries);
+
+  // now all the cpu usage will be in children, we'll just be waiting for them
+  env.timer->makeChildrenIncluded();
+  Timer::setTimeLimitEnforcement(false);
+
+  // the assertions of the answered queries, the unsatisfiable and the satisfiable ones,
+  // with the number of the check-sat that answered them
+  Stack<pair<UnitList*,unsigned> > unsatQueries;
+  Stack<pair<UnitList*,unsigned> > satQueries;
+
+  bool allAnswered = true;
+  unsigned queryNumber = 0;
+  Stack<Problem*>::BottomFirstIterator qit(queries);
+  while (qit.hasNext()) {
+    Problem* prb = qit.next();
+    queryNumber++;
+    // the children take the units apart, the parent only compares the lists
+    UnitList* assertions = prb->units();
+
+    bool implied = false;
+    for (unsigned i = 0; !implied && i < unsatQueries.size(); i++) {
+      if (smtlibIncrementalIncluded(unsatQueries[i].first, assertions)) {
+        smtlibIncrementalOutputImplied(true, unsatQueries[i].second);
+        implied = true;
+      }
+    }
+    for (unsigned i = 0; !implied && i < satQueries.size(); i++) {
+      if (smtlibIncrementalIncluded(assertions, satQueries[i].first)) {
+        smtlibIncrementalOutputImplied(false, satQueries[i].second);
+        implied = true;
+      }
+    }
+    if (implied) {
+      continue;
+    }
+
+    pid_t child = Multiprocessing::instance()->fork();
+    if (!child) {
+      smtlibIncrementalQuery(*prb);
+    }
+
+    int resValue;
+    Multiprocessing::instance()->waitForParticularChildTermination(child, resValue);
+    if (resValue == SMTLIB_INCREMENTAL_UNSAT) {
+      unsatQueries.push(make_pair(assertions, queryNumber));
+    } else if (resValue == SMTLIB_INCREMENTAL_SAT) {
+      satQueries.push(make_pair(assertions, queryNumber));
+    } else {
+      allAnswered = false;
+    }
+  }
+
+  if (allAnswered) {
+    vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+  }
+} // smtlibIncrementalMode
+
 void spiderMode()
 {
   CALL("spiderMode()");
@@ -706,6 +1048,7 @@ void clausifyMode(bool theory)
   UIHelper::outputSymbolDeclarations(env.out());
 
   ClauseIterator cit = prb->clauseIterator();
+  BufferedPrinter printer(env.out());
   while (cit.hasNext()) {
     Clause* cl = cit.next();
     cl = simplifier.simplify(cl);
@@ -715,11 +1058,13 @@ void clausifyMode(bool theory)
     if (theory) {
       Formula* f = Formula::fromClause(cl);
       FormulaUnit* fu = new FormulaUnit(f,cl->inference(),cl->inputType() == Unit::CONJECTURE ? Unit::NEGATED_CONJECTURE : cl->inputType()); // CONJECTURE is evil, as it cannot occur multiple times
-      env.out() << TPTPPrinter::toString(fu) << "\n";
+      printer.printTPTPUnit(fu);
     } else {
-      env.out() << TPTPPrinter::toString(cl) << "\n";
+      printer.printTPTPUnit(cl);
     }
+    printer << '\n';
   }
+  printer.flush();
   env.endOutput();
 
   if (env.options->latexOutput() != "off") { outputClausesToLaTeX(prb.ptr()); }
@@ -813,6 +1158,335 @@ void groundingMode()
   }
 } // groundingMode
 
+void serverMode();
+
+/**
+ * Run the mode of operation selected in @b env.options.
+ */
+void performMode()
+{
+  CALL("performMode()");
+
+  switch (env.options->mode())
+  {
+  case Options::Mode::AXIOM_SELECTION:
+    axiomSelectionMode();
+    break;
+  case Options::Mode::GROUNDING:
+    groundingMode();
+    break;
+/*
+  case Options::Mode::BOUND_PROP:
+#if GNUMP
+   boundPropagationMode();
+#else
+   NOT_IMPLEMENTED;
+#endif
+    break;
+*/
+  case Options::Mode::SPIDER:
+    spiderMode();
+    break;
+  case Options::Mode::RANDOM_STRATEGY:
+    getRandomStrategy();
+    break;
+  case Options::Mode::CONSEQUENCE_ELIMINATION:
+  case Options::Mode::VAMPIRE:
+    vampireMode();
+    break;
+
+  case Options::Mode::CASC:
+    env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
+    env.options->setSchedule(Options::Schedule::CASC);
+    env.options->setOutputMode(Options::Output::SZS);
+    env.options->setProof(Options::Proof::TPTP);
+    env.options->setOutputAxiomNames(true);
+    env.options->setTimeLimitInSeconds(300);
+    env.options->setMemoryLimit(128000);
+
+    if (CASC::PortfolioMode::perform(1.05)) {
+      vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+    }
+    break;
+
+  case Options::Mode::CASC_SAT:
+    env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
+    env.options->setSchedule(Options::Schedule::CASC_SAT);
+    env.options->setOutputMode(Options::Output::SZS);
+    env.options->setProof(Options::Proof::TPTP);
+    env.options->setOutputAxiomNames(true);
+    env.options->setTimeLimitInSeconds(300);
+    env.options->setMemoryLimit(128000);
+
+    if (CASC::PortfolioMode::perform(1.05)) {
+      vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+    }
+    break;
+
+  case Options::Mode::SMTCOMP:
+    env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
+    env.options->setInputSyntax(Options::InputSyntax::SMTLIB2);
+    env.options->setOutputMode(Options::Output::SMTCOMP);
+    env.options->setSchedule(Options::Schedule::SMTCOMP);
+    env.options->setProof(Options::Proof::OFF);
+    env.options->setMulticore(0); // use all available cores
+    env.options->setTimeLimitInSeconds(1800);
+    env.options->setMemoryLimit(128000);
+    env.options->setStatistics(Options::Statistics::NONE);
+
+    //TODO needed?
+    // to prevent from terminating by time limit
+    env.options->setTimeLimitInSeconds(100000);
+
+    if(CASC::PortfolioMode::perform(1.3)){
+     vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+    } else {
+     cout << "unknown" << endl;
+    }
+    break;
+
+  case Options::Mode::SERVER:
+    serverMode();
+    break;
+
+  case Options::Mode::SMTLIB_INCREMENTAL:
+    env.options->setInputSyntax(Options::InputSyntax::SMTLIB2);
+    env.options->setOutputMode(Options::Output::SMTCOMP);
+    env.options->setProof(Options::Proof::OFF);
+    env.options->setStatistics(Options::Statistics::NONE);
+
+    smtlibIncrementalMode();
+    break;
+
+  case Options::Mode::PORTFOLIO:
+    env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
+
+    if (CASC::PortfolioMode::perform(1.0)) {
+      vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+    }
+    break;
+
+  case Options::Mode::CASC_LTB: {
+    bool learning = env.options->ltbLearning()!=Options::LTBLearning::OFF;
+    try {
+      if(learning){
+        CASC::CLTBModeLearning::perform();
+      }
+      else{
+        CASC::CLTBMode::perform();
+      }
+    } catch (Lib::SystemFailException& ex) {
+      cerr << "Process " << getpid() << " received SystemFailException" << endl;
+      ex.cry(cerr);
+      cerr << " and will now die" << endl;
+    }
+    //we have processed the ltb batch file, so we can return zero
+    vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+    break;
+  }
+  case Options::Mode::MODEL_CHECK:
+    modelCheckMode();
+    break;
+
+  case Options::Mode::CLAUSIFY:
+    clausifyMode(false);
+    break;
+
+  case Options::Mode::TCLAUSIFY:
+    clausifyMode(true);
+    break;
+
+  case Options::Mode::OUTPUT:
+    outputMode();
+    break;
+
+  case Options::Mode::PROFILE:
+    profileMode();
+    break;
+
+  case Options::Mode::PREPROCESS:
+    preprocessMode(false);
+    break;
+
+  case Options::Mode::TPREPROCESS:
+    preprocessMode(true);
+    break;
+
+  case Options::Mode::SAT:
+    satSolverMode();
+    break;
+
+  default:
+    USER_ERROR("Unsupported mode");
+  }
+} // performMode
+
+/**
+ * Serve proving jobs read from the standard input, one per line,
+ * writing their output to the standard output.
+ *
+ * Each line consists of a problem file name and options in the command line
+ * format, e.g. "Problems/SET/SET001-1.p --time_limit 10 --saturation_algorithm discount",
+ * the options given to the server itself serve as defaults for all the jobs.
+ * Each job runs in a child forked from this (already initialised) process,
+ * so no state is carried over from one job to another. The output of the job is
+ * followed by the line "% END <job number> <exit status>". Serving ends
+ * on end of input or on a line "quit".
+ */
+static void serveJobs()
+{
+  CALL("serveJobs()");
+
+  unsigned jobCnt = 0;
+  vstring line;
+  while (getline(cin, line)) {
+    if (line == "quit") {
+      break;
+    }
+
+    Stack<vstring> parts;
+    StringUtils::splitStr(line.c_str(), ' ', parts);
+    Stack<char*> args;
+    args.push(const_cast<char*>("vampire")); // the program name, skipped by CommandLine
+    Stack<vstring>::BottomFirstIterator pit(parts);
+    while (pit.hasNext()) {
+      const vstring& part = pit.next();
+      if (part.size()) {
+        args.push(const_cast<char*>(part.c_str()));
+      }
+    }
+    if (args.size() == 1) {
+      continue;
+    }
+    jobCnt++;
+
+    cout << flush;
+    pid_t child = Multiprocessing::instance()->fork();
+    if (!child) {
+      System::registerForSIGHUPOnParentDeath();
+
+      // unless the job says otherwise
+      env.options->setMode(Options::Mode::VAMPIRE);
+      env.options->setServerSocket("");
+
+      Shell::CommandLine cl(args.size(), args.begin());
+      cl.interpret(*env.options);
+      if (env.options->mode() == Options::Mode::SERVER) {
+        USER_ERROR("Server jobs cannot run in the server mode");
+      }
+
+      Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
+      Lib::Random::setSeed(env.options->randomSeed());
+
+      env.timer->reset();
+      env.timer->start();
+      TimeCounter::reinitialize();
+      Timer::setTimeLimitEnforcement(true);
+
+      performMode();
+
+      env.beginOutput();
+      env.out() << flush;
+      env.endOutput();
+      exit(vampireReturnValue);
+    }
+
+    int resValue;
+    Multiprocessing::instance()->waitForParticularChildTermination(child, resValue);
+
+    env.beginOutput();
+    env.out() << "% END " << jobCnt << " " << resValue << endl;
+    env.endOutput();
+  }
+} // serveJobs
+
+/**
+ * Create a Unix domain socket listening at @b path and return its descriptor
+ */
+static int listenOnUnixSocket(const vstring& path)
+{
+  CALL("listenOnUnixSocket");
+
+  sockaddr_un addr;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    USER_ERROR("Server socket path is too long: "+path);
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path.c_str());
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) {
+    SYSTEM_FAIL("Cannot create the server socket.", errno);
+  }
+  // a socket left over from an earlier server would make bind fail
+  unlink(path.c_str());
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+    SYSTEM_FAIL("Cannot bind the server socket to "+path+".", errno);
+  }
+  if (listen(fd, SOMAXCONN) == -1) {
+    SYSTEM_FAIL("Cannot listen on the server socket.", errno);
+  }
+  return fd;
+}
+
+/**
+ * Serve proving jobs, see serveJobs() for the protocol.
+ *
+ * Without the server_socket option the jobs come from the standard input
+ * and run one after another. With it, the server accepts connections on
+ * a Unix domain socket and serves each connection in its own child (forked
+ * from this initialised process), which reads the jobs from the connection
+ * and writes their output to it. Jobs of one connection run one after another,
+ * jobs of different connections at the same time. The server runs until killed.
+ */
+void serverMode()
+{
+  CALL("serverMode()");
+
+  // now all the cpu usage will be in children, we'll just be waiting for them
+  env.timer->makeChildrenIncluded();
+  Timer::setTimeLimitEnforcement(false);
+
+  vstring socketPath = env.options->serverSocket();
+  if (socketPath == "") {
+    serveJobs();
+    vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+    return;
+  }
+
+  int listenFd = listenOnUnixSocket(socketPath);
+  for (;;) {
+    int conn = accept(listenFd, 0, 0);
+    if (conn == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SYSTEM_FAIL("Cannot accept a connection on the server socket.", errno);
+    }
+
+    cout << flush;
+    pid_t handler = Multiprocessing::instance()->fork();
+    if (!handler) {
+      System::registerForSIGHUPOnParentDeath();
+      close(listenFd);
+      // the jobs and their children talk to the client through the standard streams
+      if (dup2(conn, 0) == -1 || dup2(conn, 1) == -1) {
+        SYSTEM_FAIL("Cannot redirect the standard streams to the connection.", errno);
+      }
+      close(conn);
+      serveJobs();
+      cout << flush;
+      exit(VAMP_RESULT_STATUS_SUCCESS);
+    }
+    close(conn);
+
+    // reap the handlers of the connections that have been closed
+    int status;
+    while (waitpid(-1, &status, WNOHANG) > 0) {}
+  }
+} // serverMode
+
 /**
  * The main function.
  * @since 03/12/2003 many changes related to logging
@@ -851,145 +1525,7 @@ int main(int argc, char* argv[])
     Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
     Lib::Random::setSeed(env.options->randomSeed());
 
-    switch (env.options->mode())
-    {
-    case Options::Mode::AXIOM_SELECTION:
-      axiomSelectionMode();
-      break;
-    case Options::Mode::GROUNDING:
-      groundingMode();
-      break;
-/*
-    case Options::Mode::BOUND_PROP:
-#if GNUMP
-     boundPropagationMode();
-#else
-     NOT_IMPLEMENTED;
-#endif
-      break;
-*/
-    case Options::Mode::SPIDER:
-      spiderMode();
-      break;
-    case Options::Mode::RANDOM_STRATEGY:
-      getRandomStrategy();
-      break;
-    case Options::Mode::CONSEQUENCE_ELIMINATION:
-    case Options::Mode::VAMPIRE:
-      vampireMode();
-      break;
-
-    case Options::Mode::CASC:
-      env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
-      env.options->setSchedule(Options::Schedule::CASC);
-      env.options->setOutputMode(Options::Output::SZS);
-      env.options->setProof(Options::Proof::TPTP);
-      env.options->setOutputAxiomNames(true);
-      env.options->setTimeLimitInSeconds(300);
-      env.options->setMemoryLimit(128000);
-
-      if (CASC::PortfolioMode::perform(1.05)) {
-        vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
-      }
-      break;
-
-    case Options::Mode::CASC_SAT:
-      env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
-      env.options->setSchedule(Options::Schedule::CASC_SAT);
-      env.options->setOutputMode(Options::Output::SZS);
-      env.options->setProof(Options::Proof::TPTP);
-      env.options->setOutputAxiomNames(true);
-      env.options->setTimeLimitInSeconds(300);
-      env.options->setMemoryLimit(128000);
-
-      if (CASC::PortfolioMode::perform(1.05)) {
-        vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
-      }
-      break;
-
-    case Options::Mode::SMTCOMP:
-      env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
-      env.options->setInputSyntax(Options::InputSyntax::SMTLIB2);
-      env.options->setOutputMode(Options::Output::SMTCOMP);
-      env.options->setSchedule(Options::Schedule::SMTCOMP);
-      env.options->setProof(Options::Proof::OFF);
-      env.options->setMulticore(0); // use all available cores
-      env.options->setTimeLimitInSeconds(1800);
-      env.options->setMemoryLimit(128000);
-      env.options->setStatistics(Options::Statistics::NONE);
-
-      //TODO needed?
-      // to prevent from terminating by time limit
-      env.options->setTimeLimitInSeconds(100000);
-
-      if(CASC::PortfolioMode::perform(1.3)){
-       vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
-      } else {
-       cout << "unknown" << endl;
-      }
-      break;
-
-    case Options::Mode::PORTFOLIO:
-      env.options->setIgnoreMissing(Options::IgnoreMissing::WARN);
-
-      if (CASC::PortfolioMode::perform(1.0)) {
-        vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
-      }
-      break;
-
-    case Options::Mode::CASC_LTB: {
-      bool learning = env.options->ltbLearning()!=Options::LTBLearning::OFF;
-      try {
-        if(learning){
-          CASC::CLTBModeLearning::perform();
-        }
-        else{
-          CASC::CLTBMode::perform();
-        }
-      } catch (Lib::SystemFailException& ex) {
-        cerr << "Process " << getpid() << " received SystemFailException" << endl;
-        ex.cry(cerr);
-        cerr << " and will now die" << endl;
-      }
-      //we have processed the ltb batch file, so we can return zero
-      vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
-      break;
-    }
-    case Options::Mode::MODEL_CHECK:
-      modelCheckMode();
-      break;
-
-    case Options::Mode::CLAUSIFY:
-      clausifyMode(false);
-      break;
-
-    case Options::Mode::TCLAUSIFY:
-      clausifyMode(true);
-      break;
-
-    case Options::Mode::OUTPUT:
-      outputMode();
-      break;
-
-    case Options::Mode::PROFILE:
-      profileMode();
-      break;
-
-    case Options::Mode::PREPROCESS:
-      preprocessMode(false);
-      break;
-
-    case Options::Mode::TPREPROCESS:
-      preprocessMode(true);
-      break;
-
-    case Options::Mode::SAT:
-      satSolverMode();
-      break;
-
-    default:
-      USER_ERROR("Unsupported mode");
-    }
+    performMode();
 #if CHECK_LEAKS
     if (globUnitList) {
       MemoryLeak leak;
@@ -0,0 +1,2 @@
+//Automatically generated file, see Makefile for details
+const char* VERSION_STRING = "Vampire 4.2.2 (commit f3cebcf on 2026-10-18 12:57:57 +0000)";